@@ -0,0 +1,54 @@
+/**
+ * @file Residual.hpp
+ *
+ * Steady-state residual of the blocks: the rates of change of h and hu
+ * that the net updates of a step imply, taken from the net updates while
+ * updateUnknowns() applies them.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+namespace Blocks {
+
+  /**
+   * |dh/dt| and |d(hu)/dt| over the inner cells of one step
+   *
+   * Accumulated cell by cell with add() in the loop that applies the net
+   * updates (StateStorage::update), then turned into rates by finish().
+   */
+  template <class Work>
+  struct Residual {
+    /** Mean over the cells */
+    Work l1H  = Work(0.0);
+    Work l1Hu = Work(0.0);
+    /** Maximum over the cells */
+    Work linfH  = Work(0.0);
+    Work linfHu = Work(0.0);
+
+    /**
+     * Adds a cell that changes at the rate -dH / dx, -dHU / dx, i.e. the
+     * sums Right[i-1] + Left[i] of its net updates, independent of dt
+     */
+    void add(Work dH, Work dHU) {
+      const Work h  = std::abs(dH);
+      const Work hu = std::abs(dHU);
+      l1H += h;
+      l1Hu += hu;
+      linfH  = std::max(linfH, h);
+      linfHu = std::max(linfHu, hu);
+    }
+
+    /** Turns the sums over size cells of width cellSize into rates */
+    void finish(unsigned int size, Work cellSize) {
+      const Work perCell = Work(1.0) / cellSize;
+      l1H *= perCell / Work(size);
+      l1Hu *= perCell / Work(size);
+      linfH *= perCell;
+      linfHu *= perCell;
+    }
+  };
+
+} // namespace Blocks
@@ -0,0 +1,160 @@
+/**
+ * @file SemiImplicitBlock.cpp
+ */
+
+#include "SemiImplicitBlock.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Tools/RealMath.hpp"
+
+template <class Policy>
+Blocks::SemiImplicitBlock<Policy>::SemiImplicitBlock(
+  const RealType* h, const RealType* hu, const RealType* b, unsigned int size, RealType cellSize
+):
+  state_(size + 2),
+  size_(size),
+  cellSize_(Work(cellSize)),
+  leftBoundary_(OutflowBoundary),
+  rightBoundary_(OutflowBoundary),
+  h_(size + 2),
+  hu_(size + 2),
+  b_(size + 2),
+  advection_(size + 1),
+  depth_(size + 1),
+  momentum_(size + 1),
+  huStar_(size + 2),
+  upper_(size + 2),
+  rhs_(size + 2),
+  eta_(size + 2),
+  hNetUpdatesLeft_(size + 1),
+  hNetUpdatesRight_(size + 1),
+  huNetUpdatesLeft_(size + 1),
+  huNetUpdatesRight_(size + 1) {
+
+  // The ghost cells keep the bathymetry of their neighbours for the whole run
+  std::vector<RealType> bWithGhosts(b, b + size + 2);
+  bWithGhosts[0]        = b[1];
+  bWithGhosts[size + 1] = b[size];
+  state_.assign(h, hu, bWithGhosts.data());
+}
+
+template <class Policy>
+typename Policy::Work Blocks::SemiImplicitBlock<Policy>::computeNumericalFluxes() {
+  state_.load(0, size_ + 2, h_.data(), hu_.data(), b_.data());
+
+  // Velocities in huStar_, zero where the depth is too small to divide by
+  for (unsigned int i = 0; i < size_ + 2; i++) {
+    huStar_[i] = h_[i] > Work(Policy::DRY_TOL) ? div_work<Policy>(hu_[i], h_[i]) : Work(0.0);
+  }
+
+  Work maxSpeed = Work(0.0), maxDepth = Work(0.0);
+  for (unsigned int e = 0; e < size_ + 1; e++) {
+    const Work q  = Work(0.5) * (hu_[e] + hu_[e + 1]);
+    advection_[e] = q * (q > Work(0.0) ? huStar_[e] : huStar_[e + 1]);
+    maxSpeed      = std::max(maxSpeed, std::max(std::abs(huStar_[e]), std::abs(huStar_[e + 1])));
+    maxDepth      = std::max(maxDepth, std::max(h_[e], h_[e + 1]));
+  }
+
+  // Advective CFL condition, capped at MAX_GRAVITY_COURANT explicit steps so
+  // that a state at rest (no advection at all) still takes a finite step
+  const Work waveSpeed    = maxSpeed + sqrt_work<Policy>(Work(Policy::G) * std::max(maxDepth, Work(Policy::DRY_TOL)));
+  const Work gravityLimit = cellSize_ / waveSpeed * Work(MAX_GRAVITY_COURANT * Policy::CFL);
+  return maxSpeed > Work(0.0) ? std::min(cellSize_ / maxSpeed * Work(Policy::CFL), gravityLimit) : gravityLimit;
+}
+
+template <class Policy>
+void Blocks::SemiImplicitBlock<Policy>::updateUnknowns(Work dt) {
+  const Work dtOverDx = dt / cellSize_;
+
+  // Explicit advection; the ghost cells follow the boundary conditions
+  for (unsigned int i = 1; i <= size_; i++) {
+    huStar_[i] = hu_[i] - dtOverDx * (advection_[i] - advection_[i - 1]);
+  }
+  huStar_[0]         = leftBoundary_ == ReflectingBoundary ? -huStar_[1] : huStar_[1];
+  huStar_[size_ + 1] = rightBoundary_ == ReflectingBoundary ? -huStar_[size_] : huStar_[size_];
+
+  // Edge momentum before the pressure correction and edge depth, both vectorize
+  for (unsigned int e = 0; e < size_ + 1; e++) {
+    momentum_[e] = Work(0.5) * (huStar_[e] + huStar_[e + 1]);
+    depth_[e]    = Work(0.5) * (h_[e] + h_[e + 1]);
+  }
+  // The surface continues into the ghost cells: no gradient across the boundary edges
+  depth_[0]     = Work(0.0);
+  depth_[size_] = Work(0.0);
+
+  // Thomas algorithm, forward elimination of the lower diagonal -alpha H_{i-1}
+  const Work alpha         = Work(Policy::G) * dtOverDx * dtOverDx;
+  Work       upperPrevious = Work(0.0), rhsPrevious = Work(0.0);
+  for (unsigned int i = 1; i <= size_; i++) {
+    const Work lower    = -alpha * depth_[i - 1];
+    const Work upper    = -alpha * depth_[i];
+    const Work diagonal = Work(1.0) - lower - upper;
+    const Work rhs      = h_[i] + b_[i] - dtOverDx * (momentum_[i] - momentum_[i - 1]);
+    const Work pivot    = Work(1.0) / (diagonal - lower * upperPrevious);
+    upperPrevious       = upper * pivot;
+    rhsPrevious         = (rhs - lower * rhsPrevious) * pivot;
+    upper_[i]           = upperPrevious;
+    rhs_[i]             = rhsPrevious;
+  }
+
+  // Back substitution
+  eta_[size_] = rhs_[size_];
+  for (unsigned int i = size_ - 1; i >= 1; i--) {
+    eta_[i] = rhs_[i] - upper_[i] * eta_[i + 1];
+  }
+  eta_[0]         = eta_[1];
+  eta_[size_ + 1] = eta_[size_];
+
+  // Pressure correction of the edge momentum, then the new state as net updates
+  const Work half = Work(0.5) / dtOverDx;
+  for (unsigned int e = 0; e < size_ + 1; e++) {
+    const Work q          = momentum_[e] - Work(Policy::G) * dtOverDx * depth_[e] * (eta_[e + 1] - eta_[e]);
+    hNetUpdatesLeft_[e]   = q;
+    hNetUpdatesRight_[e]  = -q;
+    huNetUpdatesLeft_[e]  = half * (hu_[e] - q);
+    huNetUpdatesRight_[e] = half * (hu_[e + 1] - q);
+  }
+
+  if (monitorResidual_) {
+    residual_ = Residual<Work>();
+  }
+
+  state_.update(
+    1,
+    size_,
+    dtOverDx,
+    hNetUpdatesLeft_.data(),
+    hNetUpdatesRight_.data(),
+    huNetUpdatesLeft_.data(),
+    huNetUpdatesRight_.data(),
+    monitorResidual_ ? &residual_ : nullptr
+  );
+
+  if (monitorResidual_) {
+    residual_.finish(size_, cellSize_);
+  }
+}
+
+template <class Policy>
+void Blocks::SemiImplicitBlock<Policy>::applyBoundaryConditions() {
+  Work h, hu;
+
+  state_.load(1, 1, &h, &hu);
+  state_.set(0, h, leftBoundary_ == ReflectingBoundary ? -hu : hu);
+
+  state_.load(size_, 1, &h, &hu);
+  state_.set(size_ + 1, h, rightBoundary_ == ReflectingBoundary ? -hu : hu);
+}
+
+template <class Policy>
+void Blocks::SemiImplicitBlock<Policy>::getState(RealType* h, RealType* hu, RealType* b) const {
+  state_.extract(h, hu, b);
+}
+
+#define INSTANTIATE_SEMI_IMPLICIT(name, Policy, ARG) \
+  template class Blocks::SemiImplicitBlock<Policy>; \
+  template class Blocks::SemiImplicitBlock<Precision::Primed<Policy>>;
+
+SWE_PRECISION_POLICIES(INSTANTIATE_SEMI_IMPLICIT, )
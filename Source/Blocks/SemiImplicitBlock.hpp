@@ -0,0 +1,122 @@
+/**
+ * @file SemiImplicitBlock.hpp
+ *
+ * Semi-implicit block for long subcritical runs: advection is explicit,
+ * the gravity terms are implicit, so the time step is bounded by the flow
+ * speed |u| instead of the gravity wave speed |u| + sqrt(g h).
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "Blocks/Residual.hpp"
+#include "Blocks/StateStorage.hpp"
+#include "Tools/PrecisionPolicy.hpp"
+#include "Tools/RealType.hpp"
+
+namespace Blocks {
+
+  /**
+   * Unknowns h,hu,b are defined on grid indices [0,..,n+1] like in
+   * WavePropagationBlockMixed, with the same step interface, so that a
+   * time loop can drive either block.
+   *
+   * One step for the surface eta = h + b and the edge momentum q:
+   *   hu*      = hu - dt/dx (F_e - F_{e-1}),   F upwind flux of hu^2/h
+   *   q_e      = (hu*_e + hu*_{e+1}) / 2 - g dt/dx H_e (eta_{e+1} - eta_e)
+   *   eta_i    = eta_i - dt/dx (q_i - q_{i-1})
+   * with the edge depth H_e at the old time level. Inserting q into the
+   * surface update gives a symmetric, diagonally dominant tridiagonal
+   * system for the new surface, solved with the Thomas algorithm. The new
+   * momentum of a cell is the mean of its edges.
+   *
+   * Only for wet domains: the depth of the edges is taken as is.
+   */
+  template <class Policy>
+  class SemiImplicitBlock {
+  public:
+    using Work = typename Policy::Work;
+
+    enum BoundaryCondition {
+      ReflectingBoundary,
+      OutflowBoundary
+    };
+
+  private:
+    StateStorage<Policy> state_;
+
+    unsigned int size_;
+
+    Work cellSize_;
+
+    BoundaryCondition leftBoundary_;
+    BoundaryCondition rightBoundary_;
+
+    /** Cells of the last computeNumericalFluxes() in work precision */
+    std::vector<Work> h_;
+    std::vector<Work> hu_;
+    std::vector<Work> b_;
+
+    /** Per edge: upwind momentum flux hu^2/h, depth and momentum */
+    std::vector<Work> advection_;
+    std::vector<Work> depth_;
+    std::vector<Work> momentum_;
+
+    /** Per cell: momentum after advection, and the eliminated upper diagonal and right-hand side of the Thomas algorithm */
+    std::vector<Work> huStar_;
+    std::vector<Work> upper_;
+    std::vector<Work> rhs_;
+    std::vector<Work> eta_;
+
+    /** Net updates handed to the storage: the new state of updateUnknowns() in the form of WavePropagationBlockMixed */
+    std::vector<Work> hNetUpdatesLeft_;
+    std::vector<Work> hNetUpdatesRight_;
+    std::vector<Work> huNetUpdatesLeft_;
+    std::vector<Work> huNetUpdatesRight_;
+
+    /** Residual of the last updateUnknowns(), only computed while monitoring */
+    bool           monitorResidual_ = false;
+    Residual<Work> residual_;
+
+  public:
+    SemiImplicitBlock(const RealType* h, const RealType* hu, const RealType* b, unsigned int size, RealType cellSize);
+    ~SemiImplicitBlock() = default;
+
+    /**
+     * Multiple of the explicit step CFL dx / max(|u| + sqrt(g h)) that bounds
+     * the time step: the implicit gravity terms are stable beyond it, but damp
+     * the waves more and more, and a state at rest has no advective bound at all
+     */
+    static constexpr double MAX_GRAVITY_COURANT = 10.0;
+
+    /**
+     * Loads the state and computes the upwind advection fluxes
+     *
+     * @return Maximum time step: CFL dx / max |u|, at most MAX_GRAVITY_COURANT explicit steps
+     */
+    Work computeNumericalFluxes();
+
+    /**
+     * Advances the state by dt: explicit advection, then the implicit
+     * surface from one tridiagonal solve
+     */
+    void updateUnknowns(Work dt);
+
+    /** Ghost cells take h and hu (or -hu) of their neighbours */
+    void applyBoundaryConditions();
+
+    /** Copies the state (incl. ghost cells) into h, hu and b */
+    void getState(RealType* h, RealType* hu, RealType* b) const;
+
+    bool hasOverflowed() const { return state_.hasOverflowed(); }
+
+    void setLeftBoundaryCondition(BoundaryCondition condition) { leftBoundary_ = condition; }
+    void setRightBoundaryCondition(BoundaryCondition condition) { rightBoundary_ = condition; }
+
+    /** Steady-state monitoring like WavePropagationBlockMixed::setResidualMonitoring */
+    void                  setResidualMonitoring(bool enabled) { monitorResidual_ = enabled; }
+    const Residual<Work>& getResidual() const { return residual_; }
+  };
+
+} // namespace Blocks
@@ -0,0 +1,677 @@
+/**
+ * @file StateStorage.hpp
+ *
+ * Cell state (h, hu, b) of a block in the memory layout chosen by a precision
+ * policy (Policy::layout). The block never touches the stored values directly:
+ * it loads ranges of cells into Policy::Work, computes, and hands the net
+ * updates back to update(), which applies them in the storage format.
+ *
+ * Cells are grouped in chunks of ChunkSize; layouts that keep per-chunk data
+ * (e.g. the anomaly background, the block floating-point exponents) index it
+ * with i / ChunkSize.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "Blocks/Residual.hpp"
+#include "Tools/PrecisionPolicy.hpp"
+#include "Tools/RealMath.hpp"
+#include "Tools/RealType.hpp"
+
+namespace Blocks {
+
+  /** Number of cells sharing per-chunk data and processed together */
+  constexpr unsigned int ChunkSize = 32;
+
+  namespace detail {
+
+    /** @return Machine epsilon of a storage type, incl. the 16 bit types without numeric_limits */
+    template <class T>
+    constexpr double storeEpsilon() {
+      if constexpr (std::is_same_v<T, double>) {
+        return 0x1p-52;
+      } else if constexpr (std::is_same_v<T, float>) {
+        return 0x1p-23;
+      } else if constexpr (std::is_same_v<T, _Float16>) {
+        return 0x1p-10;
+      } else {
+        return 0x1p-7; // bfloat16
+      }
+    }
+
+    /**
+     * Counter-based hash of (cell, stream) to a uniform value in [0, 1).
+     * Integer only, so it vectorizes together with the encoding.
+     */
+    template <class Work>
+    Work dither(std::uint32_t cell, std::uint32_t stream) {
+      std::uint32_t x = cell * 0x9E3779B1u ^ stream * 0x85EBCA77u;
+      x ^= x >> 15;
+      x *= 0x2C1B3C6Du;
+      x ^= x >> 12;
+      x *= 0x297A2D39u;
+      x ^= x >> 15;
+      return Work(x >> 8) * Work(0x1p-24);
+    }
+
+    /**
+     * Block floating-point encoding of one chunk: mantissas m and a shared
+     * exponent e with v = m * 2^e. The exponent is chosen such that the
+     * largest magnitude fills the mantissa range.
+     *
+     * Values are rounded as floor(v * 2^-e + r[k]): r = 0.5 is round to
+     * nearest, r uniform in [0, 1) is stochastic rounding. Either way
+     * integers (and with them zero) are reproduced exactly.
+     *
+     * The loops have fixed length and no branches, so they are vectorized;
+     * the maximum is a pairwise tree instead of a floating-point reduction.
+     */
+    template <class Store, class Work>
+    void encodeBlock(const Work* v, const Work* r, Store* m, std::int8_t& e) {
+      constexpr int  MantissaBits = std::numeric_limits<Store>::digits;
+      constexpr Work MantissaMax  = Work(std::numeric_limits<Store>::max());
+
+      // Pairwise maximum of the magnitudes
+      Work magnitude[ChunkSize];
+      for (unsigned int k = 0; k < ChunkSize; k++) {
+        magnitude[k] = std::abs(v[k]);
+      }
+      for (unsigned int width = ChunkSize / 2; width > 0; width /= 2) {
+        for (unsigned int k = 0; k < width; k++) {
+          magnitude[k] = max_work(magnitude[k], magnitude[k + width]);
+        }
+      }
+      const Work maxAbs = magnitude[0];
+
+      int exponent = 0;
+      std::frexp(double(maxAbs), &exponent);
+      // The largest value must not round up past the mantissa range
+      if (std::ldexp(double(maxAbs), MantissaBits - exponent) >= double(MantissaMax)) {
+        exponent++;
+      }
+      // Below 2^-100 everything is noise; also keeps 2^-e finite in float
+      const int  shift = std::clamp(exponent - MantissaBits, -100, 100);
+      const Work scale = Work(std::ldexp(1.0, -shift));
+
+      for (unsigned int k = 0; k < ChunkSize; k++) {
+        const Work         y = v[k] * scale + r[k];
+        // The conversion truncates, floor() for negative y
+        const std::int32_t t = static_cast<std::int32_t>(y);
+        m[k]                 = static_cast<Store>(t - (static_cast<Work>(t) > y));
+      }
+      e = static_cast<std::int8_t>(shift);
+    }
+
+    /** encodeBlock() with round to nearest */
+    template <class Store, class Work>
+    void encodeBlock(const Work* v, Store* m, std::int8_t& e) {
+      Work half[ChunkSize];
+      std::fill_n(half, ChunkSize, Work(0.5));
+      encodeBlock(v, half, m, e);
+    }
+
+    template <class Store, class Work>
+    void decodeBlock(const Store* m, unsigned int n, std::int8_t e, Work* v) {
+      const Work scale = Work(std::ldexp(1.0, e));
+      for (unsigned int k = 0; k < n; k++) {
+        v[k] = static_cast<Work>(m[k]) * scale;
+      }
+    }
+
+  } // namespace detail
+
+  /**
+   * Plain and anomaly layouts.
+   *
+   * Plain:   stores h and hu in Policy::Store.
+   * Anomaly: stores eta' = h + b - eta0 instead of h, with the background
+   *          eta0 held per chunk in float. h is reconstructed on load as
+   *          eta' + eta0 - b.
+   *
+   * If Policy::use_kahan is set, the rounding error of every store is kept
+   * in a second Store array and added back on load (compensated storage).
+   */
+  template <class Policy, Precision::Layout Layout = Policy::layout>
+  class StateStorage {
+    static_assert(Layout == Precision::Layout::Plain || Layout == Precision::Layout::Anomaly, "see specializations below");
+
+  public:
+    using Store      = typename Policy::Store;
+    using Work       = typename Policy::Work;
+    using Bathymetry = std::conditional_t<Policy::keep_bathymetry_in_f32 && sizeof(Store) < 4, float, Store>;
+
+    static constexpr bool anomaly = Layout == Precision::Layout::Anomaly;
+    static_assert(!anomaly || sizeof(Bathymetry) >= 4, "anomaly storage needs the bathymetry in at least float");
+
+    /** Bytes of state per cell (h, hu, b, compensation and per-chunk data) */
+    static constexpr double bytesPerCell = 2.0 * sizeof(Store) * (Policy::use_kahan ? 2 : 1) + sizeof(Bathymetry)
+                                           + (anomaly ? double(sizeof(float)) / ChunkSize : 0.0);
+
+  private:
+    std::vector<Store>      h_;  // h (plain) or eta' (anomaly)
+    std::vector<Store>      hu_;
+    std::vector<Store>      hComp_;  // compensation, only used with use_kahan
+    std::vector<Store>      huComp_;
+    std::vector<Bathymetry> b_;
+    std::vector<float>      eta0_; // background per chunk, only used for anomaly
+
+    Work background(unsigned int i) const {
+      if constexpr (anomaly) {
+        return Work(eta0_[i / ChunkSize]);
+      } else {
+        return Work(0);
+      }
+    }
+
+    // Stored water column value (h or eta') in work precision
+    Work column(unsigned int i) const {
+      if constexpr (Policy::use_kahan) {
+        return static_cast<Work>(h_[i]) + static_cast<Work>(hComp_[i]);
+      } else {
+        return static_cast<Work>(h_[i]);
+      }
+    }
+
+    Work momentum(unsigned int i) const {
+      if constexpr (Policy::use_kahan) {
+        return static_cast<Work>(hu_[i]) + static_cast<Work>(huComp_[i]);
+      } else {
+        return static_cast<Work>(hu_[i]);
+      }
+    }
+
+    // Depth from the stored column value
+    Work depth(unsigned int i, Work column, Work b) const {
+      if constexpr (anomaly) {
+        const Work h = column + background(i) - b;
+        // A dry cell stores eta' = b - eta0; anything below its rounding error is no water
+        return (h < Work(detail::storeEpsilon<Store>()) * std::abs(column)) ? Work(0) : h;
+      } else {
+        return column;
+      }
+    }
+
+    void store(unsigned int i, Work column, Work hu) {
+      h_[i]  = static_cast<Store>(column);
+      hu_[i] = static_cast<Store>(hu);
+      if constexpr (Policy::use_kahan) {
+        hComp_[i]  = static_cast<Store>(column - static_cast<Work>(h_[i]));
+        huComp_[i] = static_cast<Store>(hu - static_cast<Work>(hu_[i]));
+      }
+    }
+
+  public:
+    /**
+     * @param cells Number of cells including the ghost layer
+     */
+    explicit StateStorage(unsigned int cells):
+      h_(cells),
+      hu_(cells),
+      hComp_(Policy::use_kahan ? cells : 0),
+      huComp_(Policy::use_kahan ? cells : 0),
+      b_(cells),
+      eta0_(anomaly ? (cells + ChunkSize - 1) / ChunkSize : 0) {}
+
+    unsigned int getCells() const { return static_cast<unsigned int>(h_.size()); }
+
+    /** @return Whether a value left the Store range (fixed point only) */
+    bool hasOverflowed() const { return false; }
+
+    /**
+     * Imports the state; for the anomaly layout this also fixes the
+     * background of every chunk (mean surface of its wet cells).
+     */
+    void assign(const RealType* h, const RealType* hu, const RealType* b) {
+      const unsigned int cells = getCells();
+      for (unsigned int i = 0; i < cells; i++) {
+        b_[i] = static_cast<Bathymetry>(b[i]);
+      }
+      if constexpr (anomaly) {
+        for (unsigned int c = 0; c < eta0_.size(); c++) {
+          const unsigned int last = std::min(cells, (c + 1) * ChunkSize);
+          double             sum  = 0.0;
+          double             bSum = 0.0;
+          unsigned int       wet  = 0;
+          for (unsigned int i = c * ChunkSize; i < last; i++) {
+            bSum += double(b_[i]);
+            if (h[i] > 0.0) {
+              sum += double(h[i]) + double(b_[i]);
+              wet++;
+            }
+          }
+          eta0_[c] = static_cast<float>(wet > 0 ? sum / wet : bSum / (last - c * ChunkSize));
+        }
+      }
+      for (unsigned int i = 0; i < cells; i++) {
+        const Work bw = static_cast<Work>(b_[i]);
+        store(i, anomaly ? Work(h[i]) + bw - background(i) : Work(h[i]), Work(hu[i]));
+      }
+    }
+
+    /** Exports the state (e.g. for the writers) */
+    void extract(RealType* h, RealType* hu, RealType* b) const {
+      for (unsigned int i = 0; i < getCells(); i++) {
+        const Work bw = static_cast<Work>(b_[i]);
+        h[i]          = RealType(depth(i, column(i), bw));
+        hu[i]         = RealType(momentum(i));
+        b[i]          = RealType(bw);
+      }
+    }
+
+    /** Loads cells [first, first + count) into work precision */
+    void load(unsigned int first, unsigned int count, Work* h, Work* hu, Work* b) const {
+      for (unsigned int k = 0; k < count; k++) {
+        const unsigned int i = first + k;
+        b[k]                 = static_cast<Work>(b_[i]);
+        h[k]                 = depth(i, column(i), b[k]);
+        hu[k]                = momentum(i);
+      }
+    }
+
+    /** Loads h and hu of cells [first, first + count); b is only read to reconstruct h from eta' */
+    void load(unsigned int first, unsigned int count, Work* h, Work* hu) const {
+      for (unsigned int k = 0; k < count; k++) {
+        const unsigned int i = first + k;
+        h[k]                 = depth(i, column(i), anomaly ? static_cast<Work>(b_[i]) : Work(0));
+        hu[k]                = momentum(i);
+      }
+    }
+
+    /** Overwrites one cell (used for the ghost layer) */
+    void set(unsigned int i, Work h, Work hu, Work b) {
+      b_[i] = static_cast<Bathymetry>(b);
+      store(i, anomaly ? h + static_cast<Work>(b_[i]) - background(i) : h, hu);
+    }
+
+    /** Overwrites h and hu of one cell, keeping its bathymetry */
+    void set(unsigned int i, Work h, Work hu) {
+      store(i, anomaly ? h + static_cast<Work>(b_[i]) - background(i) : h, hu);
+    }
+
+    /**
+     * Applies the net updates to cells [first, first + count). Cell i
+     * receives the right update of edge i-1 and the left update of edge i.
+     * Cells that fall dry are reset to h = hu = 0.
+     *
+     * @param residual If not null, every cell is added to it on the way
+     */
+    void update(
+      unsigned int    first,
+      unsigned int    count,
+      Work            dtOverDx,
+      const Work*     hNetUpdatesLeft,
+      const Work*     hNetUpdatesRight,
+      const Work*     huNetUpdatesLeft,
+      const Work*     huNetUpdatesRight,
+      Residual<Work>* residual = nullptr
+    ) {
+      for (unsigned int i = first; i < first + count; i++) {
+        const Work dH  = hNetUpdatesRight[i - 1] + hNetUpdatesLeft[i];
+        const Work dHU = huNetUpdatesRight[i - 1] + huNetUpdatesLeft[i];
+        if (residual != nullptr) {
+          residual->add(dH, dHU);
+        }
+
+        // b and eta0 are constant, so eta' changes exactly like h
+        Work value = std::fma(-dtOverDx, dH, column(i));
+        Work hu    = std::fma(-dtOverDx, dHU, momentum(i));
+
+        const Work b = static_cast<Work>(b_[i]);
+        const Work h = anomaly ? value + background(i) - b : value;
+        if (h < Work(0)) {
+          value = anomaly ? b - background(i) : Work(0);
+          hu    = Work(0);
+        }
+        store(i, value, hu);
+      }
+    }
+  };
+
+  /**
+   * Block floating-point layout.
+   *
+   * Every chunk stores h, hu and b as integer mantissas (Policy::Store)
+   * with one exponent per variable, see detail::encodeBlock. Accuracy is
+   * relative to the largest value of the chunk, so smooth fields keep
+   * nearly all mantissa bits. Updates decode a whole chunk, apply the net
+   * updates in Policy::Work and encode it again; unchanged cells are
+   * reproduced exactly as long as the exponent does not change.
+   *
+   * Updates use stochastic rounding (deterministic, hashed from cell and
+   * step). With round to nearest every increment below half a mantissa
+   * unit is lost, which stalls the tails of waves and lets mass drift.
+   */
+  template <class Policy>
+  class StateStorage<Policy, Precision::Layout::BlockFloat> {
+  public:
+    using Store = typename Policy::Store;
+    using Work  = typename Policy::Work;
+
+    static_assert(std::is_integral_v<Store> && std::is_signed_v<Store>, "block floating point needs signed integer mantissas");
+
+  private:
+    struct Chunk {
+      Store       h[ChunkSize];
+      Store       hu[ChunkSize];
+      Store       b[ChunkSize];
+      std::int8_t hExponent;
+      std::int8_t huExponent;
+      std::int8_t bExponent;
+    };
+
+    std::vector<Chunk> chunks_;
+    unsigned int       cells_;
+    std::uint32_t      step_;
+
+    unsigned int used(unsigned int c) const { return std::min(ChunkSize, cells_ - c * ChunkSize); }
+
+    void decodeChunk(unsigned int c, Work* h, Work* hu, Work* b) const {
+      const Chunk& chunk = chunks_[c];
+      detail::decodeBlock(chunk.h, ChunkSize, chunk.hExponent, h);
+      detail::decodeBlock(chunk.hu, ChunkSize, chunk.huExponent, hu);
+      detail::decodeBlock(chunk.b, ChunkSize, chunk.bExponent, b);
+    }
+
+  public:
+    /** Bytes of state per cell (mantissas and per-chunk exponents) */
+    static constexpr double bytesPerCell = double(sizeof(Chunk)) / ChunkSize;
+
+    /**
+     * @param cells Number of cells including the ghost layer
+     */
+    explicit StateStorage(unsigned int cells):
+      chunks_((cells + ChunkSize - 1) / ChunkSize, Chunk{}),
+      cells_(cells),
+      step_(0) {}
+
+    unsigned int getCells() const { return cells_; }
+
+    bool hasOverflowed() const { return false; }
+
+    /** Imports the state and chooses the exponents of every chunk */
+    void assign(const RealType* h, const RealType* hu, const RealType* b) {
+      for (unsigned int c = 0; c < chunks_.size(); c++) {
+        Work hc[ChunkSize] = {}, huc[ChunkSize] = {}, bc[ChunkSize] = {};
+        for (unsigned int k = 0; k < used(c); k++) {
+          hc[k]  = Work(h[c * ChunkSize + k]);
+          huc[k] = Work(hu[c * ChunkSize + k]);
+          bc[k]  = Work(b[c * ChunkSize + k]);
+        }
+        detail::encodeBlock(hc, chunks_[c].h, chunks_[c].hExponent);
+        detail::encodeBlock(huc, chunks_[c].hu, chunks_[c].huExponent);
+        detail::encodeBlock(bc, chunks_[c].b, chunks_[c].bExponent);
+      }
+    }
+
+    /** Exports the state (e.g. for the writers) */
+    void extract(RealType* h, RealType* hu, RealType* b) const {
+      for (unsigned int c = 0; c < chunks_.size(); c++) {
+        Work hc[ChunkSize], huc[ChunkSize], bc[ChunkSize];
+        decodeChunk(c, hc, huc, bc);
+        for (unsigned int k = 0; k < used(c); k++) {
+          h[c * ChunkSize + k]  = RealType(hc[k]);
+          hu[c * ChunkSize + k] = RealType(huc[k]);
+          b[c * ChunkSize + k]  = RealType(bc[k]);
+        }
+      }
+    }
+
+    /** Loads cells [first, first + count) into work precision, chunk by chunk */
+    void load(unsigned int first, unsigned int count, Work* h, Work* hu, Work* b) const {
+      for (unsigned int i = first; i < first + count;) {
+        const Chunk&       chunk  = chunks_[i / ChunkSize];
+        const unsigned int offset = i % ChunkSize;
+        const unsigned int n      = std::min(ChunkSize - offset, first + count - i);
+        detail::decodeBlock(chunk.h + offset, n, chunk.hExponent, h + (i - first));
+        detail::decodeBlock(chunk.hu + offset, n, chunk.huExponent, hu + (i - first));
+        detail::decodeBlock(chunk.b + offset, n, chunk.bExponent, b + (i - first));
+        i += n;
+      }
+    }
+
+    /** Loads h and hu of cells [first, first + count), without decoding b */
+    void load(unsigned int first, unsigned int count, Work* h, Work* hu) const {
+      for (unsigned int i = first; i < first + count;) {
+        const Chunk&       chunk  = chunks_[i / ChunkSize];
+        const unsigned int offset = i % ChunkSize;
+        const unsigned int n      = std::min(ChunkSize - offset, first + count - i);
+        detail::decodeBlock(chunk.h + offset, n, chunk.hExponent, h + (i - first));
+        detail::decodeBlock(chunk.hu + offset, n, chunk.huExponent, hu + (i - first));
+        i += n;
+      }
+    }
+
+    /** Overwrites h and hu of one cell, keeping its bathymetry; re-encodes h and hu of its chunk */
+    void set(unsigned int i, Work h, Work hu) {
+      const unsigned int c = i / ChunkSize;
+      Work               hc[ChunkSize], huc[ChunkSize];
+      detail::decodeBlock(chunks_[c].h, ChunkSize, chunks_[c].hExponent, hc);
+      detail::decodeBlock(chunks_[c].hu, ChunkSize, chunks_[c].huExponent, huc);
+      hc[i % ChunkSize]  = h;
+      huc[i % ChunkSize] = hu;
+      detail::encodeBlock(hc, chunks_[c].h, chunks_[c].hExponent);
+      detail::encodeBlock(huc, chunks_[c].hu, chunks_[c].huExponent);
+    }
+
+    /** Overwrites one cell (used for the ghost layer); re-encodes its chunk */
+    void set(unsigned int i, Work h, Work hu, Work b) {
+      const unsigned int c = i / ChunkSize;
+      Work               hc[ChunkSize], huc[ChunkSize], bc[ChunkSize];
+      decodeChunk(c, hc, huc, bc);
+      hc[i % ChunkSize]  = h;
+      huc[i % ChunkSize] = hu;
+      bc[i % ChunkSize]  = b;
+      detail::encodeBlock(hc, chunks_[c].h, chunks_[c].hExponent);
+      detail::encodeBlock(huc, chunks_[c].hu, chunks_[c].huExponent);
+      detail::encodeBlock(bc, chunks_[c].b, chunks_[c].bExponent);
+    }
+
+    /**
+     * Applies the net updates to cells [first, first + count), see the
+     * primary template. Bathymetry is constant and is not re-encoded.
+     */
+    void update(
+      unsigned int    first,
+      unsigned int    count,
+      Work            dtOverDx,
+      const Work*     hNetUpdatesLeft,
+      const Work*     hNetUpdatesRight,
+      const Work*     huNetUpdatesLeft,
+      const Work*     huNetUpdatesRight,
+      Residual<Work>* residual = nullptr
+    ) {
+      for (unsigned int i = first; i < first + count;) {
+        const unsigned int c      = i / ChunkSize;
+        const unsigned int offset = i % ChunkSize;
+        const unsigned int n      = std::min(ChunkSize - offset, first + count - i);
+
+        Work hc[ChunkSize], huc[ChunkSize];
+        detail::decodeBlock(chunks_[c].h, ChunkSize, chunks_[c].hExponent, hc);
+        detail::decodeBlock(chunks_[c].hu, ChunkSize, chunks_[c].huExponent, huc);
+
+        for (unsigned int k = offset; k < offset + n; k++) {
+          const unsigned int j   = c * ChunkSize + k;
+          const Work         dH  = hNetUpdatesRight[j - 1] + hNetUpdatesLeft[j];
+          const Work         dHU = huNetUpdatesRight[j - 1] + huNetUpdatesLeft[j];
+          if (residual != nullptr) {
+            residual->add(dH, dHU);
+          }
+
+          const Work h  = std::fma(-dtOverDx, dH, hc[k]);
+          const Work hu = std::fma(-dtOverDx, dHU, huc[k]);
+          hc[k]         = h < Work(0) ? Work(0) : h;
+          huc[k]        = h < Work(0) ? Work(0) : hu;
+        }
+
+        Work hDither[ChunkSize], huDither[ChunkSize];
+        for (unsigned int k = 0; k < ChunkSize; k++) {
+          hDither[k]  = detail::dither<Work>(c * ChunkSize + k, 2 * step_);
+          huDither[k] = detail::dither<Work>(c * ChunkSize + k, 2 * step_ + 1);
+        }
+        detail::encodeBlock(hc, hDither, chunks_[c].h, chunks_[c].hExponent);
+        detail::encodeBlock(huc, huDither, chunks_[c].hu, chunks_[c].huExponent);
+        i += n;
+      }
+      step_++;
+    }
+  };
+
+  /**
+   * Fixed-point layout.
+   *
+   * h, hu and b are integers in units of Policy::h_scale, hu_scale and
+   * b_scale. update() rounds every net update once to integer units
+   * (half away from zero, i.e. odd) and adds it as an integer. For solvers
+   * in flux form (hNetUpdateRight = -hNetUpdateLeft, e.g. RusanovMixed)
+   * the two integers of an edge cancel exactly, so the total of h only
+   * changes by the boundary fluxes, bit for bit.
+   *
+   * Values outside the Store range saturate and set a sticky overflow
+   * flag, which the caller has to check (hasOverflowed()).
+   */
+  template <class Policy>
+  class StateStorage<Policy, Precision::Layout::FixedPoint> {
+  public:
+    using Store = typename Policy::Store;
+    using Work  = typename Policy::Work;
+
+    static_assert(std::is_integral_v<Store> && std::is_signed_v<Store>, "fixed point needs a signed integer Store");
+
+    /** Bytes of state per cell (h, hu and b) */
+    static constexpr double bytesPerCell = 3.0 * sizeof(Store);
+
+  private:
+    std::vector<Store> h_;
+    std::vector<Store> hu_;
+    std::vector<Store> b_;
+    bool               overflow_;
+
+    Store saturate(std::int64_t units) {
+      constexpr std::int64_t Min = std::numeric_limits<Store>::min();
+      constexpr std::int64_t Max = std::numeric_limits<Store>::max();
+      if (units < Min || units > Max) {
+        overflow_ = true;
+        return static_cast<Store>(units < Min ? Min : Max);
+      }
+      return static_cast<Store>(units);
+    }
+
+    // Rounds once to integer units; llround is odd, so -x gives exactly -units(x)
+    static std::int64_t units(double value, double scale) { return std::llround(value / scale); }
+
+  public:
+    /**
+     * @param cells Number of cells including the ghost layer
+     */
+    explicit StateStorage(unsigned int cells):
+      h_(cells),
+      hu_(cells),
+      b_(cells),
+      overflow_(false) {}
+
+    unsigned int getCells() const { return static_cast<unsigned int>(h_.size()); }
+
+    /** @return Whether a value left the Store range since construction */
+    bool hasOverflowed() const { return overflow_; }
+
+    /** @return Sum of h over cells [first, first + count) in integer units */
+    std::int64_t getMassUnits(unsigned int first, unsigned int count) const {
+      std::int64_t mass = 0;
+      for (unsigned int i = first; i < first + count; i++) {
+        mass += h_[i];
+      }
+      return mass;
+    }
+
+    /** Imports the state, rounded to the nearest unit */
+    void assign(const RealType* h, const RealType* hu, const RealType* b) {
+      for (unsigned int i = 0; i < getCells(); i++) {
+        h_[i]  = saturate(units(double(h[i]), Policy::h_scale));
+        hu_[i] = saturate(units(double(hu[i]), Policy::hu_scale));
+        b_[i]  = saturate(units(double(b[i]), Policy::b_scale));
+      }
+    }
+
+    /** Exports the state (e.g. for the writers) */
+    void extract(RealType* h, RealType* hu, RealType* b) const {
+      for (unsigned int i = 0; i < getCells(); i++) {
+        h[i]  = RealType(double(h_[i]) * Policy::h_scale);
+        hu[i] = RealType(double(hu_[i]) * Policy::hu_scale);
+        b[i]  = RealType(double(b_[i]) * Policy::b_scale);
+      }
+    }
+
+    /** Loads cells [first, first + count) into work precision */
+    void load(unsigned int first, unsigned int count, Work* h, Work* hu, Work* b) const {
+      for (unsigned int k = 0; k < count; k++) {
+        h[k]  = static_cast<Work>(h_[first + k]) * Work(Policy::h_scale);
+        hu[k] = static_cast<Work>(hu_[first + k]) * Work(Policy::hu_scale);
+        b[k]  = static_cast<Work>(b_[first + k]) * Work(Policy::b_scale);
+      }
+    }
+
+    /** Loads h and hu of cells [first, first + count) */
+    void load(unsigned int first, unsigned int count, Work* h, Work* hu) const {
+      for (unsigned int k = 0; k < count; k++) {
+        h[k]  = static_cast<Work>(h_[first + k]) * Work(Policy::h_scale);
+        hu[k] = static_cast<Work>(hu_[first + k]) * Work(Policy::hu_scale);
+      }
+    }
+
+    /** Overwrites h and hu of one cell, keeping its bathymetry */
+    void set(unsigned int i, Work h, Work hu) {
+      h_[i]  = saturate(units(double(h), Policy::h_scale));
+      hu_[i] = saturate(units(double(hu), Policy::hu_scale));
+    }
+
+    /** Overwrites one cell (used for the ghost layer) */
+    void set(unsigned int i, Work h, Work hu, Work b) {
+      h_[i]  = saturate(units(double(h), Policy::h_scale));
+      hu_[i] = saturate(units(double(hu), Policy::hu_scale));
+      b_[i]  = saturate(units(double(b), Policy::b_scale));
+    }
+
+    /**
+     * Applies the net updates to cells [first, first + count), see the
+     * primary template. Cells that would fall dry are reset to h = hu = 0,
+     * which is the only place where mass is created.
+     */
+    void update(
+      unsigned int    first,
+      unsigned int    count,
+      Work            dtOverDx,
+      const Work*     hNetUpdatesLeft,
+      const Work*     hNetUpdatesRight,
+      const Work*     huNetUpdatesLeft,
+      const Work*     huNetUpdatesRight,
+      Residual<Work>* residual = nullptr
+    ) {
+      for (unsigned int i = first; i < first + count; i++) {
+        if (residual != nullptr) {
+          residual->add(hNetUpdatesRight[i - 1] + hNetUpdatesLeft[i], huNetUpdatesRight[i - 1] + huNetUpdatesLeft[i]);
+        }
+        const std::int64_t dH = units(double(dtOverDx * hNetUpdatesRight[i - 1]), Policy::h_scale)
+                                + units(double(dtOverDx * hNetUpdatesLeft[i]), Policy::h_scale);
+        const std::int64_t dHU = units(double(dtOverDx * huNetUpdatesRight[i - 1]), Policy::hu_scale)
+                                 + units(double(dtOverDx * huNetUpdatesLeft[i]), Policy::hu_scale);
+
+        const std::int64_t h = std::int64_t(h_[i]) - dH;
+        if (h < 0) {
+          h_[i]  = 0;
+          hu_[i] = 0;
+        } else {
+          h_[i]  = saturate(h);
+          hu_[i] = saturate(std::int64_t(hu_[i]) - dHU);
+        }
+      }
+    }
+  };
+
+} // namespace Blocks
@@ -0,0 +1,518 @@
+/**
+ * @file WavePropagationBlockMixed.cpp
+ *
+ * original author: Sebastian Rettenberger <rettenbs@in.tum.de>
+ */
+
+#include "WavePropagationBlockMixed.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Solver/SolverList.hpp"
+#include "Tools/RealMath.hpp"
+
+template <class Policy, class Solver>
+Blocks::WavePropagationBlockMixed<Policy, Solver>::WavePropagationBlockMixed(
+  const RealType* h, const RealType* hu, const RealType* b, unsigned int size, RealType cellSize
+):
+  state_(size + 2),
+  hNetUpdatesLeft_(size + 1),
+  hNetUpdatesRight_(size + 1),
+  huNetUpdatesLeft_(size + 1),
+  huNetUpdatesRight_(size + 1),
+  size_(size),
+  cellSize_(Work(cellSize)),
+  leftBoundary_(OutflowBoundary),
+  rightBoundary_(OutflowBoundary) {
+
+  // The ghost cells keep the bathymetry of their neighbours for the whole run
+  std::vector<RealType> bWithGhosts(b, b + size + 2);
+  bWithGhosts[0]        = b[1];
+  bWithGhosts[size + 1] = b[size];
+  state_.assign(h, hu, bWithGhosts.data());
+
+  const unsigned int chunks = (size + ChunkSize) / ChunkSize;
+  chunkSpread_.resize(chunks);
+  if constexpr (staticBathymetry) {
+    dropLeft_.resize(size + 1);
+    dropRight_.resize(size + 1);
+    deltaB_.resize(size + 1);
+    wall_.resize(size + 1);
+  }
+  for (unsigned int c = 0; c < chunks; c++) {
+    updateEdgeBathymetry(c);
+  }
+}
+
+template <class Policy, class Solver>
+void Blocks::WavePropagationBlockMixed<Policy, Solver>::updateEdgeBathymetry(unsigned int c) {
+  const unsigned int first = c * ChunkSize;
+  const unsigned int count = std::min(ChunkSize, size_ + 1 - first);
+
+  Work h[ChunkSize + 1], hu[ChunkSize + 1], b[ChunkSize + 1];
+  state_.load(first, count + 1, h, hu, b);
+
+  Work bMin = b[0], bMax = b[0];
+  for (unsigned int k = 1; k <= count; k++) {
+    bMin = std::min(bMin, b[k]);
+    bMax = std::max(bMax, b[k]);
+  }
+  chunkSpread_[c] = bMax < Work(0.0) ? bMax - bMin : std::numeric_limits<Work>::max();
+
+  if constexpr (staticBathymetry) {
+    for (unsigned int k = 0; k < count; k++) {
+      Solver::computeEdgeBathymetry(b[k], b[k + 1], dropLeft_[first + k], dropRight_[first + k], deltaB_[first + k], wall_[first + k]);
+    }
+  }
+
+  if (!linearSpeed_.empty()) {
+    Work maxSpeed = Work(0.0);
+    for (unsigned int k = 0; k <= count; k++) {
+      linearSpeed_[first + k] = b[k] < Work(0.0) ? sqrt_work<Policy>(Work(Policy::G) * -b[k]) : Work(0.0);
+      maxSpeed                = std::max(maxSpeed, linearSpeed_[first + k]);
+    }
+    chunkLinearSpeed_[c] = maxSpeed;
+
+    // The solver's net updates of the outer edges for the sea at rest, relative to its reference flux
+    Work* rest = &linearRest_[4 * c];
+    std::fill_n(rest, 4, Work(0.0));
+    if (bMax < Work(0.0)) {
+      Work hLeft, hRight, huLeft, huRight, speed, hReference, huReference;
+      Solver probe(solver_);
+      probe.computeNetUpdates(-b[0], -b[1], Work(0.0), Work(0.0), b[0], b[1], hLeft, hRight, huLeft, huRight, speed);
+      computeReferenceFlux(-b[0], Work(0.0), b[0], hReference, huReference);
+      rest[0] = hLeft + hReference;
+      rest[1] = huLeft + huReference;
+
+      probe.computeNetUpdates(-b[count - 1], -b[count], Work(0.0), Work(0.0), b[count - 1], b[count], hLeft, hRight, huLeft, huRight, speed);
+      computeReferenceFlux(-b[count], Work(0.0), b[count], hReference, huReference);
+      rest[2] = hRight - hReference;
+      rest[3] = huRight - huReference;
+    }
+  }
+}
+
+template <class Policy, class Solver>
+void Blocks::WavePropagationBlockMixed<Policy, Solver>::setLinearRegion(Work threshold) {
+  linearThreshold_ = threshold;
+  if (threshold > Work(0.0)) {
+    const unsigned int chunks = (size_ + ChunkSize) / ChunkSize;
+    linearSpeed_.resize(size_ + 2);
+    chunkLinearSpeed_.resize(chunks);
+    linearRest_.resize(4 * chunks);
+    for (unsigned int c = 0; c < chunks; c++) {
+      updateEdgeBathymetry(c);
+    }
+  } else {
+    linearSpeed_.clear();
+    chunkLinearSpeed_.clear();
+    linearRest_.clear();
+  }
+}
+
+template <class Policy, class Solver>
+typename Policy::Work Blocks::WavePropagationBlockMixed<Policy, Solver>::computeNumericalFluxes() {
+  Work maxWaveSpeed = Work(0.0);
+
+  // Depth thresholds of the chunk classes, following a dry threshold set at runtime (see Simulation::visitSolver)
+  Work dryBelow = Work(Policy::H_MIN), wetFrom = Work(Policy::DRY_TOL);
+  if constexpr (requires { solver_.getHMin(); }) {
+    dryBelow = solver_.getHMin();
+    wetFrom  = std::max(wetFrom, dryBelow);
+  }
+
+  // Cells of one chunk of edges plus the right neighbour of the last edge
+  Work h[ChunkSize + 1], hu[ChunkSize + 1], b[ChunkSize + 1];
+
+  // Memoization: the hits of this sweep, and whether the last chunk was computed by the solver
+  const unsigned long long hitsBefore = memoHits_;
+  bool                     lastSolved = false;
+
+  // The linear region needs b also with static bathymetry
+  const bool linear = linearThreshold_ > Work(0.0);
+
+  // Loop over all edges, chunk by chunk; edge e lies between cells e and e+1
+  for (unsigned int first = 0; first < size_ + 1; first += ChunkSize) {
+    const unsigned int count = std::min(ChunkSize, size_ + 1 - first);
+    if (staticBathymetry && !linear) {
+      state_.load(first, count + 1, h, hu);
+    } else {
+      state_.load(first, count + 1, h, hu, b);
+    }
+
+    // Classify the chunk by its extreme depths (a branch-free reduction)
+    Work hMin = h[0], hMax = h[0];
+    for (unsigned int k = 1; k <= count; k++) {
+      hMin = std::min(hMin, h[k]);
+      hMax = std::max(hMax, h[k]);
+    }
+
+    // All dry: the solvers' dry handling returns zero anyway
+    const bool previousSolved = lastSolved;
+    lastSolved                = false;
+    if (hMax < dryBelow) {
+      std::fill_n(&hNetUpdatesLeft_[first], count, Work(0.0));
+      std::fill_n(&hNetUpdatesRight_[first], count, Work(0.0));
+      std::fill_n(&huNetUpdatesLeft_[first], count, Work(0.0));
+      std::fill_n(&huNetUpdatesRight_[first], count, Work(0.0));
+      dryChunks_++;
+      continue;
+    }
+
+    // All wet: no dry cell, no wall (b >= 0) and no bathymetry step that dries a reconstructed depth
+    const bool wet = hMin >= wetFrom && chunkSpread_[first / ChunkSize] < hMin;
+    wetChunks_ += wet;
+    mixedChunks_ += !wet;
+
+    // Deep water of small amplitude: linear flux, bounded by the precomputed speeds
+    if (linear && wet && isLinearChunk(first, count, h, hu, b)) {
+      computeLinearChunk(first, count, h, hu, b);
+      maxWaveSpeed = std::max(maxWaveSpeed, chunkLinearSpeed_[first / ChunkSize]);
+      linearChunks_++;
+      continue;
+    }
+    lastSolved = true;
+
+    // Solvers with a batch interface get the whole chunk (see Solvers::HybridSolver)
+    if constexpr (requires { Solver::batched; }) {
+      Work maxChunkSpeed = Work(0.0);
+      solver_.computeNetUpdates(
+        count,
+        h,
+        hu,
+        b,
+        &hNetUpdatesLeft_[first],
+        &hNetUpdatesRight_[first],
+        &huNetUpdatesLeft_[first],
+        &huNetUpdatesRight_[first],
+        maxChunkSpeed
+      );
+      maxWaveSpeed = std::max(maxWaveSpeed, maxChunkSpeed);
+      continue;
+    } else {
+      // With static bathymetry b may not be loaded, the edge terms are compared instead
+      const Work* bOrNull = staticBathymetry ? nullptr : b;
+      if (memoize_ && computeMemoizedChunk(first, count, h, hu, bOrNull, previousSolved, maxWaveSpeed)) {
+        continue;
+      }
+
+      if constexpr (staticBathymetry) {
+        if (wet) {
+          Work maxChunkSpeed = Work(0.0);
+          solver_.computeWetNetUpdates(
+            count,
+            h,
+            hu,
+            &dropLeft_[first],
+            &dropRight_[first],
+            &deltaB_[first],
+            &hNetUpdatesLeft_[first],
+            &hNetUpdatesRight_[first],
+            &huNetUpdatesLeft_[first],
+            &huNetUpdatesRight_[first],
+            maxChunkSpeed
+          );
+          maxWaveSpeed = std::max(maxWaveSpeed, maxChunkSpeed);
+          continue;
+        }
+      }
+
+      for (unsigned int k = 0; k < count; k++) {
+        maxWaveSpeed = std::max(maxWaveSpeed, computeEdge(first + k, k, h, hu, bOrNull));
+      }
+    }
+  }
+
+  // Memoization turns itself off once the state is heterogeneous
+  if (memoize_) {
+    memoEdges_ += size_ + 1;
+    if (double(memoHits_ - hitsBefore) < MinMemoHitRate * double(size_ + 1)) {
+      memoize_ = false;
+    }
+  }
+
+  // Compute CFL condition
+  return maxWaveSpeed > Work(0.0) ? cellSize_ / maxWaveSpeed * Work(Policy::CFL) : std::numeric_limits<Work>::max();
+}
+
+template <class Policy, class Solver>
+inline typename Policy::Work Blocks::WavePropagationBlockMixed<Policy, Solver>::computeEdge(
+  unsigned int e, unsigned int k, const Work* h, const Work* hu, [[maybe_unused]] const Work* b
+) {
+  Work maxEdgeSpeed = Work(0.0);
+  if constexpr (staticBathymetry) {
+    solver_.computeNetUpdates(
+      h[k],
+      h[k + 1],
+      hu[k],
+      hu[k + 1],
+      dropLeft_[e],
+      dropRight_[e],
+      deltaB_[e],
+      wall_[e],
+      hNetUpdatesLeft_[e],
+      hNetUpdatesRight_[e],
+      huNetUpdatesLeft_[e],
+      huNetUpdatesRight_[e],
+      maxEdgeSpeed
+    );
+  } else {
+    solver_.computeNetUpdates(
+      h[k],
+      h[k + 1],
+      hu[k],
+      hu[k + 1],
+      b[k],
+      b[k + 1],
+      hNetUpdatesLeft_[e],
+      hNetUpdatesRight_[e],
+      huNetUpdatesLeft_[e],
+      huNetUpdatesRight_[e],
+      maxEdgeSpeed
+    );
+  }
+  return maxEdgeSpeed;
+}
+
+template <class Policy, class Solver>
+bool Blocks::WavePropagationBlockMixed<Policy, Solver>::computeMemoizedChunk(
+  unsigned int first, unsigned int count, const Work* h, const Work* hu, const Work* b, bool previousSolved, Work& maxWaveSpeed
+) {
+  // Left neighbour of the first cell, for the comparison with edge first - 1
+  Work hPrev = Work(0.0), huPrev = Work(0.0), bPrev = Work(0.0);
+  previousSolved = previousSolved && first > 0;
+  if (previousSolved) {
+    state_.load(first - 1, 1, &hPrev, &huPrev, &bPrev);
+  }
+
+  // Edge k repeats edge k - 1 if the cells k - 1, k and k + 1 are equal (and, with static bathymetry, the edge terms)
+  bool         repeats[ChunkSize];
+  unsigned int hits = 0;
+  for (unsigned int k = 0; k < count; k++) {
+    const unsigned int e     = first + k;
+    const Work         hL    = k > 0 ? h[k - 1] : hPrev;
+    const Work         huL   = k > 0 ? hu[k - 1] : huPrev;
+    bool               equal = (k > 0 || previousSolved) && hL == h[k] && h[k] == h[k + 1] && huL == hu[k] && hu[k] == hu[k + 1];
+    if constexpr (staticBathymetry) {
+      equal = equal && dropLeft_[e] == dropLeft_[e - 1] && dropRight_[e] == dropRight_[e - 1] && deltaB_[e] == deltaB_[e - 1]
+              && wall_[e] == wall_[e - 1];
+    } else {
+      const Work bL = k > 0 ? b[k - 1] : bPrev;
+      equal         = equal && bL == b[k] && b[k] == b[k + 1];
+    }
+    repeats[k] = equal;
+    hits += equal;
+  }
+  if (2 * hits < count) {
+    return false;
+  }
+
+  // Copies carry the speed of the edge they copy, which is already in maxWaveSpeed
+  for (unsigned int k = 0; k < count; k++) {
+    const unsigned int e = first + k;
+    if (repeats[k]) {
+      hNetUpdatesLeft_[e]   = hNetUpdatesLeft_[e - 1];
+      hNetUpdatesRight_[e]  = hNetUpdatesRight_[e - 1];
+      huNetUpdatesLeft_[e]  = huNetUpdatesLeft_[e - 1];
+      huNetUpdatesRight_[e] = huNetUpdatesRight_[e - 1];
+    } else {
+      maxWaveSpeed = std::max(maxWaveSpeed, computeEdge(e, k, h, hu, b));
+    }
+  }
+  memoHits_ += hits;
+  return true;
+}
+
+template <class Policy, class Solver>
+bool Blocks::WavePropagationBlockMixed<Policy, Solver>::isLinearChunk(
+  unsigned int first, unsigned int count, const Work* h, const Work* hu, const Work* b
+) const {
+  // Branch-free reduction: both margins are <= 0 for a linear cell
+  Work margin = -std::numeric_limits<Work>::max();
+  for (unsigned int k = 0; k <= count; k++) {
+    const Work amplitude = std::abs(h[k] + b[k]) + linearThreshold_ * b[k];
+    const Work froude    = std::abs(hu[k]) - linearThreshold_ * h[k] * linearSpeed_[first + k];
+    margin               = std::max(margin, std::max(amplitude, froude));
+  }
+  return margin <= Work(0.0);
+}
+
+template <class Policy, class Solver>
+void Blocks::WavePropagationBlockMixed<Policy, Solver>::computeLinearChunk(
+  unsigned int first, unsigned int count, const Work* h, const Work* hu, const Work* b
+) {
+  for (unsigned int k = 0; k < count; k++) {
+    const unsigned int e     = first + k;
+    const Work         c     = Work(0.5) * (linearSpeed_[e] + linearSpeed_[e + 1]);
+    const Work         dHu   = hu[k + 1] - hu[k];
+    const Work         cDEta = c * ((h[k + 1] + b[k + 1]) - (h[k] + b[k]));
+    const Work         left  = Work(0.5) * (dHu - cDEta);
+    const Work         right = Work(0.5) * (dHu + cDEta);
+
+    hNetUpdatesLeft_[e]   = left;
+    hNetUpdatesRight_[e]  = right;
+    huNetUpdatesLeft_[e]  = -c * left;
+    huNetUpdatesRight_[e] = c * right;
+  }
+
+  // Coupling: the outer net updates in the solver's form, the sea at rest as the solver sees it plus the perturbation.
+  // The reference terms cancel between two linear chunks, the rest terms sum to zero as the solver is well-balanced.
+  const Work*        rest = &linearRest_[4 * (first / ChunkSize)];
+  const unsigned int last = first + count - 1;
+  Work               hReference, huReference;
+  computeReferenceFlux(h[0], hu[0], b[0], hReference, huReference);
+  hNetUpdatesLeft_[first] += rest[0] - (hReference - hu[0]);
+  huNetUpdatesLeft_[first] += rest[1] - (huReference + Work(Policy::G) * b[0] * (h[0] + b[0]));
+  computeReferenceFlux(h[count], hu[count], b[count], hReference, huReference);
+  hNetUpdatesRight_[last] += rest[2] + (hReference - hu[count]);
+  huNetUpdatesRight_[last] += rest[3] + (huReference + Work(Policy::G) * b[count] * (h[count] + b[count]));
+}
+
+template <class Policy, class Solver>
+void Blocks::WavePropagationBlockMixed<Policy, Solver>::computeReferenceFlux(Work h, Work hu, Work b, Work& hFlux, Work& huFlux) const {
+  // A copy, so that the probe does not show up in the solver's statistics
+  Solver probe(solver_);
+  Work   hLeft, hRight, huLeft, huRight, speed;
+  probe.computeNetUpdates(h, h, hu, hu, b, b, hLeft, hRight, huLeft, huRight, speed);
+  hFlux  = hu - hLeft;
+  huFlux = div_work<Policy>(hu * hu, h) + Work(0.5) * Work(Policy::G) * h * h - huLeft;
+}
+
+template <class Policy, class Solver>
+void Blocks::WavePropagationBlockMixed<Policy, Solver>::updateUnknowns(Work dt) {
+  Residual<Work>* residual = nullptr;
+  if (monitorResidual_) {
+    residual_ = Residual<Work>();
+    residual  = &residual_;
+  }
+
+  // Every cell with its own dt: the scaled net updates carry dt / dx already
+  if (localTimeStepping_) {
+    scaleToLocalTimeSteps(residual);
+    dt       = cellSize_;
+    residual = nullptr;
+  }
+
+  // Loop over all inner cells
+  state_.update(
+    1,
+    size_,
+    dt / cellSize_,
+    hNetUpdatesLeft_.data(),
+    hNetUpdatesRight_.data(),
+    huNetUpdatesLeft_.data(),
+    huNetUpdatesRight_.data(),
+    residual
+  );
+
+  if (monitorResidual_) {
+    residual_.finish(size_, cellSize_);
+  }
+}
+
+template <class Policy, class Solver>
+void Blocks::WavePropagationBlockMixed<Policy, Solver>::scaleToLocalTimeSteps(Residual<Work>* residual) {
+  Work h[ChunkSize], hu[ChunkSize];
+
+  for (unsigned int first = 0; first < size_ + 2; first += ChunkSize) {
+    const unsigned int count = std::min(ChunkSize, size_ + 2 - first);
+    state_.load(first, count, h, hu);
+    for (unsigned int k = 0; k < count; k++) {
+      cellSpeed_[first + k] = h[k] > Work(Policy::DRY_TOL)
+                                ? std::abs(div_work<Policy>(hu[k], h[k])) + sqrt_work<Policy>(Work(Policy::G) * h[k])
+                                : Work(0.0);
+    }
+  }
+
+  // Cells without a moving neighbour keep their zero net updates
+  for (unsigned int i = 0; i < size_ + 2; i++) {
+    const Work speed = std::max({cellSpeed_[i > 0 ? i - 1 : 0], cellSpeed_[i], cellSpeed_[std::min(i + 1, size_ + 1)]});
+    localStep_[i]    = speed > Work(0.0) ? Work(Policy::CFL) / speed : Work(0.0);
+  }
+
+  // Cell i takes the right net updates of edge i-1 and the left ones of edge i
+  hNetUpdatesLeft_[0] *= localStep_[0];
+  huNetUpdatesLeft_[0] *= localStep_[0];
+  for (unsigned int i = 1; i <= size_; i++) {
+    if (residual != nullptr) {
+      residual->add(hNetUpdatesRight_[i - 1] + hNetUpdatesLeft_[i], huNetUpdatesRight_[i - 1] + huNetUpdatesLeft_[i]);
+    }
+    hNetUpdatesRight_[i - 1] *= localStep_[i];
+    huNetUpdatesRight_[i - 1] *= localStep_[i];
+    hNetUpdatesLeft_[i] *= localStep_[i];
+    huNetUpdatesLeft_[i] *= localStep_[i];
+  }
+  hNetUpdatesRight_[size_] *= localStep_[size_ + 1];
+  huNetUpdatesRight_[size_] *= localStep_[size_ + 1];
+}
+
+template <class Policy, class Solver>
+void Blocks::WavePropagationBlockMixed<Policy, Solver>::setLocalTimeStepping(bool enabled) {
+  localTimeStepping_ = enabled;
+  cellSpeed_.assign(enabled ? size_ + 2 : 0, Work(0.0));
+  localStep_.assign(enabled ? size_ + 2 : 0, Work(0.0));
+}
+
+template <class Policy, class Solver>
+void Blocks::WavePropagationBlockMixed<Policy, Solver>::applyBoundaryConditions() {
+  Work h, hu;
+
+  if (leftBoundary_ != PrescribedBoundary) {
+    state_.load(1, 1, &h, &hu);
+    state_.set(0, h, leftBoundary_ == ReflectingBoundary ? -hu : hu);
+  }
+
+  if (rightBoundary_ != PrescribedBoundary) {
+    state_.load(size_, 1, &h, &hu);
+    state_.set(size_ + 1, h, rightBoundary_ == ReflectingBoundary ? -hu : hu);
+  }
+}
+
+template <class Policy, class Solver>
+void Blocks::WavePropagationBlockMixed<Policy, Solver>::getState(RealType* h, RealType* hu, RealType* b) const {
+  state_.extract(h, hu, b);
+}
+
+template <class Policy, class Solver>
+void Blocks::WavePropagationBlockMixed<Policy, Solver>::getCells(unsigned int first, unsigned int count, RealType* h, RealType* hu, RealType* b) const {
+  Work hWork[ChunkSize], huWork[ChunkSize], bWork[ChunkSize];
+
+  for (unsigned int k = 0; k < count; k += ChunkSize) {
+    const unsigned int n = std::min(ChunkSize, count - k);
+    state_.load(first + k, n, hWork, huWork, bWork);
+    for (unsigned int j = 0; j < n; j++) {
+      h[k + j]  = RealType(hWork[j]);
+      hu[k + j] = RealType(huWork[j]);
+      b[k + j]  = RealType(bWork[j]);
+    }
+  }
+}
+
+template <class Policy, class Solver>
+void Blocks::WavePropagationBlockMixed<Policy, Solver>::setCell(unsigned int i, RealType h, RealType hu, RealType b) {
+  state_.set(i, Work(h), Work(hu), Work(b));
+
+  // Edges i-1 and i, which may lie in two chunks
+  const unsigned int lastChunk = size_ / ChunkSize;
+  for (unsigned int c = (i > 0 ? i - 1 : 0) / ChunkSize; c <= std::min(i / ChunkSize, lastChunk); c++) {
+    updateEdgeBathymetry(c);
+  }
+}
+
+template <class Policy, class Solver>
+void Blocks::WavePropagationBlockMixed<Policy, Solver>::setRightBoundaryCondition(BoundaryCondition condition) {
+  rightBoundary_ = condition;
+}
+
+template <class Policy, class Solver>
+void Blocks::WavePropagationBlockMixed<Policy, Solver>::setLeftBoundaryCondition(BoundaryCondition condition) {
+  leftBoundary_ = condition;
+}
+
+#define INSTANTIATE_BLOCK(name, Policy, Solver)        template class Blocks::WavePropagationBlockMixed<Policy, Solver<Policy>>;
+#define INSTANTIATE_PRIMED_BLOCK(name, Policy, Solver) INSTANTIATE_BLOCK(name, Precision::Primed<Policy>, Solver)
+
+SWE_POLICIES_AND_SOLVERS(INSTANTIATE_BLOCK)
+SWE_PRIMED_POLICIES_AND_SOLVERS(INSTANTIATE_PRIMED_BLOCK)
@@ -0,0 +1,319 @@
+/**
+ * @file WavePropagationBlockMixed.hpp
+ *
+ * Wave propagation block templated on a precision policy (Tools/PrecisionPolicy.hpp)
+ * and a solver. The state is kept in the policy's storage layout
+ * (Blocks/StateStorage.hpp), all arithmetic is done in Policy::Work.
+ *
+ * original author: Sebastian Rettenberger <rettenbs@in.tum.de>
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "Blocks/Residual.hpp"
+#include "Blocks/StateStorage.hpp"
+#include "Solver/RusanovMixed.hpp"
+#include "Tools/PrecisionPolicy.hpp"
+#include "Tools/RealType.hpp"
+
+namespace Blocks {
+
+  /**
+   * Unknowns h,hu,b are defined on grid indices [0,..,n+1]
+   *   -> computational domain is [1,..,nx]
+   *   -> plus ghost cell layer
+   *
+   * In contrast to WavePropagationBlock the block owns its state: the caller
+   * hands in the initial values and reads them back with getState().
+   *
+   * Net-updates are defined for edges with indices [0,..,n], the edge (i-1)
+   * is located between the cells (i-1) and (i) (see WavePropagationBlock).
+   */
+  template <class Policy, class Solver = Solvers::RusanovMixed<Policy>>
+  class WavePropagationBlockMixed {
+  public:
+    using Work = typename Policy::Work;
+
+    enum BoundaryCondition {
+      ReflectingBoundary,
+      OutflowBoundary,
+      PrescribedBoundary // ghost cell is set by the caller (setCell)
+    };
+
+  private:
+    StateStorage<Policy> state_;
+
+    std::vector<Work> hNetUpdatesLeft_;
+    std::vector<Work> hNetUpdatesRight_;
+
+    std::vector<Work> huNetUpdatesLeft_;
+    std::vector<Work> huNetUpdatesRight_;
+
+    unsigned int size_;
+
+    Work cellSize_;
+
+    BoundaryCondition leftBoundary_;
+    BoundaryCondition rightBoundary_;
+
+    /** The solver used in computeNumericalFluxes */
+    Solver solver_;
+
+    /**
+     * Solvers with computeEdgeBathymetry (see Solvers::RusanovMixed) take
+     * precomputed bathymetry terms instead of bL, bR. They provide the
+     * matching computeNetUpdates and computeWetNetUpdates overloads.
+     */
+    static constexpr bool staticBathymetry = requires(Work w, unsigned char wall) {
+      Solver::computeEdgeBathymetry(w, w, w, w, w, wall);
+    };
+
+    /** Static bathymetry terms per edge, only filled with staticBathymetry */
+    std::vector<Work>          dropLeft_;
+    std::vector<Work>          dropRight_;
+    std::vector<Work>          deltaB_;
+    std::vector<unsigned char> wall_;
+
+    /** Per chunk of edges: bMax - bMin of its cells, max() if one of them is a wall (b >= 0) */
+    std::vector<Work> chunkSpread_;
+
+    /** Chunks of edges per class since the last resetChunkCounters() (see computeNumericalFluxes) */
+    unsigned long long wetChunks_   = 0;
+    unsigned long long dryChunks_   = 0;
+    unsigned long long mixedChunks_ = 0;
+
+    /** Runs of repeated edges are solved once (see setMemoization) */
+    bool memoize_ = false;
+
+    /** Edges swept with memoization on and edges copied from their left neighbour, since resetMemoCounters() */
+    unsigned long long memoEdges_ = 0;
+    unsigned long long memoHits_  = 0;
+
+    /** Amplitude and Froude number below which a chunk is linear, 0 for off (see setLinearRegion) */
+    Work linearThreshold_ = Work(0.0);
+
+    /** Linear wave speed sqrt(G * -b) per cell and its maximum per chunk of edges, only filled with a linear region */
+    std::vector<Work> linearSpeed_;
+    std::vector<Work> chunkLinearSpeed_;
+    /** Per chunk of edges: the solver's h, hu net updates left of its first and right of its last edge for the sea at rest */
+    std::vector<Work> linearRest_;
+
+    /** Chunks advanced by the linear flux since resetChunkCounters() */
+    unsigned long long linearChunks_ = 0;
+
+    /** Residual of the last updateUnknowns(), only computed while monitoring (see setResidualMonitoring) */
+    bool           monitorResidual_ = false;
+    Residual<Work> residual_;
+
+    /** Pseudo-time stepping (see setLocalTimeStepping) */
+    bool localTimeStepping_ = false;
+
+    /** Per cell, only filled with local time stepping: |u| + sqrt(G h) and the local dt / dx */
+    std::vector<Work> cellSpeed_;
+    std::vector<Work> localStep_;
+
+    /** Recomputes the bathymetry spread and terms (and linear wave speeds) of the chunk of edges c from the stored b */
+    void updateEdgeBathymetry(unsigned int c);
+
+    /**
+     * Net updates of edge e = first + k with the per-edge solver, h, hu
+     * and b hold the cells of the chunk from cell first on
+     *
+     * @return The edge speed
+     */
+    Work computeEdge(unsigned int e, unsigned int k, const Work* h, const Work* hu, const Work* b);
+
+    /**
+     * Run-length pass over a chunk: an edge whose (hL, hR, huL, huR, bL, bR)
+     * equals that of its left neighbour copies the neighbour's net updates,
+     * every other edge is solved by computeEdge. Bit-identical to solving
+     * every edge.
+     *
+     * @param previousSolved The net updates of edge first - 1 were computed by a solver in this sweep
+     * @return False, without computing anything, if less than half of the edges repeat
+     */
+    bool computeMemoizedChunk(
+      unsigned int first, unsigned int count, const Work* h, const Work* hu, const Work* b, bool previousSolved, Work& maxWaveSpeed
+    );
+
+    /**
+     * @return Whether all cells of the chunk, h, hu and b from cell first
+     *   on, are below linearThreshold_ in amplitude |h + b| / -b and Froude number
+     */
+    bool isLinearChunk(unsigned int first, unsigned int count, const Work* h, const Work* hu, const Work* b) const;
+
+    /**
+     * Net updates of the linearized shallow water equations around the sea
+     * at rest, h_t + (hu)_x = 0, (hu)_t + c^2 (h + b)_x = 0, with the edge
+     * speed c the mean of the precomputed cell speeds: an f-wave split of
+     * the flux jump into the waves -c and +c, without sqrt or division.
+     *
+     * The solvers differ in the flux their net updates are relative to
+     * (e.g. RusanovMixed: none, the f-wave solvers: the physical flux), so
+     * the outer net updates of the chunk are shifted into the solver's form
+     * with computeReferenceFlux and the precomputed linearRest_.
+     */
+    void computeLinearChunk(unsigned int first, unsigned int count, const Work* h, const Work* hu, const Work* b);
+
+    /**
+     * @return In hFlux, huFlux: the flux of cell (h, hu, b) the solver's net
+     *   updates are relative to, the physical flux minus its left net update
+     *   for equal states on both sides
+     */
+    void computeReferenceFlux(Work h, Work hu, Work b, Work& hFlux, Work& huFlux) const;
+
+    /**
+     * Scales the net updates of every edge by the local dt / dx of the
+     * cell they are applied to: dt_i = CFL dx / s_i with s_i the fastest
+     * characteristic speed |u| + sqrt(G h) of the cells i-1, i and i+1,
+     * which bounds the wave speeds of both edges of cell i
+     *
+     * @param residual If not null, every inner cell is added to it before it is scaled
+     */
+    void scaleToLocalTimeSteps(Residual<Work>* residual);
+
+  public:
+    /**
+     * Bathymetry is static: the ghost cells take the bathymetry of their
+     * neighbours, the per-edge terms derived from it are computed here and
+     * only refreshed by setCell.
+     *
+     * @param h, hu, b Initial values on [0,..,n+1]
+     * @param size Domain size (= number of cells) without ghost cells
+     * @param cellSize Size of one cell
+     */
+    WavePropagationBlockMixed(const RealType* h, const RealType* hu, const RealType* b, unsigned int size, RealType cellSize);
+    ~WavePropagationBlockMixed() = default;
+
+    /**
+     * Computes the net-updates from the unknowns
+     *
+     * The edges are processed in chunks of ChunkSize, each classified first:
+     * all-dry chunks get zero net updates without calling the solver,
+     * all-wet chunks use the solver's branch-free computeWetNetUpdates (if
+     * it has one), mixed chunks the general per-edge computeNetUpdates.
+     * With a linear region, wet chunks of small amplitude and Froude number
+     * take computeLinearChunk; with memoization, chunks whose edges mostly
+     * repeat their left neighbour take computeMemoizedChunk.
+     *
+     * @return The maximum possible time step
+     */
+    Work computeNumericalFluxes();
+
+    /**
+     * Update the unknowns with the already computed net-updates
+     *
+     * @param dt Time step size, unused with local time stepping
+     */
+    void updateUnknowns(Work dt);
+
+    /**
+     * Updates h and hu according to the set condition on both
+     * boundaries (the ghost bathymetry is fixed, see the constructor)
+     */
+    void applyBoundaryConditions();
+
+    /**
+     * Copies the current state (incl. ghost cells) to h, hu and b
+     */
+    void getState(RealType* h, RealType* hu, RealType* b) const;
+
+    /**
+     * Copies cells [first, first + count) to h, hu and b
+     */
+    void getCells(unsigned int first, unsigned int count, RealType* h, RealType* hu, RealType* b) const;
+
+    /**
+     * Overwrites cell i, e.g. a ghost cell with PrescribedBoundary, and
+     * refreshes the bathymetry terms of its two edges
+     */
+    void setCell(unsigned int i, RealType h, RealType hu, RealType b);
+
+    /**
+     * Sets left boundary condition to parameter
+     *
+     * Do NOT call when simulation is running, will result in unexpected behaviour
+     * @param condition boundary condition, that should be implemented on the left border
+     */
+    void setLeftBoundaryCondition(BoundaryCondition condition);
+
+    /**
+     * Sets right boundary condition to parameter
+     *
+     * Do NOT call when simulation is running, will result in unexpected behaviour
+     * @param condition boundary condition, that should be implemented on the right border
+     */
+    void setRightBoundaryCondition(BoundaryCondition condition);
+
+    /** @return Whether the state left the range of a fixed-point Store (see StateStorage) */
+    bool hasOverflowed() const { return state_.hasOverflowed(); }
+
+    unsigned int getSize() const { return size_; }
+    Work         getCellSize() const { return cellSize_; }
+    Solver&      getSolver() { return solver_; }
+
+    /// Chunk classes counted by computeNumericalFluxes
+    unsigned long long getWetChunks() const { return wetChunks_; }
+    unsigned long long getDryChunks() const { return dryChunks_; }
+    unsigned long long getMixedChunks() const { return mixedChunks_; }
+    unsigned long long getLinearChunks() const { return linearChunks_; }
+    void               resetChunkCounters() { wetChunks_ = dryChunks_ = mixedChunks_ = linearChunks_ = 0; }
+
+    /**
+     * Deep-water region: wet chunks whose cells all have |h + b| <= threshold * -b
+     * and |hu| <= threshold * h * sqrt(G * -b) are advanced with the linear
+     * flux of computeLinearChunk, all others with the solver. Every edge
+     * takes one of the two, so mass is conserved across the interfaces. The
+     * linear chunks count as wet chunks as well.
+     *
+     * Call after the solver is configured: the coupling terms are precomputed with it.
+     *
+     * @param threshold Amplitude-to-depth ratio and Froude number, 0 turns the region off
+     */
+    void setLinearRegion(Work threshold);
+    Work getLinearThreshold() const { return linearThreshold_; }
+
+    /**
+     * Memoization for piecewise-constant states: runs of edges with
+     * identical (hL, hR, huL, huR, bL, bR), e.g. the undisturbed regions of
+     * a dam break, are solved once per run. It turns itself off after a
+     * sweep with a hit rate below MinMemoHitRate, i.e. once the state is
+     * heterogeneous. Not used by batched solvers (Solvers::HybridSolver).
+     */
+    void setMemoization(bool enabled) { memoize_ = enabled; }
+    bool isMemoizing() const { return memoize_; }
+
+    /// Memoization counters of computeNumericalFluxes
+    unsigned long long getMemoEdges() const { return memoEdges_; }
+    unsigned long long getMemoHits() const { return memoHits_; }
+    void               resetMemoCounters() { memoEdges_ = memoHits_ = 0; }
+
+    /**
+     * Steady-state monitoring: updateUnknowns() accumulates the residual
+     * from the net updates in the loop that applies them (see Blocks::Residual)
+     */
+    void                  setResidualMonitoring(bool enabled) { monitorResidual_ = enabled; }
+    const Residual<Work>& getResidual() const { return residual_; }
+
+    /**
+     * Pseudo-time stepping for steady states: updateUnknowns() advances
+     * every cell with its own maximum stable dt (see scaleToLocalTimeSteps)
+     * instead of the global dt of computeNumericalFluxes(). Not time
+     * accurate, and mass moves between cells of different dt, but the
+     * steady state, where the net updates of every cell cancel, is the
+     * same. The residual (see setResidualMonitoring) is taken in the
+     * scaling loop, before the scaling, so it stays the physical rate of change.
+     */
+    void setLocalTimeStepping(bool enabled);
+    bool isLocalTimeStepping() const { return localTimeStepping_; }
+
+    /** Hit rate of a sweep below which memoization turns itself off: less than one hit per chunk */
+    static constexpr double MinMemoHitRate = 1.0 / ChunkSize;
+
+    /** @return Bytes of state per cell in the policy's storage layout */
+    static constexpr double getBytesPerCell() { return StateStorage<Policy>::bytesPerCell; }
+  };
+
+} // namespace Blocks
@@ -34,15 +34,27 @@
  * @author Sebastian Rettenberger <rettenbs@in.tum.de>
  */
 
+#include <algorithm>
 #include <cstring>
 #include <cfenv>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 #include "Blocks/WavePropagationBlock.hpp"
 #include "Scenarios/DamBreakScenario.hpp"
+#include "Scenarios/OceanShelfScenario.hpp"
 #include "Scenarios/Scenario.hpp"
 #include "Scenarios/ShockRareProblemScenario.hpp"
 #include "Scenarios/SubcriticalFlowScenario.hpp"
 #include "Scenarios/SupercriticalFlowScenario.hpp"
+#include "Simulation/GridSequencing.hpp"
+#include "Simulation/Parareal.hpp"
+#include "Simulation/PrecisionTuner.hpp"
+#include "Simulation/Simulation.hpp"
+#include "Simulation/SolverRegistry.hpp"
 #include "Tools/Args.hpp"
 #include "Tools/Logger.hpp"
 #include "Tools/RealType.hpp"
@@ -71,6 +83,214 @@ int main(int argc, char** argv) {
     case 'B':
       scenario = new Scenarios::SubcriticalFlowScenario(args.getSize());
       break;
+    case 'O':
+      scenario = new Scenarios::OceanShelfScenario(args.getSize());
+      break;
+  }
+
+  // Precision policies and solver selected at runtime, run back to back
+  if (!args.getPrecision().empty() || !args.getSolver().empty()) {
+    Simulation::SolverSpec solverSpec;
+    if (!Simulation::parseSolverSpec(args.getSolver().empty() ? "rusanov" : args.getSolver(), solverSpec)) {
+      std::string message = "Malformed solver parameters in '" + args.getSolver() + "', expected NAME:KEY=VALUE";
+      Tools::Logger::logger.error(message);
+    }
+
+    // --solver alone runs the policy matching RealType
+    std::string selection = args.getPrecision();
+    if (selection.empty()) {
+      selection = std::is_same_v<RealType, float> ? "float" : "double";
+    }
+    if (selection == "auto") {
+      const Simulation::Tuning tuning = Simulation::tunePrecision(
+        *scenario, args.getSize(), args.getTimeSteps(), args.getTolerance(), solverSpec, args.getPrimed()
+      );
+
+      Tools::Logger::logger
+        << "Precision calibration: " << Simulation::CalibrationSteps << " steps, shadow on " << tuning.sampledCells
+        << " cells, tolerance=" << args.getTolerance() << "m" << std::endl;
+      for (const Simulation::Calibration& calibration : tuning.candidates) {
+        Tools::Logger::logger
+          << calibration.name << ", bytesPerCell=" << calibration.bytesPerCell << ", error=" << calibration.error
+          << "m, growthRate=" << calibration.growthRate << "m/step, projectedError=" << calibration.projectedError << "m"
+          << (calibration.overflow ? ", overflow" : "") << (calibration.accepted ? ", accepted" : ", rejected") << std::endl;
+      }
+      Tools::Logger::logger << "Selected precision: " << tuning.precision << std::endl;
+      selection = tuning.precision;
+    }
+
+    Simulation::RunOptions options;
+    options.memoize           = args.getMemoize();
+    options.linearThreshold   = args.getLinear();
+    options.semiImplicit      = args.getSemiImplicit();
+    options.steadyTolerance   = args.getSteadyTolerance();
+    options.steadyWindow      = args.getSteadyWindow();
+    options.localTimeStepping = args.getPseudoTime();
+    if (options.semiImplicit && args.getShadowChunks() >= 0) {
+      Tools::Logger::logger.error("--semi-implicit does not support --shadow");
+    }
+    if (options.localTimeStepping
+        && (!(options.steadyTolerance > 0.0) || options.semiImplicit || args.getShadowChunks() >= 0)) {
+      Tools::Logger::logger.error("--pseudo-time needs --steady-tol and does not support --semi-implicit or --shadow");
+    }
+    Simulation::PararealOptions parareal;
+    parareal.slices = args.getPararealSlices();
+    if (parareal.slices > 0
+        && (!(args.getEndTime() > 0.0) || args.getShadowChunks() >= 0 || args.getSequenceLevels() > 0
+            || options.steadyTolerance > 0.0 || options.semiImplicit || options.localTimeStepping)) {
+      Tools::Logger::logger.error(
+        "--parareal needs --end-time and does not support --shadow, --sequence, --steady-tol, --semi-implicit or --pseudo-time"
+      );
+    }
+    const unsigned int sequenceLevels = Simulation::getSequencingLevels(*scenario, args.getSize(), args.getSequenceLevels());
+    if (args.getSequenceLevels() > 0) {
+      if (!(options.steadyTolerance > 0.0) || args.getShadowChunks() >= 0) {
+        Tools::Logger::logger.error("--sequence needs --steady-tol and does not support --shadow");
+      }
+      if (sequenceLevels < args.getSequenceLevels()) {
+        Tools::Logger::logger.warning()
+          << "--sequence: " << sequenceLevels << " coarse grids, the size or the scenario does not allow more" << std::endl;
+      }
+    }
+
+    std::istringstream precisions(selection);
+    std::string        precision;
+    const bool         several = selection.find(',') != std::string::npos;
+    while (std::getline(precisions, precision, ',')) {
+      // One output series per policy if several are run
+      const std::string  basename = several ? "SWE1D_" + precision : "SWE1D";
+      Writers::VTKWriter vtkWriter(basename, scenario->getCellSize());
+      if (options.localTimeStepping) {
+        vtkWriter.comment("time is pseudo-time: local time steps per cell, not time accurate");
+      }
+      std::ofstream      residualHistory;
+      if (options.steadyTolerance > 0.0) {
+        residualHistory.open(basename + "_residual.txt");
+        options.residualHistory = &residualHistory;
+      }
+
+      const bool known = Simulation::visitPrecision(precision, [&](auto policy) {
+        using Policy = decltype(policy);
+        Tools::Logger::logger
+          << "Running " << Policy::name << (Policy::primed ? " (primed)" : "") << " with "
+          << (options.semiImplicit ? std::string("semi-implicit gravity") : solverSpec.name)
+          << (options.localTimeStepping ? " in pseudo-time" : "") << std::endl;
+
+        const auto runWith = [&](const auto& solver) {
+          using Solver = std::remove_cvref_t<decltype(solver)>;
+          if (parareal.slices > 0) {
+            std::vector<Simulation::PararealIteration> iterations;
+            const Simulation::Result                   result = Simulation::runParareal<Policy, Solver>(
+              *scenario, args.getSize(), args.getEndTime(), parareal, &vtkWriter, solver, options, &iterations
+            );
+            double criticalPath = 0.0;
+            for (unsigned int k = 0; k < iterations.size(); k++) {
+              const Simulation::PararealIteration& iteration = iterations[k];
+              criticalPath += iteration.sliceSeconds + iteration.coarseSeconds;
+              Tools::Logger::logger
+                << precision << ", parareal iteration " << k + 1 << ": change=" << iteration.change << ", fine="
+                << iteration.fineSeconds << "s on " << iteration.fineSlices << " slices (longest " << iteration.sliceSeconds
+                << "s), coarse=" << iteration.coarseSeconds << "s" << std::endl;
+            }
+            Tools::Logger::logger
+              << precision << ", parareal: " << result.steps << " fine steps, " << criticalPath
+              << "s with one core per slice" << std::endl;
+            return result;
+          }
+          if (sequenceLevels > 0) {
+            std::vector<Simulation::SequencingStage> stages;
+            const Simulation::Result                 result = Simulation::runSequenced<Policy, Solver>(
+              *scenario, args.getSize(), sequenceLevels, args.getTimeSteps(), &vtkWriter, solver, options, &stages
+            );
+            for (const Simulation::SequencingStage& stage : stages) {
+              Tools::Logger::logger
+                << precision << ", grid of " << stage.size << " cells: steps=" << stage.steps << ", duration=" << stage.seconds
+                << "s" << (stage.steady ? "" : ", not steady") << std::endl;
+            }
+            return result;
+          }
+          if (args.getShadowChunks() < 0) {
+            return Simulation::run<Policy, Solver>(*scenario, args.getSize(), args.getTimeSteps(), &vtkWriter, solver, options);
+          }
+
+          std::ofstream series(basename + "_shadow.txt");
+          const Simulation::Result result = Simulation::runShadowed<Policy, Solver>(
+            *scenario,
+            args.getSize(),
+            args.getTimeSteps(),
+            unsigned(args.getShadowChunks()),
+            args.getTolerance(),
+            series,
+            &vtkWriter,
+            solver,
+            options
+          );
+          Tools::Logger::logger
+            << precision << ", l1=" << result.divergence.l1 << "m, linf=" << result.divergence.linf
+            << "m, massError=" << result.divergence.massError << std::endl;
+          if (result.firstDivergenceStep > 0) {
+            Tools::Logger::logger
+              << precision << ", first divergence above " << args.getTolerance() << "m in step " << result.firstDivergenceStep
+              << " at cell " << result.firstDivergenceCell << std::endl;
+          }
+          return result;
+        };
+
+        // The solver type is fixed from here on: one block specialization per run
+        Simulation::Result result;
+        const bool         available = Simulation::visitSolver<Policy>(solverSpec, [&](const auto& solver) {
+          result = runWith(solver);
+          if constexpr (requires { std::remove_cvref_t<decltype(solver)>::batched; }) {
+            const double edges = double(result.cheapEdges + result.expensiveEdges);
+            Tools::Logger::logger
+              << precision << ", hybrid: rusanov=" << result.cheapEdges / edges << ", osher=" << result.expensiveEdges / edges
+              << " of " << result.cheapEdges + result.expensiveEdges << " edges" << std::endl;
+          }
+        });
+        if (!available) {
+          std::string message = "Unknown solver or solver parameter in '" + solverSpec.name + "'";
+          if (Policy::primed) {
+            message += " (--primed supports rusanov and hybrid only)";
+          }
+          Tools::Logger::logger.error(message);
+        }
+        if (options.memoize && parareal.slices == 0) {
+          Tools::Logger::logger
+            << precision << ", memoization: hitRate=" << double(result.memoHits) / double(std::max(result.memoEdges, 1ULL))
+            << " of " << result.memoEdges << " edges, "
+            << (result.memoOffStep > 0 ? "off after step " + std::to_string(result.memoOffStep) : std::string("on throughout"))
+            << std::endl;
+        }
+        if (parareal.slices == 0) {
+          Tools::Logger::logger
+            << precision << ", chunks: wet=" << result.wetChunks << ", dry=" << result.dryChunks << ", mixed=" << result.mixedChunks
+            << (options.linearThreshold > 0.0 ? ", linear=" + std::to_string(result.linearChunks) : std::string()) << std::endl;
+        }
+        if (options.steadyTolerance > 0.0) {
+          Tools::Logger::logger
+            << precision << ", "
+            << (result.steadyStep > 0 ? "steady after step " + std::to_string(result.steadyStep) : std::string("not steady"))
+            << ", residual: linfH=" << result.residual.linfH << "m/s, linfHu=" << result.residual.linfHu << "m^2/s^2"
+            << std::endl;
+        }
+        if (Policy::primed) {
+          Tools::Logger::logger
+            << precision << ", primed scales: depth=" << result.scaling.depth << "m, velocity=" << result.scaling.velocity
+            << "m/s, length=" << result.scaling.length << "m, time=" << result.scaling.time << "s" << std::endl;
+        }
+        if (result.overflow) {
+          Tools::Logger::logger.warning() << Policy::name << ": state left the fixed-point range" << std::endl;
+        }
+        Tools::Logger::logger << precision << ", duration=" << result.seconds << "s" << std::endl;
+      }, args.getPrimed());
+      if (!known) {
+        std::string message = "Unknown precision '" + precision + "'";
+        Tools::Logger::logger.error(message);
+      }
+    }
+
+    delete scenario;
+    return EXIT_SUCCESS;
   }
 
   // Allocate memory
@@ -71,3 +71,7 @@ RealType Scenarios::DamBreakScenario::getBathymetry(unsigned int pos) const {
   (void) pos;
   return -std::max(hL_, hR_);
 }
+
+std::unique_ptr<Scenarios::Scenario> Scenarios::DamBreakScenario::atResolution(unsigned int size) const {
+  return std::make_unique<DamBreakScenario>(width_, size, hL_, hR_, uR_);
+}
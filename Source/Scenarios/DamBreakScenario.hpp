@@ -84,6 +84,11 @@ DamBreakScenario(RealType width, unsigned int size, RealType hL, RealType hR, Re
      * @return Bathymetry (b) at position pos
      */
     RealType getBathymetry(unsigned int pos) const override;
+
+    /**
+     * @return The scenario on size cells
+     */
+    std::unique_ptr<Scenario> atResolution(unsigned int size) const override;
   };
 
 } // namespace Scenarios
@@ -0,0 +1,51 @@
+/**
+ * @file OceanShelfScenario.cpp
+ */
+
+#include "OceanShelfScenario.hpp"
+
+#include <cmath>
+
+namespace {
+  constexpr double Width      = 400000.0;
+  constexpr double OceanDepth = 4000.0;
+  constexpr double ShelfDepth = 50.0;
+  constexpr double SlopeStart = 300000.0;
+  constexpr double SlopeEnd   = 380000.0;
+  constexpr double HumpCenter = 50000.0;
+  constexpr double HumpWidth  = 10000.0;
+} // namespace
+
+Scenarios::OceanShelfScenario::OceanShelfScenario(unsigned int size, RealType amplitude):
+  size_(size),
+  amplitude_(amplitude) {}
+
+RealType Scenarios::OceanShelfScenario::getCellSize() const { return RealType(Width / size_); }
+
+double Scenarios::OceanShelfScenario::getElevation(unsigned int pos) const {
+  const double x = (pos - 0.5) * Width / size_;
+  return amplitude_ * std::exp(-(x - HumpCenter) * (x - HumpCenter) / (HumpWidth * HumpWidth));
+}
+
+RealType Scenarios::OceanShelfScenario::getHeight(unsigned int pos) const {
+  return RealType(getElevation(pos) - getBathymetry(pos));
+}
+
+RealType Scenarios::OceanShelfScenario::getMomentum(unsigned int pos) const {
+  return RealType(getElevation(pos) * std::sqrt(9.81 * -getBathymetry(pos)));
+}
+
+RealType Scenarios::OceanShelfScenario::getBathymetry(unsigned int pos) const {
+  const double x = (pos - 0.5) * Width / size_;
+  if (x <= SlopeStart) {
+    return RealType(-OceanDepth);
+  }
+  if (x >= SlopeEnd) {
+    return RealType(-ShelfDepth);
+  }
+  return RealType(-OceanDepth + (OceanDepth - ShelfDepth) * (x - SlopeStart) / (SlopeEnd - SlopeStart));
+}
+
+std::unique_ptr<Scenarios::Scenario> Scenarios::OceanShelfScenario::atResolution(unsigned int size) const {
+  return std::make_unique<OceanShelfScenario>(size, amplitude_);
+}
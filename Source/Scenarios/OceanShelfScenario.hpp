@@ -0,0 +1,59 @@
+/**
+ * @file OceanShelfScenario.hpp
+ *
+ * Long-distance propagation: a small right-going hump crosses 300 km of
+ * 4000 m deep ocean and runs up a slope onto a 50 m shelf, where its
+ * amplitude-to-depth ratio grows by two orders of magnitude.
+ */
+
+#pragma once
+
+#include "Scenario.hpp"
+
+namespace Scenarios {
+
+  class OceanShelfScenario: public Scenario {
+    /** Number of cells */
+    const unsigned int size_;
+    /** Amplitude of the hump in m */
+    const RealType amplitude_;
+
+  public:
+    /**
+     * @param size Number of cells on the 400 km domain
+     * @param amplitude Amplitude of the hump in m
+     */
+    OceanShelfScenario(unsigned int size, RealType amplitude = 1.0);
+    ~OceanShelfScenario() override = default;
+
+    /**
+     * @return Cell size of one cell (= domain size/number of cells)
+     */
+    RealType getCellSize() const override;
+
+    /**
+     * @return Initial water height at pos
+     */
+    RealType getHeight(unsigned int pos) const override;
+
+    /**
+     * @return Initial momentum of water (hu) at position pos: c times the surface elevation, i.e. right-going
+     */
+    RealType getMomentum(unsigned int pos) const override;
+
+    /**
+     * @return Bathymetry (b) at position pos
+     */
+    RealType getBathymetry(unsigned int pos) const override;
+
+    /**
+     * @return The scenario on size cells
+     */
+    std::unique_ptr<Scenario> atResolution(unsigned int size) const override;
+
+  private:
+    /** @return Surface elevation of the hump at pos */
+    double getElevation(unsigned int pos) const;
+  };
+
+} // namespace Scenarios
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "Tools/RealType.hpp"
 
 namespace Scenarios {
@@ -41,6 +43,17 @@ namespace Scenarios {
       (void) pos;
       return 0.0;
     };
+
+    /**
+     * The same scenario evaluated on another number of cells, e.g. for the
+     * coarse grids of Simulation::runSequenced
+     *
+     * @return The scenario on size cells, nullptr if it is tied to its resolution
+     */
+    virtual std::unique_ptr<Scenario> atResolution(unsigned int size) const {
+      (void) size;
+      return nullptr;
+    }
   };
 
 } // namespace Scenarios
\ No newline at end of file
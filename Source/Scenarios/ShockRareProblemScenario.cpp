@@ -38,3 +38,6 @@ RealType Scenarios::ShockRareProblemScenario::getBathymetry(unsigned int pos) co
   return -h_;
 }
 
+std::unique_ptr<Scenarios::Scenario> Scenarios::ShockRareProblemScenario::atResolution(unsigned int size) const {
+  return std::make_unique<ShockRareProblemScenario>(width_, size, pos_of_problem_ * size / size_, h_, huL_);
+}
@@ -50,6 +50,11 @@ ShockRareProblemScenario(RealType width, unsigned int size, unsigned int pos_of_
      * @return Bathymetry (b) at position pos
      */
     RealType getBathymetry(unsigned int pos) const override;
+
+    /**
+     * @return The scenario on size cells, with the position of the problem scaled along
+     */
+    std::unique_ptr<Scenario> atResolution(unsigned int size) const override;
   };
 
 } // namespace Scenarios
@@ -23,14 +23,14 @@ RealType Scenarios::SubcriticalFlowScenario::getMomentum(unsigned int pos) const
 }
 
 RealType Scenarios::SubcriticalFlowScenario::getBathymetry(unsigned int pos) const {
-  if (pos <= size_ * 8 / 25 || pos >= size_ * 12 / 25) { 
+  // Bump on 8 m < x < 12 by position, so that every resolution samples the same profile
+  const double x = RealType(pos) / size_ * 25.0;
+  if (x <= 8.0 || x >= 12.0) {
     return -2;
   }
-
-  //erstmal Zwischenschritte berechnen, da es davor zu Fehlern kam
-  // können wir noch zusammensetzen 
-  double p = (RealType(pos) / size_ * 25.0 - 10.0) * (RealType(pos) / size_ * 25.0 - 10.0);
-  double p_ = (0.05 * p);
-  return -1.8 - p_;
+  return -1.8 - 0.05 * (x - 10.0) * (x - 10.0);
 }
 
+std::unique_ptr<Scenarios::Scenario> Scenarios::SubcriticalFlowScenario::atResolution(unsigned int size) const {
+  return std::make_unique<SubcriticalFlowScenario>(size);
+}
@@ -46,6 +46,11 @@ namespace Scenarios {
      */
     RealType getBathymetry(unsigned int pos) const override;
 
+    /**
+     * @return The scenario on size cells
+     */
+    std::unique_ptr<Scenario> atResolution(unsigned int size) const override;
+
   };
 
   
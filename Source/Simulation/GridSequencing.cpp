@@ -0,0 +1,60 @@
+/**
+ * @file GridSequencing.cpp
+ */
+
+#include "GridSequencing.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+  /** @return The smaller slope if both have the same sign, else 0 */
+  double minmod(double left, double right) {
+    if (left * right <= 0.0) {
+      return 0.0;
+    }
+    return left > 0.0 ? std::min(left, right) : std::max(left, right);
+  }
+
+} // namespace
+
+Simulation::GridState::GridState(std::vector<RealType> h, std::vector<RealType> hu, std::vector<RealType> b, RealType cellSize):
+  h_(std::move(h)),
+  hu_(std::move(hu)),
+  b_(std::move(b)),
+  cellSize_(cellSize) {}
+
+void Simulation::prolong(
+  const RealType* h, const RealType* hu, const RealType* b, unsigned int size, const RealType* fineB, RealType* fineH, RealType* fineHu
+) {
+  for (unsigned int j = 1; j <= size; j++) {
+    const double eta      = double(h[j]) + double(b[j]);
+    const double etaSlope = minmod(eta - double(h[j - 1]) - double(b[j - 1]), double(h[j + 1]) + double(b[j + 1]) - eta);
+    const double huSlope  = minmod(double(hu[j]) - double(hu[j - 1]), double(hu[j + 1]) - double(hu[j]));
+
+    // The fine cells keep the surface of the coarse cell up to the slope, the mean fine bathymetry shifts it
+    const unsigned int left      = 2 * j - 1;
+    const double       meanB     = 0.5 * (double(fineB[left]) + double(fineB[left + 1]));
+    const double       hLeft     = double(h[j]) - 0.25 * etaSlope + meanB - double(fineB[left]);
+    const double       hRight    = double(h[j]) + 0.25 * etaSlope + meanB - double(fineB[left + 1]);
+    const bool         piecewise = hLeft < 0.0 || hRight < 0.0;
+
+    fineH[left]      = piecewise ? h[j] : RealType(hLeft);
+    fineH[left + 1]  = piecewise ? h[j] : RealType(hRight);
+    fineHu[left]     = piecewise ? hu[j] : RealType(double(hu[j]) - 0.25 * huSlope);
+    fineHu[left + 1] = piecewise ? hu[j] : RealType(double(hu[j]) + 0.25 * huSlope);
+  }
+
+  fineH[0]             = fineH[1];
+  fineHu[0]            = fineHu[1];
+  fineH[2 * size + 1]  = fineH[2 * size];
+  fineHu[2 * size + 1] = fineHu[2 * size];
+}
+
+unsigned int Simulation::getSequencingLevels(const Scenarios::Scenario& scenario, unsigned int size, unsigned int levels) {
+  while (levels > 0 && (size % (1u << levels) != 0 || !scenario.atResolution(size >> levels))) {
+    levels--;
+  }
+  return levels;
+}
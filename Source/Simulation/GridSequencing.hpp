@@ -0,0 +1,143 @@
+/**
+ * @file GridSequencing.hpp
+ *
+ * Grid sequencing for steady flows (--sequence): the run starts on a coarse
+ * grid, each converged grid is prolonged to the next finer one, so the
+ * finest grid starts from an almost converged state.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "Scenarios/Scenario.hpp"
+#include "Simulation/Simulation.hpp"
+#include "Solver/RusanovMixed.hpp"
+#include "Tools/RealType.hpp"
+
+namespace Simulation {
+
+  /**
+   * Statistics of one grid of runSequenced()
+   */
+  struct SequencingStage {
+    /** Number of cells */
+    unsigned int size = 0;
+    /** Time steps taken on the grid */
+    unsigned int steps = 0;
+    /** Wall clock time of the time loop in seconds */
+    double seconds = 0.0;
+    /** The grid reached RunOptions::steadyTolerance */
+    bool steady = false;
+  };
+
+  /**
+   * Given cells as a scenario: the initial values of a grid of runSequenced()
+   */
+  class GridState: public Scenarios::Scenario {
+    std::vector<RealType> h_;
+    std::vector<RealType> hu_;
+    std::vector<RealType> b_;
+    RealType              cellSize_;
+
+  public:
+    /**
+     * @param h, hu, b Cells on [0,..,n+1]
+     */
+    GridState(std::vector<RealType> h, std::vector<RealType> hu, std::vector<RealType> b, RealType cellSize);
+    ~GridState() override = default;
+
+    RealType getCellSize() const override { return cellSize_; }
+    RealType getHeight(unsigned int pos) const override { return h_[pos]; }
+    RealType getMomentum(unsigned int pos) const override { return hu_[pos]; }
+    RealType getBathymetry(unsigned int pos) const override { return b_[pos]; }
+  };
+
+  /**
+   * Conservative prolongation of the cells [1,..,size] to the 2 size cells
+   * of the next finer grid, coarse cell j to the fine cells 2j-1 and 2j:
+   * the surface h + b and hu are reconstructed linearly with minmod-limited
+   * slopes, and h follows the fine bathymetry such that the two fine cells
+   * hold the mass and momentum of the coarse cell. Where a fine h would
+   * become negative, both fine cells take h and hu of the coarse cell. The
+   * fine ghost cells copy their neighbours.
+   *
+   * @param h, hu, b Coarse cells on [0,..,size+1]
+   * @param fineB Fine bathymetry on [0,..,2 size+1]
+   * @param fineH, fineHu Receive the fine cells on [0,..,2 size+1]
+   */
+  void prolong(
+    const RealType* h, const RealType* hu, const RealType* b, unsigned int size, const RealType* fineB, RealType* fineH, RealType* fineHu
+  );
+
+  /**
+   * Number of coarse grids runSequenced() uses: levels, or fewer if size is
+   * not divisible by 2^levels; 0 if the scenario has no other resolution
+   */
+  unsigned int getSequencingLevels(const Scenarios::Scenario& scenario, unsigned int size, unsigned int levels);
+
+  /**
+   * Runs the scenario with run() on grids of size / 2^levels, ..., size / 2
+   * and size cells. Every grid runs until it is steady (see
+   * RunOptions::steadyTolerance) or for timeSteps steps, then it is
+   * prolonged to the next grid. The bathymetry of every grid comes from
+   * Scenario::atResolution.
+   *
+   * @param levels Number of coarse grids, e.g. 3 for size / 8 (see getSequencingLevels)
+   * @param writer Receives the finest grid only, may be nullptr
+   * @param stages Receives the statistics per grid, coarsest first, may be nullptr
+   * @return The result of the finest grid; seconds is the wall clock time of all grids
+   */
+  template <class Policy, class Solver = Solvers::RusanovMixed<Policy>>
+  Result runSequenced(
+    const Scenarios::Scenario&    scenario,
+    unsigned int                  size,
+    unsigned int                  levels,
+    unsigned int                  timeSteps,
+    Writers::VTKWriter*           writer  = nullptr,
+    const Solver&                 solver  = Solver(),
+    const RunOptions&             options = RunOptions(),
+    std::vector<SequencingStage>* stages  = nullptr
+  ) {
+    levels = getSequencingLevels(scenario, size, levels);
+
+    const auto start = std::chrono::steady_clock::now();
+    Result     result;
+    for (unsigned int level = levels + 1; level-- > 0;) {
+      const unsigned int                   gridSize = size >> level;
+      std::unique_ptr<Scenarios::Scenario> resampled;
+      const Scenarios::Scenario*           grid = &scenario;
+      if (level > 0) {
+        resampled = scenario.atResolution(gridSize);
+        grid      = resampled.get();
+      }
+
+      // The converged coarser grid as initial values
+      std::unique_ptr<GridState> initial;
+      if (level < levels) {
+        std::vector<RealType> b(gridSize + 2), h(gridSize + 2), hu(gridSize + 2);
+        for (unsigned int i = 0; i < gridSize + 2; i++) {
+          b[i] = grid->getBathymetry(i);
+        }
+        prolong(result.h.data(), result.hu.data(), result.b.data(), gridSize / 2, b.data(), h.data(), hu.data());
+        initial = std::make_unique<GridState>(std::move(h), std::move(hu), std::move(b), grid->getCellSize());
+        grid    = initial.get();
+      }
+
+      if (options.residualHistory) {
+        *options.residualHistory << "# grid of " << gridSize << " cells" << std::endl;
+      }
+      result = run<Policy, Solver>(*grid, gridSize, timeSteps, level == 0 ? writer : nullptr, solver, options);
+      if (stages) {
+        stages->push_back({gridSize, result.steps, result.seconds, result.steadyStep > 0});
+      }
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+  }
+
+} // namespace Simulation
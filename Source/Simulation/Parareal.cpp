@@ -0,0 +1,43 @@
+/**
+ * @file Parareal.cpp
+ */
+
+#include "Parareal.hpp"
+
+#include <ctime>
+
+void Simulation::restrictCells(
+  const RealType* h,
+  const RealType* hu,
+  const RealType* b,
+  unsigned int    size,
+  RealType*       coarseH,
+  RealType*       coarseHu,
+  RealType*       coarseB
+) {
+  for (unsigned int j = 1; j <= size; j++) {
+    coarseH[j]  = RealType(0.5) * (h[2 * j - 1] + h[2 * j]);
+    coarseHu[j] = RealType(0.5) * (hu[2 * j - 1] + hu[2 * j]);
+    coarseB[j]  = RealType(0.5) * (b[2 * j - 1] + b[2 * j]);
+  }
+
+  coarseH[0]         = coarseH[1];
+  coarseHu[0]        = coarseHu[1];
+  coarseB[0]         = coarseB[1];
+  coarseH[size + 1]  = coarseH[size];
+  coarseHu[size + 1] = coarseHu[size];
+  coarseB[size + 1]  = coarseB[size];
+}
+
+unsigned int Simulation::getPararealLevels(unsigned int size, unsigned int levels) {
+  while (levels > 0 && size % (1u << levels) != 0) {
+    levels--;
+  }
+  return levels;
+}
+
+double Simulation::getThreadSeconds() {
+  timespec now;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+  return double(now.tv_sec) + 1e-9 * double(now.tv_nsec);
+}
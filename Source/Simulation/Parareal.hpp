@@ -0,0 +1,340 @@
+/**
+ * @file Parareal.hpp
+ *
+ * Parareal, parallel in time (--parareal): the time window is cut into
+ * slices, a cheap coarse propagator sweeps them serially, and the fine
+ * propagator runs on all slices concurrently, one thread per slice. Every
+ * iteration corrects the slice ends with the difference of fine and coarse
+ * propagator; after k iterations the first k slices equal serial time
+ * stepping.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "Blocks/WavePropagationBlockMixed.hpp"
+#include "Simulation/GridSequencing.hpp"
+#include "Simulation/Simulation.hpp"
+#include "Solver/RusanovMixed.hpp"
+#include "Tools/RealType.hpp"
+#include "Writers/VTKWriter.hpp"
+
+namespace Simulation {
+
+  /**
+   * Cells on [0,..,size+1] in physical variables
+   */
+  struct CellState {
+    std::vector<RealType> h;
+    std::vector<RealType> hu;
+  };
+
+  /**
+   * Parameters of runParareal()
+   */
+  struct PararealOptions {
+    /** Number of time slices */
+    unsigned int slices = 8;
+    /** Worker threads of the fine propagators, 0 for one per slice */
+    unsigned int threads = 0;
+    /** The coarse propagator runs on size / 2^levels cells (see getPararealLevels) */
+    unsigned int levels = 2;
+    /** Iterations stop once no slice end moves by more than this in h (m) and hu (m^2/s); 0 to iterate until exact */
+    double tolerance = 1e-6;
+  };
+
+  /**
+   * Statistics of one iteration of runParareal()
+   */
+  struct PararealIteration {
+    /** Largest change of h or hu at a slice end */
+    double change = 0.0;
+    /** Wall clock time of the concurrent fine propagators */
+    double fineSeconds = 0.0;
+    /** CPU time of the longest fine slice: the fine time with one core per slice */
+    double sliceSeconds = 0.0;
+    /** Wall clock time of the serial coarse sweep and correction, in the first iteration also of the initial coarse sweep */
+    double coarseSeconds = 0.0;
+    /** Slices the fine propagator ran on */
+    unsigned int fineSlices = 0;
+  };
+
+  /**
+   * Averages pairs of cells [1,..,2 size] to the cells [1,..,size] of the
+   * next coarser grid, conserving mass and momentum; a lake at rest stays
+   * at rest. The coarse ghost cells copy their neighbours.
+   *
+   * @param h, hu, b Fine cells on [0,..,2 size+1]
+   * @param coarseH, coarseHu, coarseB Receive the coarse cells on [0,..,size+1]
+   */
+  void restrictCells(
+    const RealType* h,
+    const RealType* hu,
+    const RealType* b,
+    unsigned int    size,
+    RealType*       coarseH,
+    RealType*       coarseHu,
+    RealType*       coarseB
+  );
+
+  /**
+   * Number of coarse grids the coarse propagator can use: levels, or fewer
+   * if size is not divisible by 2^levels
+   */
+  unsigned int getPararealLevels(unsigned int size, unsigned int levels);
+
+  /** CPU time of the calling thread in s, unaffected by other threads sharing its core */
+  double getThreadSeconds();
+
+  /**
+   * Advances cells by duration: steps of the maximum stable dt, the last
+   * one shortened to end exactly at duration. Primed policies run in the
+   * variables of scaling.
+   *
+   * @param state Cells on [0,..,size+1], updated in place
+   * @param b Bathymetry on [0,..,size+1]
+   * @param cellSize In m
+   * @param duration In s
+   * @param overflow Set to true if the state left the fixed-point range (see Blocks::StateStorage), may be nullptr
+   * @return Number of time steps
+   */
+  template <class Policy, class Solver = Solvers::RusanovMixed<Policy>>
+  unsigned int propagate(
+    CellState&                   state,
+    const std::vector<RealType>& b,
+    double                       cellSize,
+    double                       duration,
+    const Scaling&               scaling = Scaling(),
+    const Solver&                solver  = Solver(),
+    const RunOptions&            options  = RunOptions(),
+    bool*                        overflow = nullptr
+  ) {
+    using Work              = typename Policy::Work;
+    const unsigned int size = static_cast<unsigned int>(b.size()) - 2;
+
+    std::vector<RealType> bScaled(b);
+    if (Policy::primed) {
+      scaling.toPrimed(state.h.data(), state.hu.data(), bScaled.data(), size + 2);
+    }
+    Blocks::WavePropagationBlockMixed<Policy, Solver> block(
+      state.h.data(), state.hu.data(), bScaled.data(), size, RealType(cellSize / scaling.length)
+    );
+    block.getSolver() = solver;
+    block.setMemoization(options.memoize);
+    block.setLinearRegion(Work(options.linearThreshold));
+
+    const double end   = duration / scaling.time;
+    double       time  = 0.0;
+    unsigned int steps = 0;
+    while (time < end) {
+      block.applyBoundaryConditions();
+      double     dt   = double(block.computeNumericalFluxes());
+      const bool last = !(time + dt < end);
+      if (last) {
+        dt = end - time;
+      }
+      block.updateUnknowns(Work(dt));
+      time = last ? end : time + dt;
+      steps++;
+    }
+
+    block.getState(state.h.data(), state.hu.data(), bScaled.data());
+    if (overflow && block.hasOverflowed()) {
+      *overflow = true;
+    }
+    if (Policy::primed) {
+      scaling.fromPrimed(state.h.data(), state.hu.data(), bScaled.data(), size + 2);
+    }
+    return steps;
+  }
+
+  /**
+   * Runs the scenario from time 0 to endTime with parareal. The fine
+   * propagator is propagate() with the block of Policy and Solver on size
+   * cells; the coarse propagator restricts the cells levels times (see
+   * restrictCells), runs propagate() with the Rusanov solver of Policy,
+   * and prolongs the result back (see prolong). Negative depths of the
+   * corrected slice ends are cut to a dry cell.
+   *
+   * @param writer Receives the initial state and the converged slice ends, may be nullptr
+   * @param options memoize and linearThreshold apply to the fine propagator
+   * @param iterations Receives the statistics per iteration, may be nullptr
+   * @return h, hu, b after endTime; steps are the fine steps of the converged slices, seconds the wall clock time of all iterations,
+   *   overflow whether any fine or coarse propagation left the fixed-point range
+   */
+  template <class Policy, class Solver = Solvers::RusanovMixed<Policy>>
+  Result runParareal(
+    const Scenarios::Scenario&      scenario,
+    unsigned int                    size,
+    double                          endTime,
+    const PararealOptions&          parareal,
+    Writers::VTKWriter*             writer     = nullptr,
+    const Solver&                   solver     = Solver(),
+    const RunOptions&               options    = RunOptions(),
+    std::vector<PararealIteration>* iterations = nullptr
+  ) {
+    using Clock                 = std::chrono::steady_clock;
+    const unsigned int slices   = std::max(parareal.slices, 1u);
+    const unsigned int threads  = parareal.threads > 0 ? parareal.threads : slices;
+    const unsigned int levels   = getPararealLevels(size, parareal.levels);
+    const double       duration = endTime / slices;
+    const double       cellSize = scenario.getCellSize();
+
+    Result result;
+    result.h.resize(size + 2);
+    result.hu.resize(size + 2);
+    result.b.resize(size + 2);
+    for (unsigned int i = 0; i < size + 2; i++) {
+      result.h[i]  = scenario.getHeight(i);
+      result.hu[i] = scenario.getMomentum(i);
+      result.b[i]  = scenario.getBathymetry(i);
+    }
+    if (Policy::primed) {
+      result.scaling = Scaling(result.h.data(), size + 2, Precision::Double::G, cellSize);
+    }
+    if (writer) {
+      writer->write(RealType(0.0), result.h.data(), result.hu.data(), result.b.data(), size);
+    }
+
+    // Bathymetry of the grids, finest first
+    std::vector<std::vector<RealType>> bathymetry(levels + 1, result.b);
+    for (unsigned int level = 1; level <= levels; level++) {
+      bathymetry[level].resize((size >> level) + 2);
+    }
+
+    // Restricts to the coarsest grid, propagates there and prolongs back
+    const auto coarsePropagate = [&](const CellState& fine) {
+      std::vector<CellState> grids(levels + 1);
+      grids[0] = fine;
+      for (unsigned int level = 1; level <= levels; level++) {
+        const unsigned int coarseSize = size >> level;
+        grids[level].h.resize(coarseSize + 2);
+        grids[level].hu.resize(coarseSize + 2);
+        restrictCells(
+          grids[level - 1].h.data(),
+          grids[level - 1].hu.data(),
+          bathymetry[level - 1].data(),
+          coarseSize,
+          grids[level].h.data(),
+          grids[level].hu.data(),
+          bathymetry[level].data()
+        );
+      }
+      propagate<Policy>(
+        grids[levels],
+        bathymetry[levels],
+        cellSize * double(1u << levels),
+        duration,
+        result.scaling,
+        Solvers::RusanovMixed<Policy>(),
+        RunOptions(),
+        &result.overflow
+      );
+      for (unsigned int level = levels; level > 0; level--) {
+        prolong(
+          grids[level].h.data(),
+          grids[level].hu.data(),
+          bathymetry[level].data(),
+          size >> level,
+          bathymetry[level - 1].data(),
+          grids[level - 1].h.data(),
+          grids[level - 1].hu.data()
+        );
+      }
+      return grids[0];
+    };
+
+    const auto start = Clock::now();
+
+    // Slice ends of the current iterate, coarse propagations of the previous one
+    std::vector<CellState>    ends(slices + 1), coarse(slices), fine(slices);
+    std::vector<unsigned int> fineSteps(slices, 0);
+    std::vector<double>       fineSeconds(slices, 0.0);
+    // Per slice, not std::vector<bool>: the workers write concurrently
+    std::vector<char> fineOverflow(slices, false);
+    ends[0] = {result.h, result.hu};
+    for (unsigned int n = 0; n < slices; n++) {
+      coarse[n]   = coarsePropagate(ends[n]);
+      ends[n + 1] = coarse[n];
+    }
+    double sweepSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    for (unsigned int k = 0; k < slices; k++) {
+      PararealIteration iteration;
+      iteration.fineSlices = slices - k;
+
+      // Slices before k have converged: their start did not change
+      const auto fineStart = Clock::now();
+      {
+        std::vector<std::thread> workers;
+        for (unsigned int t = 0; t < std::min(threads, slices - k); t++) {
+          workers.emplace_back([&, t] {
+            for (unsigned int n = k + t; n < slices; n += threads) {
+              const double sliceStart = getThreadSeconds();
+              bool         overflow   = false;
+              fine[n]                 = ends[n];
+              fineSteps[n]    = propagate<Policy, Solver>(fine[n], result.b, cellSize, duration, result.scaling, solver, options, &overflow);
+              fineSeconds[n]  = getThreadSeconds() - sliceStart;
+              fineOverflow[n] = fineOverflow[n] || overflow;
+            }
+          });
+        }
+        for (std::thread& worker : workers) {
+          worker.join();
+        }
+      }
+      const auto coarseStart = Clock::now();
+      iteration.fineSeconds  = std::chrono::duration<double>(coarseStart - fineStart).count();
+      iteration.sliceSeconds = *std::max_element(fineSeconds.begin() + k, fineSeconds.end());
+
+      // Serial correction: new coarse + fine - old coarse; slice k started from its converged state and takes fine as is
+      for (unsigned int n = k; n < slices; n++) {
+        CellState update = n == k ? coarse[n] : coarsePropagate(ends[n]);
+        for (unsigned int i = 0; i < size + 2; i++) {
+          RealType h  = n == k ? fine[n].h[i] : update.h[i] + fine[n].h[i] - coarse[n].h[i];
+          RealType hu = n == k ? fine[n].hu[i] : update.hu[i] + fine[n].hu[i] - coarse[n].hu[i];
+          if (h < RealType(0.0)) {
+            h  = RealType(0.0);
+            hu = RealType(0.0);
+          }
+          iteration.change = std::max(
+            {iteration.change, std::abs(double(h) - double(ends[n + 1].h[i])), std::abs(double(hu) - double(ends[n + 1].hu[i]))}
+          );
+          ends[n + 1].h[i]  = h;
+          ends[n + 1].hu[i] = hu;
+        }
+        coarse[n] = std::move(update);
+      }
+      iteration.coarseSeconds = std::chrono::duration<double>(Clock::now() - coarseStart).count() + sweepSeconds;
+      sweepSeconds            = 0.0;
+
+      if (iterations) {
+        iterations->push_back(iteration);
+      }
+      if (iteration.change <= parareal.tolerance) {
+        break;
+      }
+    }
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    if (writer) {
+      for (unsigned int n = 1; n <= slices; n++) {
+        writer->write(RealType(n * duration), ends[n].h.data(), ends[n].hu.data(), result.b.data(), size);
+      }
+    }
+    result.h    = ends[slices].h;
+    result.hu   = ends[slices].hu;
+    result.time = endTime;
+    for (const unsigned int steps : fineSteps) {
+      result.steps += steps;
+    }
+    result.overflow = result.overflow || std::find(fineOverflow.begin(), fineOverflow.end(), char(true)) != fineOverflow.end();
+    return result;
+  }
+
+} // namespace Simulation
@@ -0,0 +1,126 @@
+/**
+ * @file PrecisionTuner.cpp
+ */
+
+#include "PrecisionTuner.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+#include "Blocks/WavePropagationBlockMixed.hpp"
+#include "Shadow.hpp"
+#include "Simulation.hpp"
+
+namespace {
+
+  template <class Policy, class Solver>
+  Simulation::Calibration calibrate(
+    const std::vector<RealType>& h0,
+    const std::vector<RealType>& hu0,
+    const std::vector<RealType>& b0,
+    unsigned int                 size,
+    RealType                     cellSize,
+    unsigned int                 timeSteps,
+    unsigned int                 steps,
+    const Solver&                solver
+  ) {
+    using Reference = std::conditional_t<Policy::primed, Precision::Primed<Precision::Double>, Precision::Double>;
+
+    Blocks::WavePropagationBlockMixed<Policy, Solver> block(h0.data(), hu0.data(), b0.data(), size, cellSize);
+    block.getSolver() = solver;
+    Simulation::SampledShadow<Reference, Simulation::RebindSolver<Solver, Reference>> shadow(
+      h0.data(), hu0.data(), b0.data(), size, cellSize, Simulation::CalibrationChunks, steps, Simulation::toReferenceSolver<Reference>(solver)
+    );
+
+    Simulation::Calibration calibration;
+    calibration.bytesPerCell = Blocks::StateStorage<Policy>::bytesPerCell;
+
+    // Error samples at a quarter, half, three quarters and the end of the window
+    double sumStepError = 0.0, sumStepSquare = 0.0;
+    for (unsigned int step = 1; step <= steps; step++) {
+      block.applyBoundaryConditions();
+      const auto dt = block.computeNumericalFluxes();
+      block.updateUnknowns(dt);
+      shadow.step(double(dt));
+
+      if (step == steps / 4 || step == steps / 2 || step == 3 * steps / 4 || step == steps) {
+        calibration.error = shadow.compare(block).linf;
+        sumStepError += step * calibration.error;
+        sumStepSquare += double(step) * step;
+      }
+    }
+
+    calibration.growthRate     = sumStepError / sumStepSquare;
+    calibration.projectedError = std::max(calibration.error, calibration.growthRate * timeSteps);
+    calibration.overflow       = block.hasOverflowed();
+    return calibration;
+  }
+
+} // namespace
+
+Simulation::Tuning Simulation::tunePrecision(
+  const Scenarios::Scenario& scenario,
+  unsigned int               size,
+  unsigned int               timeSteps,
+  double                     tolerance,
+  const SolverSpec&          solver,
+  bool                       primed
+) {
+  std::vector<RealType> h(size + 2), hu(size + 2), b(size + 2);
+  for (unsigned int i = 0; i < size + 2; i++) {
+    h[i]  = scenario.getHeight(i);
+    hu[i] = scenario.getMomentum(i);
+    b[i]  = scenario.getBathymetry(i);
+  }
+
+  // Primed policies calibrate in nondimensional variables like Simulation::run(), the errors are scaled back
+  Scaling scaling;
+  if (primed) {
+    scaling = Scaling(h.data(), size + 2, Precision::Double::G, scenario.getCellSize());
+    scaling.toPrimed(h.data(), hu.data(), b.data(), size + 2);
+  }
+  const RealType cellSize = RealType(scenario.getCellSize() / scaling.length);
+
+  const unsigned int steps = std::max(1u, std::min(CalibrationSteps, timeSteps));
+
+  Tuning tuning;
+  tuning.precision    = "double";
+  tuning.sampledCells = SampledShadow<>(h.data(), hu.data(), b.data(), size, cellSize, CalibrationChunks, 0).getSampledCells();
+
+  double bestBytesPerCell = Blocks::StateStorage<Precision::Double>::bytesPerCell;
+  for (const std::string& name : getPrecisionNames()) {
+    if (name == "double") {
+      continue;
+    }
+
+    Calibration calibration;
+    bool        available = false;
+    visitPrecision(
+      name,
+      [&](auto policy) {
+        using Policy = decltype(policy);
+        available    = visitSolver<Policy>(solver, [&](const auto& configured) {
+          calibration = calibrate<Policy>(h, hu, b, size, cellSize, timeSteps, steps, configured);
+        });
+      },
+      primed
+    );
+    if (!available) {
+      continue;
+    }
+    calibration.name = name;
+    calibration.error *= scaling.depth;
+    calibration.growthRate *= scaling.depth;
+    calibration.projectedError *= scaling.depth;
+    calibration.accepted = !calibration.overflow && calibration.projectedError <= tolerance;
+
+    if (calibration.accepted && calibration.bytesPerCell < bestBytesPerCell) {
+      bestBytesPerCell = calibration.bytesPerCell;
+      tuning.precision = name;
+    }
+    tuning.candidates.push_back(calibration);
+  }
+
+  return tuning;
+}
@@ -0,0 +1,73 @@
+/**
+ * @file PrecisionTuner.hpp
+ *
+ * Picks the cheapest precision policy that is projected to stay within an
+ * error budget (--precision=auto --tolerance=...).
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Scenarios/Scenario.hpp"
+#include "Simulation/SolverRegistry.hpp"
+
+namespace Simulation {
+
+  /** Length of the calibration window in time steps */
+  constexpr unsigned int CalibrationSteps = 32;
+  /** Chunks followed by the double shadow during calibration */
+  constexpr unsigned int CalibrationChunks = 8;
+
+  /**
+   * Measurements of one candidate policy
+   */
+  struct Calibration {
+    /** Name as accepted by visitPrecision() */
+    std::string name;
+    double      bytesPerCell = 0.0;
+    /** Maximum difference of h to the shadow at the end of the window */
+    double error = 0.0;
+    /** Least-squares growth of the error per time step */
+    double growthRate = 0.0;
+    /** Error extrapolated to the last time step of the run */
+    double projectedError = 0.0;
+    bool   overflow       = false;
+    bool   accepted       = false;
+  };
+
+  struct Tuning {
+    /** The selected policy; "double" if no candidate is accepted */
+    std::string              precision;
+    std::vector<Calibration> candidates;
+    /** Cells followed by the shadow */
+    unsigned int sampledCells = 0;
+  };
+
+  /**
+   * Runs every policy except double for CalibrationSteps steps next to a
+   * double shadow on sampled chunks (see SampledShadow). The error is assumed
+   * to grow linearly in the number of steps; a policy is accepted if neither
+   * the measured nor the projected error at timeSteps exceeds the tolerance
+   * and its state did not overflow. Of the accepted policies the one with the
+   * fewest bytes per cell is selected.
+   *
+   * Every candidate is calibrated in the configuration of the run: with the
+   * selected solver, and the shadow runs the same solver in double.
+   *
+   * @param tolerance Maximum difference of h to double in m at the end of the run
+   * @param solver Solver and parameters of the run (see visitSolver())
+   * @param primed Calibrate Precision::Primed<Policy> in nondimensional variables instead
+   * @return Candidates the solver is not instantiated for are left out
+   */
+  Tuning tunePrecision(
+    const Scenarios::Scenario& scenario,
+    unsigned int               size,
+    unsigned int               timeSteps,
+    double                     tolerance,
+    const SolverSpec&          solver = SolverSpec{"rusanov", {}},
+    bool                       primed = false
+  );
+
+} // namespace Simulation
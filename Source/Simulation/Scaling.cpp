@@ -0,0 +1,39 @@
+/**
+ * @file Scaling.cpp
+ */
+
+#include "Scaling.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+Simulation::Scaling::Scaling(const RealType* h, unsigned int cells, double g, double cellSize) {
+  double maxDepth = 0.0;
+  for (unsigned int i = 0; i < cells; i++) {
+    maxDepth = std::max(maxDepth, double(h[i]));
+  }
+
+  // Nearest power of two, so that h' of the deepest cell is in [0.7, 1.4]
+  depth    = maxDepth > 0.0 ? std::exp2(std::round(std::log2(maxDepth))) : 1.0;
+  velocity = std::sqrt(g * depth);
+  length   = cellSize;
+  time     = length / velocity;
+}
+
+void Simulation::Scaling::toPrimed(RealType* h, RealType* hu, RealType* b, unsigned int n) const {
+  const double momentum = depth * velocity;
+  for (unsigned int i = 0; i < n; i++) {
+    h[i]  = RealType(h[i] / depth);
+    hu[i] = RealType(hu[i] / momentum);
+    b[i]  = RealType(b[i] / depth);
+  }
+}
+
+void Simulation::Scaling::fromPrimed(RealType* h, RealType* hu, RealType* b, unsigned int n) const {
+  const double momentum = depth * velocity;
+  for (unsigned int i = 0; i < n; i++) {
+    h[i]  = RealType(h[i] * depth);
+    hu[i] = RealType(hu[i] * momentum);
+    b[i]  = RealType(b[i] * depth);
+  }
+}
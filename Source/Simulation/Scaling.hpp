@@ -0,0 +1,46 @@
+/**
+ * @file Scaling.hpp
+ *
+ * Mapping between physical and nondimensional (primed) variables for the
+ * Precision::Primed policies.
+ */
+
+#pragma once
+
+#include "Tools/RealType.hpp"
+
+namespace Simulation {
+
+  /**
+   * h' = h / depth, b' = b / depth, hu' = hu / (depth * velocity),
+   * x' = x / length, t' = t / time with velocity = sqrt(g * depth) and
+   * time = length / velocity. With these the shallow water equations keep
+   * their form with g = 1.
+   *
+   * depth is a power of two, so h and b are mapped without rounding; length
+   * is the cell size, so dx' = 1.
+   */
+  struct Scaling {
+    double depth    = 1.0;
+    double velocity = 1.0;
+    double length   = 1.0;
+    double time     = 1.0;
+
+    /** Identity */
+    Scaling() = default;
+
+    /**
+     * @param h Initial water height on [0,..,cells)
+     * @param g Gravity
+     * @param cellSize Size of one cell
+     */
+    Scaling(const RealType* h, unsigned int cells, double g, double cellSize);
+
+    /** Maps n cells to primed variables in place */
+    void toPrimed(RealType* h, RealType* hu, RealType* b, unsigned int n) const;
+
+    /** Maps n cells back to physical variables in place */
+    void fromPrimed(RealType* h, RealType* hu, RealType* b, unsigned int n) const;
+  };
+
+} // namespace Simulation
@@ -0,0 +1,129 @@
+/**
+ * @file Shadow.cpp
+ */
+
+#include "Shadow.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Solver/SolverList.hpp"
+
+template <class Reference, class Solver>
+Simulation::SampledShadow<Reference, Solver>::SampledShadow(
+  const RealType* h,
+  const RealType* hu,
+  const RealType* b,
+  unsigned int    size,
+  RealType        cellSize,
+  unsigned int    chunks,
+  unsigned int    halo,
+  const Solver&   solver
+):
+  h_(Blocks::ChunkSize),
+  hu_(Blocks::ChunkSize),
+  b_(Blocks::ChunkSize),
+  hRef_(Blocks::ChunkSize),
+  huRef_(Blocks::ChunkSize),
+  bRef_(Blocks::ChunkSize) {
+  const unsigned int totalChunks = (size + Blocks::ChunkSize - 1) / Blocks::ChunkSize;
+  chunks                         = chunks == 0 ? totalChunks : std::min(chunks, totalChunks);
+
+  // Variation of the initial surface and momentum per chunk; edge i lies between cells i and i+1
+  std::vector<double> variation(totalChunks, 0.0);
+  for (unsigned int i = 0; i <= size; i++) {
+    const double jump = std::fabs(double(h[i + 1] + b[i + 1]) - double(h[i] + b[i])) + std::fabs(double(hu[i + 1]) - double(hu[i]));
+    variation[(std::clamp(i, 1u, size) - 1) / Blocks::ChunkSize] += jump;
+  }
+
+  // Half of the samples on the most active chunks, where the error grows first,
+  // the rest evenly spaced
+  std::vector<unsigned int> order(totalChunks);
+  for (unsigned int c = 0; c < totalChunks; c++) {
+    order[c] = c;
+  }
+  std::stable_sort(order.begin(), order.end(), [&](unsigned int left, unsigned int right) { return variation[left] > variation[right]; });
+
+  std::vector<unsigned int> sampled;
+  for (unsigned int k = 0; k < chunks / 2 && variation[order[k]] > 0.0; k++) {
+    sampled.push_back(order[k]);
+  }
+  for (unsigned int k = 0; sampled.size() < chunks; k++) {
+    // Middle of the k-th of chunks equal parts, or the next chunk not taken yet
+    unsigned int chunk = static_cast<unsigned int>((k % chunks + 0.5) * totalChunks / chunks) + k / chunks;
+    chunk %= totalChunks;
+    if (std::find(sampled.begin(), sampled.end(), chunk) == sampled.end()) {
+      sampled.push_back(chunk);
+    }
+  }
+  std::sort(sampled.begin(), sampled.end());
+
+  // Chunks plus halo, merged where they overlap or touch
+  struct Range {
+    unsigned int                                       first, end;
+    std::vector<std::pair<unsigned int, unsigned int>> cores;
+  };
+  std::vector<Range> ranges;
+  for (const unsigned int chunk : sampled) {
+    const unsigned int coreFirst = 1 + chunk * Blocks::ChunkSize;
+    const unsigned int coreEnd   = std::min(size + 1, coreFirst + Blocks::ChunkSize);
+    const unsigned int first     = coreFirst > halo ? std::max(1u, coreFirst - halo) : 1u;
+    const unsigned int end       = std::min(size + 1, coreEnd + halo);
+
+    if (!ranges.empty() && first <= ranges.back().end) {
+      ranges.back().end = end;
+      ranges.back().cores.emplace_back(coreFirst, coreEnd);
+    } else {
+      ranges.push_back(Range{first, end, {{coreFirst, coreEnd}}});
+    }
+  }
+
+  segments_.reserve(ranges.size());
+  for (Range& range : ranges) {
+    // Initial values incl. one ghost cell on each side
+    const unsigned int offset = range.first - 1;
+    segments_.push_back(Segment{range.first, range.end, std::move(range.cores), Block(h + offset, hu + offset, b + offset, range.end - range.first, cellSize)});
+    segments_.back().block.getSolver() = solver;
+
+    if (range.first > 1) {
+      segments_.back().block.setLeftBoundaryCondition(Block::PrescribedBoundary);
+    }
+    if (range.end < size + 1) {
+      segments_.back().block.setRightBoundaryCondition(Block::PrescribedBoundary);
+    }
+  }
+}
+
+template <class Reference, class Solver>
+void Simulation::SampledShadow<Reference, Solver>::step(double dt) {
+  for (Segment& segment : segments_) {
+    segment.block.applyBoundaryConditions();
+    segment.block.computeNumericalFluxes();
+    segment.block.updateUnknowns(dt);
+  }
+}
+
+template <class Reference, class Solver>
+unsigned int Simulation::SampledShadow<Reference, Solver>::getSampledCells() const {
+  unsigned int cells = 0;
+  for (const Segment& segment : segments_) {
+    for (const auto& [begin, end] : segment.cores) {
+      cells += end - begin;
+    }
+  }
+  return cells;
+}
+
+template <class Reference, class Solver>
+unsigned int Simulation::SampledShadow<Reference, Solver>::getShadowCells() const {
+  unsigned int cells = 0;
+  for (const Segment& segment : segments_) {
+    cells += segment.end - segment.first;
+  }
+  return cells;
+}
+
+#define INSTANTIATE_SHADOW(name, Solver, Reference) template class Simulation::SampledShadow<Reference, Solver<Reference>>;
+
+SWE_SOLVERS(INSTANTIATE_SHADOW, Precision::Double)
+SWE_PRIMED_SOLVERS(INSTANTIATE_SHADOW, Precision::Primed<Precision::Double>)
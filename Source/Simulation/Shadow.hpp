@@ -0,0 +1,160 @@
+/**
+ * @file Shadow.hpp
+ *
+ * Double-precision reference ("shadow") of a low-precision run, restricted
+ * to sampled chunks of the domain to bound its cost.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "Blocks/WavePropagationBlockMixed.hpp"
+#include "Solver/RusanovMixed.hpp"
+#include "Tools/PrecisionPolicy.hpp"
+#include "Tools/RealType.hpp"
+
+namespace Simulation {
+
+  /** Halo of the sampled chunks in a lockstep shadow (see SampledShadow) */
+  constexpr unsigned int ShadowHalo = 2 * Blocks::ChunkSize;
+
+  /**
+   * Difference of a run to its shadow on the sampled cells
+   */
+  struct Divergence {
+    /** Mean of |h - h_ref| */
+    double l1 = 0.0;
+    /** Maximum of |h - h_ref| */
+    double linf = 0.0;
+    /** Cell of the maximum */
+    unsigned int linfCell = 0;
+    /** (sum h - sum h_ref) / sum h_ref */
+    double massError = 0.0;
+  };
+
+  /**
+   * Every sampled chunk (Blocks::ChunkSize cells) is simulated in double on a
+   * segment that extends the chunk by a halo on both sides; overlapping
+   * segments are merged, so sampling all chunks gives one full-domain run.
+   * Information travels at most one cell per step (CFL < 1), so the
+   * boundaries of a segment do not reach its chunks for halo steps: a halo of
+   * n cells gives an exact reference for the first n steps. Segments touching
+   * the domain boundary end there with the same (outflow) condition as the
+   * block.
+   *
+   * For longer runs follow() prescribes the ghost cells of the inner segment
+   * boundaries from the followed block. The error of the followed run then
+   * leaks into the shadow from the segment ends, which can only make the
+   * measured divergence smaller, by what travelled more than halo cells.
+   *
+   * The shadow advances with the dt sequence of the run it follows, so the
+   * difference is the precision error only, not a difference of time steps.
+   * Reference is Precision::Double, or Primed<Double> to follow a primed run.
+   * Solver must be the solver of the followed run for the reference policy
+   * (see toReferenceSolver()), otherwise the difference of the two solvers
+   * is reported as precision error.
+   */
+  template <class Reference = Precision::Double, class Solver = Solvers::RusanovMixed<Reference>>
+  class SampledShadow {
+    using Block = Blocks::WavePropagationBlockMixed<Reference, Solver>;
+
+    struct Segment {
+      /** Global indices [first, end) of the inner cells of the segment */
+      unsigned int first, end;
+      /** Global indices [begin, end) of the sampled chunks in the segment */
+      std::vector<std::pair<unsigned int, unsigned int>> cores;
+
+      Block block;
+    };
+
+    std::vector<Segment> segments_;
+
+    /** Buffers for one chunk */
+    std::vector<RealType> h_, hu_, b_, hRef_, huRef_, bRef_;
+
+  public:
+    /**
+     * @param h, hu, b Initial values on [0,..,size+1]
+     * @param size Number of cells without ghost cells
+     * @param cellSize Size of one cell
+     * @param chunks Number of sampled chunks, half on the chunks with the largest initial
+     *   variation, half evenly spaced; all chunks if there are fewer or if 0
+     * @param halo Cells added on both sides of a chunk
+     * @param solver Copied into the blocks, carries the solver parameters
+     */
+    SampledShadow(
+      const RealType* h,
+      const RealType* hu,
+      const RealType* b,
+      unsigned int    size,
+      RealType        cellSize,
+      unsigned int    chunks,
+      unsigned int    halo,
+      const Solver&   solver = Solver()
+    );
+
+    /**
+     * Prescribes the ghost cells of inner segment boundaries from the followed block
+     */
+    template <class FollowedBlock>
+    void follow(const FollowedBlock& block) {
+      RealType h, hu, b;
+      for (Segment& segment : segments_) {
+        if (segment.first > 1) {
+          block.getCells(segment.first - 1, 1, &h, &hu, &b);
+          segment.block.setCell(0, h, hu, b);
+        }
+        if (segment.end < block.getSize() + 1) {
+          block.getCells(segment.end, 1, &h, &hu, &b);
+          segment.block.setCell(segment.end - segment.first + 1, h, hu, b);
+        }
+      }
+    }
+
+    /** Advances all segments by dt */
+    void step(double dt);
+
+    /**
+     * @return Difference of h of the followed block to the shadow on the sampled chunks
+     */
+    template <class FollowedBlock>
+    Divergence compare(const FollowedBlock& block) {
+      Divergence   divergence;
+      double       difference = 0.0, sum = 0.0, sumRef = 0.0;
+      unsigned int cells      = 0;
+      for (Segment& segment : segments_) {
+        for (const auto& [begin, end] : segment.cores) {
+          const unsigned int count = end - begin;
+          block.getCells(begin, count, h_.data(), hu_.data(), b_.data());
+          // Local index i - first + 1 because of the ghost cell
+          segment.block.getCells(begin - segment.first + 1, count, hRef_.data(), huRef_.data(), bRef_.data());
+
+          for (unsigned int k = 0; k < count; k++) {
+            const double d = std::fabs(double(h_[k]) - double(hRef_[k]));
+            if (!(d <= divergence.linf)) { // NaN wins
+              divergence.linf     = d;
+              divergence.linfCell = begin + k;
+            }
+            difference += d;
+            sum += double(h_[k]);
+            sumRef += double(hRef_[k]);
+          }
+          cells += count;
+        }
+      }
+      divergence.l1        = cells > 0 ? difference / cells : 0.0;
+      divergence.massError = sumRef > 0.0 ? (sum - sumRef) / sumRef : sum - sumRef;
+      return divergence;
+    }
+
+    /** @return Number of cells in sampled chunks */
+    unsigned int getSampledCells() const;
+
+    /** @return Number of cells simulated by the shadow (incl. halos) */
+    unsigned int getShadowCells() const;
+  };
+
+} // namespace Simulation
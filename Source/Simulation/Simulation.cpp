@@ -0,0 +1,311 @@
+/**
+ * @file Simulation.cpp
+ */
+
+#include "Simulation.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <type_traits>
+
+#include "Blocks/SemiImplicitBlock.hpp"
+#include "Blocks/WavePropagationBlockMixed.hpp"
+#include "Simulation/SolverRegistry.hpp"
+#include "Solver/SolverList.hpp"
+#include "Writers/VTKWriter.hpp"
+
+namespace {
+
+  /**
+   * Initial values of the scenario (incl. ghost cells) into result, written
+   * unscaled, then converted to primed variables for primed policies
+   */
+  template <class Policy>
+  void loadScenario(Simulation::Result& result, const Scenarios::Scenario& scenario, unsigned int size, Writers::VTKWriter* writer) {
+    result.h.resize(size + 2);
+    result.hu.resize(size + 2);
+    result.b.resize(size + 2);
+
+    // Initialize water height, momentum and bathymetry
+    for (unsigned int i = 0; i < size + 2; i++) {
+      result.h[i]  = scenario.getHeight(i);
+      result.hu[i] = scenario.getMomentum(i);
+      result.b[i]  = scenario.getBathymetry(i);
+    }
+
+    if (writer) {
+      writer->write(RealType(result.time), result.h.data(), result.hu.data(), result.b.data(), size);
+    }
+
+    // Primed policies run in nondimensional variables, everything else with the identity
+    if (Policy::primed) {
+      result.scaling = Simulation::Scaling(result.h.data(), size + 2, Precision::Double::G, scenario.getCellSize());
+      result.scaling.toPrimed(result.h.data(), result.hu.data(), result.b.data(), size + 2);
+    }
+  }
+
+  /** State of the block into result, in physical variables */
+  template <class Policy, class Block>
+  void extractState(const Block& block, Simulation::Result& result, unsigned int size) {
+    block.getState(result.h.data(), result.hu.data(), result.b.data());
+    if (Policy::primed) {
+      result.scaling.fromPrimed(result.h.data(), result.hu.data(), result.b.data(), size + 2);
+    }
+  }
+
+  /**
+   * Residual monitoring of RunOptions::steadyTolerance and
+   * RunOptions::residualHistory for the time loops
+   */
+  class SteadyStateMonitor {
+    const Simulation::RunOptions& options_;
+    /** Consecutive steps with the residual below the tolerance */
+    unsigned int stepsBelow_ = 0;
+
+  public:
+    explicit SteadyStateMonitor(const Simulation::RunOptions& options):
+      options_(options) {
+      if (options_.residualHistory) {
+        *options_.residualHistory
+          << "# step " << (options_.localTimeStepping ? "pseudo_time" : "time") << " l1_h linf_h l1_hu linf_hu" << std::endl;
+      }
+    }
+
+    bool isActive() const { return options_.steadyTolerance > 0.0 || options_.residualHistory; }
+
+    /**
+     * Stores the residual of the step in physical units in result and
+     * appends it to the history
+     *
+     * @return Whether the run is steady: below the tolerance for the whole window
+     */
+    template <class Work>
+    bool record(const Blocks::Residual<Work>& residual, unsigned int step, Simulation::Result& result) {
+      const Simulation::Scaling& scaling = result.scaling;
+      const double               hRate   = scaling.depth / scaling.time;
+      const double               huRate  = scaling.depth * scaling.velocity / scaling.time;
+      result.residual.l1H                = double(residual.l1H) * hRate;
+      result.residual.linfH              = double(residual.linfH) * hRate;
+      result.residual.l1Hu               = double(residual.l1Hu) * huRate;
+      result.residual.linfHu             = double(residual.linfHu) * huRate;
+
+      if (options_.residualHistory) {
+        *options_.residualHistory
+          << step << ' ' << result.time << ' ' << result.residual.l1H << ' ' << result.residual.linfH << ' '
+          << result.residual.l1Hu << ' ' << result.residual.linfHu << '\n';
+      }
+      if (!(options_.steadyTolerance > 0.0)) {
+        return false;
+      }
+
+      stepsBelow_ = std::max(result.residual.linfH, result.residual.linfHu) < options_.steadyTolerance ? stepsBelow_ + 1 : 0;
+      if (stepsBelow_ < options_.steadyWindow) {
+        return false;
+      }
+      result.steadyStep = step;
+      return true;
+    }
+  };
+
+  /** Time loop of run() with RunOptions::semiImplicit */
+  template <class Policy>
+  Simulation::Result runSemiImplicit(
+    const Scenarios::Scenario&    scenario,
+    unsigned int                  size,
+    unsigned int                  timeSteps,
+    Writers::VTKWriter*           writer,
+    const Simulation::RunOptions& options
+  ) {
+    Simulation::Result result;
+    loadScenario<Policy>(result, scenario, size, writer);
+    const Simulation::Scaling& scaling = result.scaling;
+
+    Blocks::SemiImplicitBlock<Policy> block(
+      result.h.data(), result.hu.data(), result.b.data(), size, RealType(scenario.getCellSize() / scaling.length)
+    );
+    SteadyStateMonitor steadyState(options);
+    block.setResidualMonitoring(steadyState.isActive());
+
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < timeSteps; i++) {
+      block.applyBoundaryConditions();
+      const auto maxTimeStep = block.computeNumericalFluxes();
+      block.updateUnknowns(maxTimeStep);
+      result.time += double(maxTimeStep) * scaling.time;
+
+      if (writer) {
+        extractState<Policy>(block, result, size);
+        writer->write(RealType(result.time), result.h.data(), result.hu.data(), result.b.data(), size);
+      }
+
+      result.steps = i + 1;
+      if (steadyState.isActive() && steadyState.record(block.getResidual(), i + 1, result)) {
+        break;
+      }
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    extractState<Policy>(block, result, size);
+    result.overflow = block.hasOverflowed();
+    return result;
+  }
+
+  template <class Policy, class Solver>
+  Simulation::Result runLoop(
+    const Scenarios::Scenario&    scenario,
+    unsigned int                  size,
+    unsigned int                  timeSteps,
+    Writers::VTKWriter*           writer,
+    unsigned int                  shadowChunks,
+    double                        threshold,
+    std::ostream*                 series,
+    const Solver&                 solver,
+    const Simulation::RunOptions& options
+  ) {
+    Simulation::Result result;
+    loadScenario<Policy>(result, scenario, size, writer);
+    const Simulation::Scaling& scaling  = result.scaling;
+    const RealType             cellSize = RealType(scenario.getCellSize() / scaling.length);
+
+    Blocks::WavePropagationBlockMixed<Policy, Solver> wavePropagation(result.h.data(), result.hu.data(), result.b.data(), size, cellSize);
+    wavePropagation.getSolver() = solver;
+    wavePropagation.setMemoization(options.memoize);
+    wavePropagation.setLinearRegion(typename Policy::Work(options.linearThreshold));
+    SteadyStateMonitor steadyState(options);
+    wavePropagation.setResidualMonitoring(steadyState.isActive());
+    wavePropagation.setLocalTimeStepping(options.localTimeStepping);
+
+    // The shadow runs the same solver with the same parameters, so that only the precision differs
+    using Reference = std::conditional_t<Policy::primed, Precision::Primed<Precision::Double>, Precision::Double>;
+    using Shadow    = Simulation::SampledShadow<Reference, Simulation::RebindSolver<Solver, Reference>>;
+    std::unique_ptr<Shadow> shadow;
+    if (series) {
+      shadow = std::make_unique<Shadow>(
+        result.h.data(),
+        result.hu.data(),
+        result.b.data(),
+        size,
+        cellSize,
+        shadowChunks,
+        Simulation::ShadowHalo,
+        Simulation::toReferenceSolver<Reference>(solver)
+      );
+      *series
+        << "# " << Policy::name << (Policy::primed ? " (primed)" : "") << ", shadow on " << shadow->getSampledCells() << " of "
+        << size << " cells (" << shadow->getShadowCells() << " with halo)" << std::endl
+        << "# step time l1 linf linf_cell mass_error" << std::endl;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < timeSteps; i++) {
+      wavePropagation.applyBoundaryConditions();
+      if (shadow) {
+        shadow->follow(wavePropagation);
+      }
+      const auto maxTimeStep = wavePropagation.computeNumericalFluxes();
+      if (options.memoize && result.memoOffStep == 0 && !wavePropagation.isMemoizing()) {
+        result.memoOffStep = i + 1;
+      }
+      wavePropagation.updateUnknowns(maxTimeStep);
+      result.time += double(maxTimeStep) * scaling.time;
+
+      if (shadow) {
+        shadow->step(double(maxTimeStep));
+        result.divergence = shadow->compare(wavePropagation);
+        result.divergence.l1 *= scaling.depth;
+        result.divergence.linf *= scaling.depth;
+        if (result.firstDivergenceStep == 0 && !(result.divergence.linf <= threshold)) {
+          result.firstDivergenceStep = i + 1;
+          result.firstDivergenceCell = result.divergence.linfCell;
+        }
+        *series
+          << i + 1 << ' ' << result.time << ' ' << result.divergence.l1 << ' ' << result.divergence.linf << ' '
+          << result.divergence.linfCell << ' ' << result.divergence.massError << '\n';
+      }
+
+      if (writer) {
+        extractState<Policy>(wavePropagation, result, size);
+        writer->write(RealType(result.time), result.h.data(), result.hu.data(), result.b.data(), size);
+      }
+
+      result.steps = i + 1;
+      if (steadyState.isActive() && steadyState.record(wavePropagation.getResidual(), i + 1, result)) {
+        break;
+      }
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    extractState<Policy>(wavePropagation, result, size);
+    result.overflow     = wavePropagation.hasOverflowed();
+    result.wetChunks    = wavePropagation.getWetChunks();
+    result.dryChunks    = wavePropagation.getDryChunks();
+    result.mixedChunks  = wavePropagation.getMixedChunks();
+    result.linearChunks = wavePropagation.getLinearChunks();
+    result.memoEdges    = wavePropagation.getMemoEdges();
+    result.memoHits     = wavePropagation.getMemoHits();
+    if constexpr (requires { Solver::batched; }) {
+      result.cheapEdges     = wavePropagation.getSolver().getCheapEdges();
+      result.expensiveEdges = wavePropagation.getSolver().getExpensiveEdges();
+    }
+    return result;
+  }
+
+} // namespace
+
+template <class Policy, class Solver>
+Simulation::Result Simulation::run(
+  const Scenarios::Scenario& scenario,
+  unsigned int               size,
+  unsigned int               timeSteps,
+  Writers::VTKWriter*        writer,
+  const Solver&              solver,
+  const RunOptions&          options
+) {
+  if (options.semiImplicit) {
+    return runSemiImplicit<Policy>(scenario, size, timeSteps, writer, options);
+  }
+  return runLoop<Policy, Solver>(scenario, size, timeSteps, writer, 0, 0.0, nullptr, solver, options);
+}
+
+template <class Policy, class Solver>
+Simulation::Result Simulation::runShadowed(
+  const Scenarios::Scenario& scenario,
+  unsigned int               size,
+  unsigned int               timeSteps,
+  unsigned int               chunks,
+  double                     threshold,
+  std::ostream&              series,
+  Writers::VTKWriter*        writer,
+  const Solver&              solver,
+  const RunOptions&          options
+) {
+  return runLoop<Policy, Solver>(scenario, size, timeSteps, writer, chunks, threshold, &series, solver, options);
+}
+
+const std::vector<std::string>& Simulation::getPrecisionNames() {
+#define PRECISION_NAME(name, Policy, ARG) name,
+  static const std::vector<std::string> names = {SWE_PRECISION_POLICIES(PRECISION_NAME, )};
+#undef PRECISION_NAME
+  return names;
+}
+
+#define INSTANTIATE_RUN(name, Policy, Solver) \
+  template Simulation::Result Simulation::run<Policy, Solver<Policy>>( \
+    const Scenarios::Scenario&, unsigned int, unsigned int, Writers::VTKWriter*, const Solver<Policy>&, const Simulation::RunOptions& \
+  ); \
+  template Simulation::Result Simulation::runShadowed<Policy, Solver<Policy>>( \
+    const Scenarios::Scenario&, \
+    unsigned int, \
+    unsigned int, \
+    unsigned int, \
+    double, \
+    std::ostream&, \
+    Writers::VTKWriter*, \
+    const Solver<Policy>&, \
+    const Simulation::RunOptions& \
+  );
+#define INSTANTIATE_PRIMED_RUN(name, Policy, Solver) INSTANTIATE_RUN(name, Precision::Primed<Policy>, Solver)
+
+SWE_POLICIES_AND_SOLVERS(INSTANTIATE_RUN)
+SWE_PRIMED_POLICIES_AND_SOLVERS(INSTANTIATE_PRIMED_RUN)
@@ -0,0 +1,185 @@
+/**
+ * @file Simulation.hpp
+ *
+ * Time loop of the policy-based block (Blocks/WavePropagationBlockMixed.hpp)
+ * and the mapping from the --precision names to precision policies. All
+ * policies of SWE_PRECISION_POLICIES are explicitly instantiated in
+ * Simulation.cpp, so a single binary can run any of them, also back to back.
+ */
+
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Blocks/Residual.hpp"
+#include "Scenarios/Scenario.hpp"
+#include "Simulation/Scaling.hpp"
+#include "Simulation/Shadow.hpp"
+#include "Solver/RusanovMixed.hpp"
+#include "Tools/PrecisionPolicy.hpp"
+#include "Tools/RealType.hpp"
+
+namespace Writers {
+  class VTKWriter;
+} // namespace Writers
+
+namespace Simulation {
+
+  /**
+   * Final state (incl. ghost cells) and statistics of a run
+   */
+  struct Result {
+    std::vector<RealType> h;
+    std::vector<RealType> hu;
+    std::vector<RealType> b;
+
+    /** Simulated time; with RunOptions::localTimeStepping pseudo-time, the sum of the global time steps */
+    double time = 0.0;
+    /** Wall clock time of the time loop in seconds */
+    double seconds = 0.0;
+    /** Number of time steps */
+    unsigned int steps = 0;
+    /** A fixed-point state left its range (see Blocks::StateStorage) */
+    bool overflow = false;
+    /** Scales of the primed variables; the identity unless Policy::primed */
+    Scaling scaling;
+
+    /** runShadowed() only: divergence after the last step */
+    Divergence divergence;
+    /** runShadowed() only: first step and cell with a divergence above the threshold, step 0 if none */
+    unsigned int firstDivergenceStep = 0;
+    unsigned int firstDivergenceCell = 0;
+
+    /** Chunks of edges per class over all steps (see WavePropagationBlockMixed::computeNumericalFluxes) */
+    unsigned long long wetChunks   = 0;
+    unsigned long long dryChunks   = 0;
+    unsigned long long mixedChunks = 0;
+    /** RunOptions::linearThreshold only: wet chunks advanced by the linear flux */
+    unsigned long long linearChunks = 0;
+
+    /** Solvers::HybridSolver only: edges computed by the cheap and the expensive solver */
+    unsigned long long cheapEdges     = 0;
+    unsigned long long expensiveEdges = 0;
+
+    /** RunOptions::memoize only: edges swept while memoizing, edges copied from their left neighbour */
+    unsigned long long memoEdges = 0;
+    unsigned long long memoHits  = 0;
+    /** RunOptions::memoize only: step after which memoization turned itself off, 0 if it stayed on */
+    unsigned int memoOffStep = 0;
+
+    /** Residual monitoring only: residual of the last step in physical units */
+    Blocks::Residual<double> residual;
+    /** RunOptions::steadyTolerance only: step after which the run was steady and stopped, 0 if it ran to the end */
+    unsigned int steadyStep = 0;
+  };
+
+  /**
+   * Optional features of the time loop, all off by default
+   */
+  struct RunOptions {
+    /** Solve runs of identical edges once (see WavePropagationBlockMixed::setMemoization) */
+    bool memoize = false;
+    /**
+     * Amplitude-to-depth ratio and Froude number below which chunks take
+     * the linear flux, 0 for none (see WavePropagationBlockMixed::setLinearRegion)
+     */
+    double linearThreshold = 0.0;
+    /**
+     * run() only: advance with Blocks::SemiImplicitBlock, the time step is
+     * bounded by the flow speed; the solver and the options above are not used
+     */
+    bool semiImplicit = false;
+    /**
+     * Stop the run once max(linfH, linfHu) of the residual (see
+     * Blocks::Residual) has stayed below steadyTolerance for steadyWindow
+     * steps in a row, 0 for none. Result::steps holds the steps taken.
+     */
+    double       steadyTolerance = 0.0;
+    unsigned int steadyWindow    = 100;
+    /** Receives one line per step: step, time, l1 and linf of dh/dt and d(hu)/dt, may be nullptr */
+    std::ostream* residualHistory = nullptr;
+    /**
+     * Pseudo-time stepping for steady states: every cell advances with its
+     * own maximum stable time step (see WavePropagationBlockMixed::setLocalTimeStepping),
+     * the run is not time accurate; ignored with semiImplicit
+     */
+    bool localTimeStepping = false;
+  };
+
+  /**
+   * Runs the scenario for a number of time steps with a precision policy
+   *
+   * @param scenario Initial values
+   * @param size Number of cells without ghost cells
+   * @param timeSteps Number of time steps, at most with RunOptions::steadyTolerance
+   * @param writer Receives the initial state and the state after every step, may be nullptr
+   * @param solver Copied into the block, carries the solver parameters (see visitSolver())
+   * @param options Optional features of the time loop
+   */
+  template <class Policy, class Solver = Solvers::RusanovMixed<Policy>>
+  Result run(
+    const Scenarios::Scenario& scenario,
+    unsigned int               size,
+    unsigned int               timeSteps,
+    Writers::VTKWriter*        writer = nullptr,
+    const Solver&              solver  = Solver(),
+    const RunOptions&          options = RunOptions()
+  );
+
+  /**
+   * Runs like run() with a double shadow (see SampledShadow) in lockstep:
+   * the shadow takes the same dt sequence and is compared after every step.
+   *
+   * @param chunks Number of sampled chunks, 0 for the whole domain
+   * @param threshold Divergence of h in m that counts as first divergence
+   * @param series Receives one line per step: step, time, l1, linf, cell of linf, mass error
+   */
+  template <class Policy, class Solver = Solvers::RusanovMixed<Policy>>
+  Result runShadowed(
+    const Scenarios::Scenario& scenario,
+    unsigned int               size,
+    unsigned int               timeSteps,
+    unsigned int               chunks,
+    double                     threshold,
+    std::ostream&              series,
+    Writers::VTKWriter*        writer = nullptr,
+    const Solver&              solver  = Solver(),
+    const RunOptions&          options = RunOptions()
+  );
+
+  namespace detail {
+    template <class Policy, class Visitor>
+    void visit(Visitor& visitor, bool primed) {
+      if (primed) {
+        visitor(Precision::Primed<Policy>{});
+      } else {
+        visitor(Policy{});
+      }
+    }
+  } // namespace detail
+
+  /**
+   * Calls visitor(Policy{}) with the policy selected by name
+   *
+   * @param name One of getPrecisionNames()
+   * @param primed Select Precision::Primed<Policy> instead
+   * @return False if the name is unknown
+   */
+  template <class Visitor>
+  bool visitPrecision(const std::string& name, Visitor&& visitor, bool primed = false) {
+#define VISIT_PRECISION(policyName, Policy, ARG) \
+  if (name == policyName) { \
+    detail::visit<Policy>(visitor, primed); \
+    return true; \
+  }
+    SWE_PRECISION_POLICIES(VISIT_PRECISION, )
+#undef VISIT_PRECISION
+    return false;
+  }
+
+  /** @return All names accepted by visitPrecision() */
+  const std::vector<std::string>& getPrecisionNames();
+
+} // namespace Simulation
@@ -0,0 +1,36 @@
+/**
+ * @file SolverRegistry.cpp
+ */
+
+#include "SolverRegistry.hpp"
+
+#include <sstream>
+
+bool Simulation::parseSolverSpec(const std::string& text, SolverSpec& spec) {
+  std::istringstream fields(text);
+  std::getline(fields, spec.name, ':');
+  spec.parameters.clear();
+
+  std::string field;
+  while (std::getline(fields, field, ':')) {
+    const std::size_t equals = field.find('=');
+    if (equals == std::string::npos || equals == 0) {
+      return false;
+    }
+
+    std::istringstream value(field.substr(equals + 1));
+    double             number;
+    if (!(value >> number) || !value.eof()) {
+      return false;
+    }
+    spec.parameters.emplace_back(field.substr(0, equals), number);
+  }
+  return true;
+}
+
+const std::vector<std::string>& Simulation::getSolverNames() {
+#define SOLVER_NAME(name, Solver, ARG) name,
+  static const std::vector<std::string> names = {SWE_SOLVERS(SOLVER_NAME, )};
+#undef SOLVER_NAME
+  return names;
+}
@@ -0,0 +1,154 @@
+/**
+ * @file SolverRegistry.hpp
+ *
+ * Mapping from the --solver names to the solver types of the policy-based
+ * block. The selection happens once, before the time loop: the visitor is
+ * called with a solver object of the selected type, so the block and its
+ * edge loop are the fully instantiated specialization for that solver
+ * (see Simulation.cpp) and never dispatch per edge.
+ */
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Solver/SolverList.hpp"
+
+namespace Simulation {
+
+  /**
+   * A solver selection as given to --solver: NAME[:KEY=VALUE[:KEY=VALUE...]]
+   *
+   * The keys are solver parameters, in the units the policy computes in:
+   *   hmin    Dry threshold (rusanov, hllc, roe)
+   *   drytol  Dry threshold (fwave, augmented)
+   *   jump    Relative surface jump above which an edge is rough (hybrid)
+   *   sonic   Half width of the Froude number band around 1 that is rough (hybrid)
+   */
+  struct SolverSpec {
+    std::string                                  name;
+    std::vector<std::pair<std::string, double>> parameters;
+  };
+
+  /**
+   * Splits a --solver argument into name and parameters
+   *
+   * @return False if a parameter is not of the form KEY=VALUE with a numeric value
+   */
+  bool parseSolverSpec(const std::string& text, SolverSpec& spec);
+
+  /** @return All names accepted by visitSolver() */
+  const std::vector<std::string>& getSolverNames();
+
+  namespace detail {
+    /** @return False if the solver has no parameter key */
+    template <class Solver>
+    bool setSolverParameter(Solver& solver, const std::string& key, double value) {
+      using Work = typename Solver::Work;
+      if (key == "hmin") {
+        if constexpr (requires(Work w) { solver.setHMin(w); }) {
+          solver.setHMin(Work(value));
+          return true;
+        }
+      } else if (key == "drytol") {
+        if constexpr (requires(Work w) { solver.setDryTol(w); }) {
+          solver.setDryTol(Work(value));
+          return true;
+        }
+      } else if (key == "jump") {
+        if constexpr (requires(Work w) { solver.setJumpTolerance(w); }) {
+          solver.setJumpTolerance(Work(value));
+          return true;
+        }
+      } else if (key == "sonic") {
+        if constexpr (requires(Work w) { solver.setSonicBand(w); }) {
+          solver.setSonicBand(Work(value));
+          return true;
+        }
+      }
+      return false;
+    }
+
+    template <class Solver, class Policy>
+    struct Rebind;
+
+    template <template <class, class...> class SolverTemplate, class SolverPolicy, class... Rest, class Policy>
+    struct Rebind<SolverTemplate<SolverPolicy, Rest...>, Policy> {
+      using type = SolverTemplate<Policy, Rest...>;
+    };
+
+    // The expensive solver of a hybrid computes in the policy as well
+    template <class SolverPolicy, class Expensive, class Policy>
+    struct Rebind<Solvers::HybridSolver<SolverPolicy, Expensive>, Policy> {
+      using type = Solvers::HybridSolver<Policy, typename Rebind<Expensive, Policy>::type>;
+    };
+
+    template <class Solver, class Visitor>
+    bool visitConfigured(const SolverSpec& spec, Visitor& visitor) {
+      Solver solver;
+      for (const auto& [key, value] : spec.parameters) {
+        if (!setSolverParameter(solver, key, value)) {
+          return false;
+        }
+      }
+      visitor(solver);
+      return true;
+    }
+  } // namespace detail
+
+  /** The solver type Solver, instantiated for Policy instead */
+  template <class Solver, class Policy>
+  using RebindSolver = typename detail::Rebind<Solver, Policy>::type;
+
+  /**
+   * The same solver for the reference policy of a shadow (see SampledShadow),
+   * with the parameters of solver
+   */
+  template <class Reference, class Solver>
+  RebindSolver<Solver, Reference> toReferenceSolver(const Solver& solver) {
+    using Work = typename Reference::Work;
+    RebindSolver<Solver, Reference> reference;
+    if constexpr (requires { solver.getHMin(); }) {
+      reference.setHMin(Work(solver.getHMin()));
+    }
+    if constexpr (requires { solver.getDryTol(); }) {
+      reference.setDryTol(Work(solver.getDryTol()));
+    }
+    if constexpr (requires { solver.getJumpTolerance(); }) {
+      reference.setJumpTolerance(Work(solver.getJumpTolerance()));
+    }
+    if constexpr (requires { solver.getSonicBand(); }) {
+      reference.setSonicBand(Work(solver.getSonicBand()));
+    }
+    return reference;
+  }
+
+  /**
+   * Calls visitor(solver) with the solver selected by spec.name, its
+   * parameters set from spec.parameters.
+   *
+   * Precision::Primed policies are only instantiated with the solvers of
+   * SWE_PRIMED_SOLVERS (rusanov, hybrid).
+   *
+   * @param spec Name (one of getSolverNames()) and parameters
+   * @return False if the name is unknown, the solver has no such parameter
+   *   or is not instantiated for Policy
+   */
+  template <class Policy, class Visitor>
+  bool visitSolver(const SolverSpec& spec, Visitor&& visitor) {
+#define VISIT_SOLVER(solverName, Solver, ARG) \
+  if (spec.name == solverName) { \
+    return detail::visitConfigured<Solver<Policy>>(spec, visitor); \
+  }
+    if constexpr (Policy::primed) {
+      SWE_PRIMED_SOLVERS(VISIT_SOLVER, )
+    } else {
+      SWE_SOLVERS(VISIT_SOLVER, )
+    }
+#undef VISIT_SOLVER
+    return false;
+  }
+
+} // namespace Simulation
@@ -1,8 +1,13 @@
-//
-// Created by Lena Elisabeth Holtmannspötter on 28.08.25.
-//
+/**
+ * @file Augumented.hpp
+ * Augmented Riemann solver in RealType (see AugumentedMixed.hpp).
+ */
 
-#ifndef SWE1D_AUGUMENTED_HPP
-#define SWE1D_AUGUMENTED_HPP
+#pragma once
 
-#endif //SWE1D_AUGUMENTED_HPP
+#include "Solver/AugumentedMixed.hpp"
+
+namespace Solvers {
+  /** The augmented Riemann solver with RealType arithmetic, e.g. for the RealType blocks */
+  using Augumented = AugumentedMixed<Precision::RealTypePolicy>;
+} // namespace Solvers
@@ -0,0 +1,13 @@
+/**
+ * @file AugumentedMixed.cpp
+ * Explicit instantiations of the augmented Riemann solver for all precision
+ * policies.
+ */
+
+#include "AugumentedMixed.hpp"
+
+#define INSTANTIATE_SOLVER(name, Policy, ARG) \
+  template class Solvers::AugumentedMixed<Policy>; \
+  template class Solvers::AugumentedMixed<Precision::Primed<Policy>>;
+
+SWE_PRECISION_POLICIES(INSTANTIATE_SOLVER, )
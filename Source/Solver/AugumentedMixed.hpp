@@ -1,8 +1,324 @@
-//
-// Created by Lena Elisabeth Holtmannspötter on 28.08.25.
-//
+/**
+ * @file AugumentedMixed.hpp
+ * Augmented Riemann solver (George 2008) for the shallow water equations
+ * with bathymetry, wetting & drying and steady-state preservation.
+ *
+ * The solver is templated on a precision policy (see Tools/PrecisionPolicy.hpp)
+ * like Solvers::RusanovMixed: all arithmetic is done in Policy::Work, square
+ * roots and divisions use the accuracy tier Policy::math.
+ *
+ * The jump between two cells is split into three f-waves: the 1- and
+ * 3-waves travel with the modified Einfeldt speeds, the 2-wave is a
+ * steady-state wave that takes up the bathymetry source term. Steady
+ * states such as a lake at rest therefore give zero net updates. A dry
+ * neighbour acts as a reflecting wall unless the water can flood it.
+ *
+ * References:
+ * - George, D. L. (2008). Augmented Riemann solvers for the shallow water
+ *   equations over variable topography with steady states and inundation.
+ *   J. Comput. Phys. 227(6), 3089-3113.
+ * - Einfeldt, B. (1988). On Godunov-type methods for gas dynamics.
+ *   SIAM J. Numer. Anal. 25(2), 294-318.
+ */
 
-#ifndef SWE1D_AUGUMENTEDMIXED_HPP
-#define SWE1D_AUGUMENTEDMIXED_HPP
+#pragma once
 
-#endif //SWE1D_AUGUMENTEDMIXED_HPP
+#include <cmath>
+
+#include "Tools/PrecisionPolicy.hpp"
+#include "Tools/RealMath.hpp"
+
+namespace Solvers {
+  template <class Policy>
+  class AugumentedMixed {
+  public:
+    using Work = typename Policy::Work;
+
+    // Gravity, 1 for Precision::Primed policies (the multiplications fold away)
+    static constexpr Work G = Policy::G; // (m/s^2)
+    // The bed step is a stationary wave of the augmented system: a lake at rest stays at rest
+    static constexpr bool wellBalanced = true;
+
+    /// Middle state of the Riemann problem on a flat bed
+    struct MiddleState {
+      Work h;  ///< Middle depth
+      Work s1; ///< Speed of the 1-wave at the middle state
+      Work s2; ///< Speed of the 2-wave at the middle state
+    };
+
+    /**
+     * @param dryTol Depth below which a cell is dry
+     * @param newtonIterations Newton steps for the middle depth of shock problems
+     */
+    explicit AugumentedMixed(Work dryTol = Work(Policy::DRY_TOL), unsigned int newtonIterations = 1):
+      dryTol_(dryTol),
+      newtonIterations_(newtonIterations) {}
+
+    /**
+     * @brief Net updates of the augmented Riemann solver.
+     *
+     * Same interface as RusanovMixed::computeNetUpdates: each f-wave goes to
+     * the side its speed points to, waves with speed zero are split evenly.
+     *
+     * @param[in] hLTrueValue  Water height on left cell center
+     * @param[in] hRTrueValue  Water height on right cell center
+     * @param[in] huLTrueValue Water momentum on left cell center
+     * @param[in] huRTrueValue Water momentum on right cell center
+     * @param[in] bLTrueValue  Bathymetry at left cell center
+     * @param[in] bRTrueValue  Bathymetry at right cell center
+     * @param[out] hNetUpdateLeft   Net update for height to the left cell
+     * @param[out] hNetUpdateRight  Net update for height to the right cell
+     * @param[out] huNetUpdateLeft  Net update for momentum to the left cell
+     * @param[out] huNetUpdateRight Net update for momentum to the right cell
+     * @param[out] maxEdgeSpeed     Maximum signal speed at the interface (for CFL)
+     */
+    void computeNetUpdates(
+      const Work& hLTrueValue,
+      const Work& hRTrueValue,
+      const Work& huLTrueValue,
+      const Work& huRTrueValue,
+      const Work& bLTrueValue,
+      const Work& bRTrueValue,
+      Work&       hNetUpdateLeft,
+      Work&       hNetUpdateRight,
+      Work&       huNetUpdateLeft,
+      Work&       huNetUpdateRight,
+      Work&       maxEdgeSpeed
+    ) const;
+
+    /**
+     * @brief Middle state from the wave structure of the flat-bed problem.
+     *
+     * Two rarefactions are solved exactly, two shocks and a shock with a
+     * rarefaction by Newton steps from the larger resp. smaller depth.
+     */
+    MiddleState computeMiddleState(Work hL, Work hR, Work uL, Work uR) const {
+      return computeMiddleState(hL, hR, uL, uR, sqrt_work<Policy>(G * hL), sqrt_work<Policy>(G * hR));
+    }
+
+    Work getDryTol() const { return dryTol_; }
+    void setDryTol(Work dryTol) { dryTol_ = dryTol; }
+
+  private:
+    /** Tolerance for detecting sonic and resonant states in the steady-state wave */
+    static constexpr Work CriticalTol = Work(1e-6);
+
+    Work         dryTol_;
+    unsigned int newtonIterations_;
+
+    /** computeMiddleState with the gravity wave speeds cL = sqrt(g hL), cR = sqrt(g hR) */
+    MiddleState computeMiddleState(Work hL, Work hR, Work uL, Work uR, Work cL, Work cR) const;
+  };
+
+  template <class Policy>
+  typename AugumentedMixed<Policy>::MiddleState AugumentedMixed<Policy>::computeMiddleState(
+    Work hL, Work hR, Work uL, Work uR, Work cL, Work cR
+  ) const {
+    const Work hMin = min_work(hL, hR);
+    const Work hMax = max_work(hL, hR);
+    const Work delU = uR - uL;
+
+    // One side dry: a single rarefaction into the dry bed
+    if (hMin <= dryTol_) {
+      const Work s = uR + uL - Work(2) * cR + Work(2) * cL;
+      return {Work(0), s, s};
+    }
+
+    const Work cMin = min_work(cL, cR), cMax = max_work(cL, cR);
+    const Work fMin = delU + Work(2) * (cMin - cMax);
+    const Work fMax = delU + (hMax - hMin) * sqrt_work<Policy>(div_work<Policy>(Work(0.5) * G * (hMax + hMin), hMax * hMin));
+
+    if (fMin > Work(0)) {
+      // Two rarefactions
+      const Work root = max_work(Work(0), -delU + Work(2) * (cL + cR));
+      const Work hM   = div_work<Policy>(root * root, Work(16) * G);
+      const Work cM   = sqrt_work<Policy>(G * hM);
+      return {hM, uL + Work(2) * cL - Work(3) * cM, uR - Work(2) * cR + Work(3) * cM};
+    }
+
+    // Equal states (fMin = fMax = 0): no waves, the Newton step would return hL
+    if (fMin >= Work(0) && fMax <= Work(0)) {
+      return {hL, uL - cL, uR + cR};
+    }
+
+    const Work rcpL = div_work<Policy>(Work(1), hL), rcpR = div_work<Policy>(Work(1), hR);
+    if (fMax <= Work(0)) {
+      // Two shocks: Newton on sqrt(h)
+      Work h0 = hMax;
+      for (unsigned int iter = 0; iter < newtonIterations_; iter++) {
+        const Work rcp0  = div_work<Policy>(Work(1), h0);
+        const Work gL    = sqrt_work<Policy>(Work(0.5) * G * (rcp0 + rcpL));
+        const Work gR    = sqrt_work<Policy>(Work(0.5) * G * (rcp0 + rcpR));
+        const Work f0    = delU + (h0 - hL) * gL + (h0 - hR) * gR;
+        const Work dfdh  = gL - div_work<Policy>(G * (h0 - hL), Work(4) * h0 * h0 * gL) + gR - div_work<Policy>(G * (h0 - hR), Work(4) * h0 * h0 * gR);
+        const Work sqrt0 = sqrt_work<Policy>(h0);
+        const Work root  = sqrt0 - div_work<Policy>(f0, Work(2) * sqrt0 * dfdh);
+        h0               = root * root;
+      }
+      const Work rcp0 = div_work<Policy>(Work(1), h0);
+      const Work cM   = sqrt_work<Policy>(G * h0);
+      const Work u1M  = uL - (h0 - hL) * sqrt_work<Policy>(Work(0.5) * G * (rcp0 + rcpL));
+      const Work u2M  = uR + (h0 - hR) * sqrt_work<Policy>(Work(0.5) * G * (rcp0 + rcpR));
+      return {h0, u1M - cM, u2M + cM};
+    }
+
+    // One shock and one rarefaction: secant steps towards fMax
+    const Work rcpMin = max_work(rcpL, rcpR); // 1 / hMin
+    Work       h0     = hMin;
+    for (unsigned int iter = 0; iter < newtonIterations_; iter++) {
+      const Work f0 = delU + Work(2) * (sqrt_work<Policy>(G * h0) - cMax)
+                      + (h0 - hMin) * sqrt_work<Policy>(Work(0.5) * G * (div_work<Policy>(Work(1), h0) + rcpMin));
+      h0 = h0 - div_work<Policy>(f0 * (hMax - hMin), fMax - f0);
+    }
+    const Work cM = sqrt_work<Policy>(G * h0);
+    if (hL > hR) {
+      const Work w = uL + Work(2) * cL;
+      return {h0, w - Work(3) * cM, w - cM};
+    }
+    const Work w = uR - Work(2) * cR;
+    return {h0, w + cM, w + Work(3) * cM};
+  }
+
+  template <class Policy>
+  void AugumentedMixed<Policy>::computeNetUpdates(
+    const Work& hLTrueValue,
+    const Work& hRTrueValue,
+    const Work& huLTrueValue,
+    const Work& huRTrueValue,
+    const Work& bLTrueValue,
+    const Work& bRTrueValue,
+    Work&       hNetUpdateLeft,
+    Work&       hNetUpdateRight,
+    Work&       huNetUpdateLeft,
+    Work&       huNetUpdateRight,
+    Work&       maxEdgeSpeed
+  ) const {
+    hNetUpdateLeft = hNetUpdateRight = huNetUpdateLeft = huNetUpdateRight = Work(0);
+    maxEdgeSpeed                                                          = Work(0);
+
+    Work hL = hLTrueValue, hR = hRTrueValue, huL = huLTrueValue, huR = huRTrueValue, bL = bLTrueValue, bR = bRTrueValue;
+    if (hL <= dryTol_ && hR <= dryTol_) {
+      return;
+    }
+
+    // Velocities and momentum fluxes hu^2 + g/2 h^2, zero on dry sides
+    Work uL = Work(0), uR = Work(0), phiL = Work(0), phiR = Work(0);
+    if (hL > dryTol_) {
+      uL   = div_work<Policy>(huL, hL);
+      phiL = huL * uL + Work(0.5) * G * hL * hL;
+    } else {
+      hL = huL = Work(0);
+    }
+    if (hR > dryTol_) {
+      uR   = div_work<Policy>(huR, hR);
+      phiR = huR * uR + Work(0.5) * G * hR * hR;
+    } else {
+      hR = huR = Work(0);
+    }
+
+    // Dry neighbour: a wall if the water cannot rise above its bed, else inundation
+    bool wallLeft = false, wallRight = false;
+    if (hR <= dryTol_) {
+      const MiddleState wall = computeMiddleState(hL, hL, uL, -uL);
+      if (max_work(hL, wall.h) + bL < bR) {
+        wallRight = true;
+        hR        = hL;
+        huR       = -huL;
+        uR        = -uL;
+        phiR      = phiL;
+        bR        = bL;
+      } else if (hL + bL < bR) {
+        bR = hL + bL;
+      }
+    } else if (hL <= dryTol_) {
+      const MiddleState wall = computeMiddleState(hR, hR, -uR, uR);
+      if (max_work(hR, wall.h) + bR < bL) {
+        wallLeft = true;
+        hL       = hR;
+        huL      = -huR;
+        uL       = -uR;
+        phiL     = phiR;
+        bL       = bR;
+      } else if (hR + bR < bL) {
+        bL = hR + bR;
+      }
+    }
+
+    // Einfeldt speeds from the cell states and the Roe averages
+    const Work cL   = sqrt_work<Policy>(G * hL);
+    const Work cR   = sqrt_work<Policy>(G * hR);
+    const Work uHat = div_work<Policy>(cL * uL + cR * uR, cL + cR);
+    const Work cHat = sqrt_work<Policy>(Work(0.5) * G * (hL + hR));
+
+    // Modified by the middle state speeds
+    const MiddleState middle = computeMiddleState(hL, hR, uL, uR, cL, cR);
+    const Work        sE1    = min_work(min_work(uL - cL, uHat - cHat), middle.s2);
+    const Work        sE3    = max_work(max_work(uR + cR, uHat + cHat), middle.s1);
+    const Work        sE2    = Work(0.5) * (sE1 + sE3);
+    const Work        rcpSpan = div_work<Policy>(Work(1), sE3 - sE1);
+
+    // Steady-state wave: jumps in h and phi that balance the bathymetry source (none on a flat bed)
+    const Work delB      = bR - bL;
+    Work       delDelH   = Work(0);
+    Work       delDelPhi = Work(0);
+    if (delB != Work(0)) {
+      const Work hStar     = max_work(Work(0), (huL - huR + sE3 * hR - sE1 * hL) * rcpSpan);
+      const Work hBar      = Work(0.5) * (hL + hR);
+      const Work s1s2Bar   = Work(0.25) * (uL + uR) * (uL + uR) - G * hBar;
+      const Work s1s2Tilde = max_work(Work(0), uL * uR) - G * hBar;
+
+      const bool sonic = std::abs(s1s2Bar) <= CriticalTol || s1s2Bar * s1s2Tilde <= CriticalTol || s1s2Bar * sE1 * sE3 <= CriticalTol
+                         || min_work(std::abs(sE1), std::abs(sE3)) < CriticalTol || (sE1 < Work(0) && middle.s1 > Work(0))
+                         || (sE3 > Work(0) && middle.s2 < Work(0)) || (uL + cL) * (uR + cR) < Work(0) || (uL - cL) * (uR - cR) < Work(0);
+
+      const Work steady = sonic ? Work(0) : div_work<Policy>(delB * G * hBar, s1s2Bar);
+      delDelH           = sonic ? -delB : steady;
+      delDelPhi         = sonic ? -G * hBar * delB : -steady * s1s2Tilde;
+
+      // Bounds for critical state resonance and negative middle states
+      if (sE1 < -CriticalTol && sE3 > CriticalTol) {
+        delDelH = min_work(delDelH, div_work<Policy>(hStar * (sE3 - sE1), sE3));
+        delDelH = max_work(delDelH, div_work<Policy>(hStar * (sE3 - sE1), sE1));
+      } else if (sE1 >= CriticalTol) {
+        delDelH = min_work(delDelH, div_work<Policy>(hStar * (sE3 - sE1), sE1));
+        delDelH = max_work(delDelH, -hL);
+      } else if (sE3 <= -CriticalTol) {
+        delDelH = min_work(delDelH, hR);
+        delDelH = max_work(delDelH, div_work<Policy>(hStar * (sE3 - sE1), sE3));
+      }
+      delDelPhi = min_work(delDelPhi, G * max_work(-hL * delB, -hR * delB));
+      delDelPhi = max_work(delDelPhi, G * min_work(-hL * delB, -hR * delB));
+    }
+
+    // Decompose into the eigenvectors (1, s1, s1^2), (0, 0, 1) and (1, s3, s3^2)
+    const Work del1  = (hR - hL) - delDelH;
+    const Work del2  = huR - huL;
+    const Work del3  = (phiR - phiL) - delDelPhi;
+    const Work beta1 = (sE3 * del1 - del2) * rcpSpan;
+    const Work beta3 = (del2 - sE1 * del1) * rcpSpan;
+    const Work beta2 = del3 - sE1 * sE1 * beta1 - sE3 * sE3 * beta3;
+
+    // f-waves (mass and momentum flux), dropped on the side of a wall
+    const Work speeds[3]  = {wallLeft ? Work(0) : sE1, (wallLeft || wallRight) ? Work(0) : sE2, wallRight ? Work(0) : sE3};
+    const Work hWaves[3]  = {wallLeft ? Work(0) : beta1 * sE1, Work(0), wallRight ? Work(0) : beta3 * sE3};
+    const Work huWaves[3] = {
+      wallLeft ? Work(0) : beta1 * sE1 * sE1, (wallLeft || wallRight) ? Work(0) : beta2, wallRight ? Work(0) : beta3 * sE3 * sE3};
+
+    for (int w = 0; w < 3; w++) {
+      if (speeds[w] < Work(0)) {
+        hNetUpdateLeft += hWaves[w];
+        huNetUpdateLeft += huWaves[w];
+      } else if (speeds[w] > Work(0)) {
+        hNetUpdateRight += hWaves[w];
+        huNetUpdateRight += huWaves[w];
+      } else {
+        hNetUpdateLeft += Work(0.5) * hWaves[w];
+        huNetUpdateLeft += Work(0.5) * huWaves[w];
+        hNetUpdateRight += Work(0.5) * hWaves[w];
+        huNetUpdateRight += Work(0.5) * huWaves[w];
+      }
+      maxEdgeSpeed = max_work(maxEdgeSpeed, std::abs(speeds[w]));
+    }
+  }
+
+} // namespace Solvers
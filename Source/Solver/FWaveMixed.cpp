@@ -0,0 +1,13 @@
+/**
+* @file FWaveMixed.cpp
+* Explicit instantiations of the f-wave solver for all
+* precision policies.
+ */
+
+#include "FWaveMixed.hpp"
+
+#define INSTANTIATE_SOLVER(name, Policy, ARG) \
+  template class Solvers::FWaveMixed<Policy>; \
+  template class Solvers::FWaveMixed<Precision::Primed<Policy>>;
+
+SWE_PRECISION_POLICIES(INSTANTIATE_SOLVER, )
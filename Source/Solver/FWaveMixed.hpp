@@ -1,8 +1,152 @@
-//
-// Created by Lena Elisabeth Holtmannspötter on 28.08.25.
-//
+/**
+ * @file FWaveMixed.hpp
+ * F-wave solver (Bale et al. 2002) for the shallow water equations with
+ * bathymetry and reflecting dry cells.
+ *
+ * The solver is templated on a precision policy (see Tools/PrecisionPolicy.hpp)
+ * like Solvers::RusanovMixed: all arithmetic is done in Policy::Work, square
+ * roots and divisions use the accuracy tier Policy::math.
+ *
+ * The flux difference, including the bathymetry source term, is split into
+ * two f-waves that travel with the Einfeldt speeds. A dry neighbour acts as
+ * a reflecting wall. Solvers::AugumentedMixed adds a steady-state wave to
+ * this decomposition.
+ *
+ * References:
+ * - Bale, D. S., LeVeque, R. J., Mitran, S., Rossmanith, J. A. (2002).
+ *   A wave propagation method for conservation laws and balance laws with
+ *   spatially varying flux functions. SIAM J. Sci. Comput. 24(3), 955-978.
+ * - Einfeldt, B. (1988). On Godunov-type methods for gas dynamics.
+ *   SIAM J. Numer. Anal. 25(2), 294-318.
+ */
 
-#ifndef SWE1D_FWAVEMIXED_HPP
-#define SWE1D_FWAVEMIXED_HPP
+#pragma once
 
-#endif //SWE1D_FWAVEMIXED_HPP
+#include <cmath>
+
+#include "Tools/PrecisionPolicy.hpp"
+#include "Tools/RealMath.hpp"
+
+namespace Solvers {
+  template <class Policy>
+  class FWaveMixed {
+  public:
+    using Work = typename Policy::Work;
+
+    // Gravity, 1 for Precision::Primed policies (the multiplications fold away)
+    static constexpr Work G = Policy::G; // (m/s^2)
+
+    /**
+     * @param dryTol Depth below which a cell is dry
+     */
+    explicit FWaveMixed(Work dryTol = Work(Policy::DRY_TOL)):
+      dryTol_(dryTol) {}
+
+    /**
+     * @brief Net updates of the f-wave solver.
+     *
+     * Same interface as RusanovMixed::computeNetUpdates: each f-wave goes to
+     * the side its speed points to, waves with speed zero are split evenly.
+     * The dry side of a wet/dry edge gets no update.
+     */
+    void computeNetUpdates(
+      const Work& hLTrueValue, const Work& hRTrueValue,
+      const Work& huLTrueValue, const Work& huRTrueValue,
+      const Work& bLTrueValue, const Work& bRTrueValue,
+      Work& hNetUpdateLeft,
+      Work& hNetUpdateRight,
+      Work& huNetUpdateLeft,
+      Work& huNetUpdateRight,
+      Work& maxEdgeSpeed) const;
+
+    Work getDryTol() const { return dryTol_; }
+    void setDryTol(Work dryTol) { dryTol_ = dryTol; }
+
+  private:
+    Work dryTol_;
+
+    /** Adds the f-wave (strength, strength * speed) to the side the speed points to */
+    static void addWave(Work strength, Work speed, Work& hLeft, Work& hRight, Work& huLeft, Work& huRight) {
+      if (speed < Work(0)) {
+        hLeft  += strength;
+        huLeft += strength * speed;
+      } else if (speed > Work(0)) {
+        hRight  += strength;
+        huRight += strength * speed;
+      } else {
+        hLeft   += Work(0.5) * strength;
+        huLeft  += Work(0.5) * strength * speed;
+        hRight  += Work(0.5) * strength;
+        huRight += Work(0.5) * strength * speed;
+      }
+    }
+  };
+
+  template <class Policy>
+  void FWaveMixed<Policy>::computeNetUpdates(
+    const Work& hLTrueValue, const Work& hRTrueValue,
+    const Work& huLTrueValue, const Work& huRTrueValue,
+    const Work& bLTrueValue, const Work& bRTrueValue,
+    Work& hNetUpdateLeft,
+    Work& hNetUpdateRight,
+    Work& huNetUpdateLeft,
+    Work& huNetUpdateRight,
+    Work& maxEdgeSpeed) const
+  {
+    Work hL = hLTrueValue, hR = hRTrueValue;
+    Work huL = huLTrueValue, huR = huRTrueValue;
+    Work bL = bLTrueValue, bR = bRTrueValue;
+
+    hNetUpdateLeft = hNetUpdateRight = huNetUpdateLeft = huNetUpdateRight = Work(0);
+    maxEdgeSpeed = Work(0);
+
+    // Dry cells reflect the wet neighbour
+    const bool dryL = hL < dryTol_;
+    const bool dryR = hR < dryTol_;
+    if (dryL && dryR) {
+      return;
+    }
+    if (dryL) {
+      hL  = hR;
+      huL = -huR;
+      bL  = bR;
+    } else if (dryR) {
+      hR  = hL;
+      huR = -huL;
+      bR  = bL;
+    }
+
+    const Work uL = div_work<Policy>(huL, hL);
+    const Work uR = div_work<Policy>(huR, hR);
+
+    // Einfeldt speeds: the Roe speeds widened by the characteristic speeds of the cells
+    const Work sqrtHL = sqrt_work<Policy>(hL);
+    const Work sqrtHR = sqrt_work<Policy>(hR);
+    const Work uRoe   = div_work<Policy>(uL * sqrtHL + uR * sqrtHR, sqrtHL + sqrtHR);
+    const Work cRoe   = sqrt_work<Policy>(G * Work(0.5) * (hL + hR));
+    const Work s1     = min_work(uL - sqrt_work<Policy>(G * hL), uRoe - cRoe);
+    const Work s2     = max_work(uR + sqrt_work<Policy>(G * hR), uRoe + cRoe);
+
+    // Flux difference with the bathymetry source term
+    const Work fDif0 = huR - huL;
+    const Work fDif1 = huR * uR + Work(0.5) * G * hR * hR - (huL * uL + Work(0.5) * G * hL * hL)
+                     + Work(0.5) * G * (hL + hR) * (bR - bL);
+
+    const Work rcpSpeedDif = rcp_work<Policy>(s2 - s1);
+    const Work beta1       = (s2 * fDif0 - fDif1) * rcpSpeedDif;
+    const Work beta2       = (fDif1 - s1 * fDif0) * rcpSpeedDif;
+
+    addWave(beta1, s1, hNetUpdateLeft, hNetUpdateRight, huNetUpdateLeft, huNetUpdateRight);
+    addWave(beta2, s2, hNetUpdateLeft, hNetUpdateRight, huNetUpdateLeft, huNetUpdateRight);
+
+    // The wall gets no update
+    if (dryL) {
+      hNetUpdateLeft = huNetUpdateLeft = Work(0);
+    } else if (dryR) {
+      hNetUpdateRight = huNetUpdateRight = Work(0);
+    }
+
+    maxEdgeSpeed = max_work(std::abs(s1), std::abs(s2));
+  }
+
+} // namespace Solvers
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include "Tools/RealMath.hpp"
 #include "Tools/RealType.hpp"
 
 namespace Solvers {
@@ -48,10 +49,98 @@ namespace Solvers {
      RealType& huNetUpdateRight,
      RealType& maxEdgeSpeed);
 
+   /**
+    * @brief Branch-free computeNetUpdates.
+    *
+    * The two early returns (SL >= 0, SR <= 0) and the star-state ladder are
+    * blended with select_real; inside the fan only SM decides between the
+    * left and right star state. Denominators of discarded lanes are
+    * replaced by 1. Inline, so that loops over edges vectorize.
+    * Bit-identical to computeNetUpdates (wet states only, as that one).
+    */
+   inline void computeNetUpdatesBranchFree(
+     RealType hL, RealType hR,
+     RealType huL, RealType huR,
+     RealType bL, RealType bR,
+     RealType& hNetUpdateLeft,
+     RealType& hNetUpdateRight,
+     RealType& huNetUpdateLeft,
+     RealType& huNetUpdateRight,
+     RealType& maxEdgeSpeed) const;
+
    void applyBoundaryCondition(RealType& hL, RealType& hR, RealType& huL, RealType& huR, RealType& bL, RealType& bR);
 
 
  };
 
+ inline void HLLC::computeNetUpdatesBranchFree(
+   RealType hL, RealType hR,
+   RealType huL, RealType huR,
+   RealType bL, RealType bR,
+   RealType& hNetUpdateLeft,
+   RealType& hNetUpdateRight,
+   RealType& huNetUpdateLeft,
+   RealType& huNetUpdateRight,
+   RealType& maxEdgeSpeed) const
+ {
+   // Reflective/dry boundary handling (see applyBoundaryCondition)
+   const bool     wallL = bL >= 0.0;
+   const bool     wallR = !wallL && bR >= 0.0;
+   const RealType hL0 = hL, huL0 = huL, bL0 = bL;
+   hL  = select_real(wallL, hR, hL);
+   huL = select_real(wallL, -huR, huL);
+   bL  = select_real(wallL, bR, bL);
+   hR  = select_real(wallR, hL0, hR);
+   huR = select_real(wallR, -huL0, huR);
+   bR  = select_real(wallR, bL0, bR);
+
+   double source_term = -G * 0.5 * (hL+hR) * (bR-bL);
+
+   const RealType uL = (huL / hL);
+   const RealType uR = (huR / hR);
+   const RealType cL = sqrt_real(G * hL);
+   const RealType cR = sqrt_real(G * hR);
+
+   const RealType SL = min_real(uL - cL, uR - cR);
+   const RealType SR = max_real(uL + cL, uR + cR);
+
+   const bool right = SL >= 0.0;               // everything moves right: flux fL
+   const bool left  = !right && SR <= 0.0;     // everything moves left: flux fR
+   const bool fan   = !right && !left;
+
+   const RealType fL_h  = huL;
+   const RealType fL_hu = huL * uL + 0.5 * G * hL * hL;
+   const RealType fR_h  = huR;
+   const RealType fR_hu = huR * uR + 0.5 * G * hR * hR;
+
+   // Star states, only used inside the fan (SL < 0 < SR)
+   const RealType pL = 0.5 * G * hL * hL;
+   const RealType pR = 0.5 * G * hR * hR;
+   const RealType numerator   = huR * (SR - uR) - huL * (SL - uL) + (pL - pR);
+   const RealType denominator = hR  * (SR - uR) - hL  * (SL - uL);
+   const RealType SM = numerator / select_real(fan, denominator, RealType(1));
+
+   const RealType hL_star  = hL  * ((SL - uL) / select_real(fan, SL - SM, RealType(1)));
+   const RealType huL_star = hL_star * SM;
+   const RealType hR_star  = hR  * ((SR - uR) / select_real(fan, SR - SM, RealType(1)));
+   const RealType huR_star = hR_star * SM;
+
+   // SL <= 0 holds inside the fan, so 0 <= SM picks the left star state
+   const bool     leftStar = 0.0 <= SM;
+   const RealType hFan  = select_real(leftStar, fL_h  + SL * (hL_star  - hL),  fR_h  + SR * (hR_star  - hR));
+   const RealType huFan = select_real(leftStar, fL_hu + SL * (huL_star - huL), fR_hu + SR * (huR_star - huR));
+
+   // The left-moving case hands -fR to the left cell, as computeNetUpdates
+   hNetUpdateLeft  = select_real(right, fL_h,  select_real(left, -fR_h,  hFan));
+   huNetUpdateLeft = select_real(right, fL_hu, select_real(left, -fR_hu, huFan));
+   hNetUpdateRight  = -hNetUpdateLeft;
+   huNetUpdateRight = -huNetUpdateLeft;
+
+   huNetUpdateLeft -= source_term * 0.5;
+   huNetUpdateRight -= source_term * 0.5;
+
+   maxEdgeSpeed = select_real(right, SL, select_real(left, abs_real(SR), max_real(abs_real(SL), max_real(abs_real(SR), abs_real(SM)))));
+ }
+
 }
 
@@ -1,5 +1,13 @@
-//
-// Created by Lena Elisabeth Holtmannspötter on 27.08.25.
-//
+/**
+ * @file HLLCMixed.cpp
+ * Explicit instantiations of the wet/dry HLLC solver for all precision
+ * policies.
+ */
 
 #include "HLLCMixed.hpp"
+
+#define INSTANTIATE_SOLVER(name, Policy, ARG) \
+  template class Solvers::HLLCMixed<Policy>; \
+  template class Solvers::HLLCMixed<Precision::Primed<Policy>>;
+
+SWE_PRECISION_POLICIES(INSTANTIATE_SOLVER, )
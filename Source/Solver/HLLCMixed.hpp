@@ -1,16 +1,336 @@
-//
-// Created by Lena Elisabeth Holtmannspötter on 27.08.25.
-//
+/**
+ * @file HLLCMixed.hpp
+ * HLLC (Harten-Lax-van Leer-Contact) solver with hydrostatic reconstruction
+ * for shallow water equations with wetting & drying.
+ *
+ * The solver is templated on a precision policy (see Tools/PrecisionPolicy.hpp)
+ * like Solvers::RusanovMixed: all arithmetic is done in Policy::Work, square
+ * roots and divisions use the accuracy tier Policy::math.
+ *
+ * Unlike Solvers::HLLC every division is guarded: dry sides get zero
+ * velocity and the dry-front speeds u -+ 2c, so the solver is safe on
+ * shore lines without floating-point exception trapping. The bed enters
+ * through the hydrostatic reconstruction and its pressure correction,
+ * which keeps a lake at rest exactly at rest.
+ *
+ * References:
+ * - Toro, E. F. (1999). Riemann Solvers and Numerical Methods for Fluid Dynamics (2nd ed.). Springer.
+ * - Toro, E. F., Spruce, M., Speares, W. (1994). Restoration of the contact surface in the HLL-Riemann solver.
+ * - Audusse, E., Bouchut, F., Bristeau, M.-O., Klein, R., Perthame, B. (2004).
+ *   A fast and stable well-balanced scheme with hydrostatic reconstruction for shallow water flows.
+ */
 
-#ifndef SWE1D_HLLCMIXED_HPP
-#define SWE1D_HLLCMIXED_HPP
+#pragma once
 
+#include <cmath>
 
+#include "Solver/HydrostaticReconstruction.hpp"
+#include "Tools/PrecisionPolicy.hpp"
+#include "Tools/RealMath.hpp"
 
-class HLLCMixed {
+namespace Solvers {
+  template <class Policy>
+  class HLLCMixed {
+  public:
+    using Work = typename Policy::Work;
 
-};
+    // Gravity, 1 for Precision::Primed policies (the multiplications fold away)
+    static constexpr Work G = Policy::G; // (m/s^2)
+    // Keeps a lake at rest over bed steps, so HybridSolver may route rough edges over a step here
+    static constexpr bool wellBalanced = true;
 
+    // Depth threshold for "dry" handling (positivity protection)
+    explicit HLLCMixed(Work h_min_ = Work(Policy::H_MIN)):
+      h_min(h_min_) {}
 
+    /**
+     * @brief HLLC flux with hydrostatic reconstruction.
+     *
+     * @param[in] hLTrueValue  Water height on left cell center
+     * @param[in] hRTrueValue  Water height on right cell center
+     * @param[in] huLTrueValue Water momentum on left cell center
+     * @param[in] huRTrueValue Water momentum on right cell center
+     * @param[in] bLTrueValue  Bathymetry at left cell center
+     * @param[in] bRTrueValue  Bathymetry at right cell center
+     * @param[out] hNetUpdateLeft   Net update for height to the left cell
+     * @param[out] hNetUpdateRight  Net update for height to the right cell
+     * @param[out] huNetUpdateLeft  Net update for momentum to the left cell
+     * @param[out] huNetUpdateRight Net update for momentum to the right cell
+     * @param[out] maxEdgeSpeed     Maximum signal speed at the interface (for CFL)
+     */
+    void computeNetUpdates(
+      const Work& hLTrueValue,
+      const Work& hRTrueValue,
+      const Work& huLTrueValue,
+      const Work& huRTrueValue,
+      const Work& bLTrueValue,
+      const Work& bRTrueValue,
+      Work&       hNetUpdateLeft,
+      Work&       hNetUpdateRight,
+      Work&       huNetUpdateLeft,
+      Work&       huNetUpdateRight,
+      Work&       maxEdgeSpeed
+    ) const;
 
-#endif //SWE1D_HLLCMIXED_HPP
+    /** @brief Static bathymetry terms of an edge (see HydrostaticReconstruction::computeEdgeBathymetry) */
+    static void computeEdgeBathymetry(Work bL, Work bR, Work& dropLeft, Work& dropRight, Work& deltaB, unsigned char& wall) {
+      HydrostaticReconstruction::computeEdgeBathymetry(bL, bR, dropLeft, dropRight, deltaB, wall);
+    }
+
+    /**
+     * @brief computeNetUpdates with precomputed bathymetry terms (see computeEdgeBathymetry).
+     *
+     * Bit-identical to computeNetUpdates with bL and bR; deltaB is not needed.
+     */
+    void computeNetUpdates(
+      const Work&   hLTrueValue,
+      const Work&   hRTrueValue,
+      const Work&   huLTrueValue,
+      const Work&   huRTrueValue,
+      Work          dropLeft,
+      Work          dropRight,
+      Work          deltaB,
+      unsigned char wall,
+      Work&         hNetUpdateLeft,
+      Work&         hNetUpdateRight,
+      Work&         huNetUpdateLeft,
+      Work&         huNetUpdateRight,
+      Work&         maxEdgeSpeed
+    ) const;
+
+    /**
+     * @brief Branch-free computeNetUpdates for count edges of an all-wet chunk.
+     *
+     * Same contract as RusanovMixed::computeWetNetUpdates: every cell is
+     * wet, no edge has a wall and the reconstructed depths stay positive.
+     * The wave-pattern cases are blended with select_work, denominators of
+     * discarded lanes are replaced by 1. Bit-identical to computeNetUpdates
+     * for such states.
+     *
+     * @param[out] maxEdgeSpeed Maximum signal speed of all edges
+     */
+    void computeWetNetUpdates(
+      unsigned int count,
+      const Work*  h,
+      const Work*  hu,
+      const Work*  dropLeft,
+      const Work*  dropRight,
+      const Work*  deltaB,
+      Work*        hNetUpdatesLeft,
+      Work*        hNetUpdatesRight,
+      Work*        huNetUpdatesLeft,
+      Work*        huNetUpdatesRight,
+      Work&        maxEdgeSpeed
+    ) const;
+
+    /// Getter/Setter for the dry threshold
+    Work getHMin() const { return h_min; }
+    void setHMin(Work v) { h_min = v; }
+
+  private:
+    Work h_min; // threshold below which a state is treated as dry
+  };
+
+  template <class Policy>
+  void HLLCMixed<Policy>::computeNetUpdates(
+    const Work& hLTrueValue,
+    const Work& hRTrueValue,
+    const Work& huLTrueValue,
+    const Work& huRTrueValue,
+    const Work& bLTrueValue,
+    const Work& bRTrueValue,
+    Work&       hNetUpdateLeft,
+    Work&       hNetUpdateRight,
+    Work&       huNetUpdateLeft,
+    Work&       huNetUpdateRight,
+    Work&       maxEdgeSpeed
+  ) const {
+    Work          dropLeft, dropRight, deltaB;
+    unsigned char wall;
+    computeEdgeBathymetry(bLTrueValue, bRTrueValue, dropLeft, dropRight, deltaB, wall);
+
+    computeNetUpdates(
+      hLTrueValue,
+      hRTrueValue,
+      huLTrueValue,
+      huRTrueValue,
+      dropLeft,
+      dropRight,
+      deltaB,
+      wall,
+      hNetUpdateLeft,
+      hNetUpdateRight,
+      huNetUpdateLeft,
+      huNetUpdateRight,
+      maxEdgeSpeed
+    );
+  }
+
+  template <class Policy>
+  void HLLCMixed<Policy>::computeNetUpdates(
+    const Work&   hLTrueValue,
+    const Work&   hRTrueValue,
+    const Work&   huLTrueValue,
+    const Work&   huRTrueValue,
+    Work          dropLeft,
+    Work          dropRight,
+    Work          /*deltaB*/,
+    unsigned char wall,
+    Work&         hNetUpdateLeft,
+    Work&         hNetUpdateRight,
+    Work&         huNetUpdateLeft,
+    Work&         huNetUpdateRight,
+    Work&         maxEdgeSpeed
+  ) const {
+    Work hL = hLTrueValue, hR = hRTrueValue, huL = huLTrueValue, huR = huRTrueValue;
+
+    // Reflective/dry boundary handling: mirror the other side
+    HydrostaticReconstruction::applyWall(wall, hL, hR, huL, huR);
+
+    // tiny depths: treat as dry
+    if (hL < h_min) {
+      hL = huL = Work(0);
+    }
+    if (hR < h_min) {
+      hR = huR = Work(0);
+    }
+
+    // Hydrostatic reconstruction, velocities of the cell states
+    const Work hLstar  = max_work(Work(0), hL + dropLeft);
+    const Work hRstar  = max_work(Work(0), hR + dropRight);
+    const Work uL      = hL > Work(0) ? div_work<Policy>(huL, hL) : Work(0);
+    const Work uR      = hR > Work(0) ? div_work<Policy>(huR, hR) : Work(0);
+    const Work huLstar = hLstar * uL;
+    const Work huRstar = hRstar * uR;
+
+    // Pressure correction of the reconstruction, this balances the bed slope
+    const Work pressureLeft  = (Work(0.5) * G) * (hL * hL - hLstar * hLstar);
+    const Work pressureRight = (Work(0.5) * G) * (hR * hR - hRstar * hRstar);
+
+    if (hLstar <= Work(0) && hRstar <= Work(0)) {
+      hNetUpdateLeft = hNetUpdateRight = Work(0);
+      huNetUpdateLeft                  = pressureLeft;
+      huNetUpdateRight                 = -pressureRight;
+      maxEdgeSpeed                     = Work(0);
+      return;
+    }
+
+    // Wave speeds (Davis), dry-front speeds next to a dry side (Toro 10.78)
+    const Work cL = sqrt_work<Policy>(G * hLstar);
+    const Work cR = sqrt_work<Policy>(G * hRstar);
+    Work       sL, sR;
+    if (hLstar <= Work(0)) {
+      sL = uR - Work(2) * cR;
+      sR = uR + cR;
+    } else if (hRstar <= Work(0)) {
+      sL = uL - cL;
+      sR = uL + Work(2) * cL;
+    } else {
+      sL = min_work(uL - cL, uR - cR);
+      sR = max_work(uL + cL, uR + cR);
+    }
+
+    const Work fL_h  = huLstar;
+    const Work fL_hu = huLstar * uL + (Work(0.5) * G) * hLstar * hLstar;
+    const Work fR_h  = huRstar;
+    const Work fR_hu = huRstar * uR + (Work(0.5) * G) * hRstar * hRstar;
+
+    Work hFlux, huFlux;
+    if (sL >= Work(0)) {
+      hFlux  = fL_h;
+      huFlux = fL_hu;
+    } else if (sR <= Work(0)) {
+      hFlux  = fR_h;
+      huFlux = fR_hu;
+    } else {
+      // Contact speed (Toro 10.37); the denominator is > 0 as one side is wet
+      const Work sM = div_work<Policy>(
+        huRstar * (sR - uR) - huLstar * (sL - uL) + (Work(0.5) * G) * (hLstar * hLstar - hRstar * hRstar),
+        hRstar * (sR - uR) - hLstar * (sL - uL)
+      );
+      if (sM >= Work(0)) {
+        const Work hStar = hLstar * div_work<Policy>(sL - uL, sL - sM);
+        hFlux            = fL_h + sL * (hStar - hLstar);
+        huFlux           = fL_hu + sL * (hStar * sM - huLstar);
+      } else {
+        const Work hStar = hRstar * div_work<Policy>(sR - uR, sR - sM);
+        hFlux            = fR_h + sR * (hStar - hRstar);
+        huFlux           = fR_hu + sR * (hStar * sM - huRstar);
+      }
+    }
+
+    hNetUpdateLeft   = hFlux;
+    hNetUpdateRight  = -hFlux;
+    huNetUpdateLeft  = huFlux + pressureLeft;
+    huNetUpdateRight = -huFlux - pressureRight;
+    maxEdgeSpeed     = max_work(std::abs(sL), std::abs(sR));
+  }
+
+  template <class Policy>
+  void HLLCMixed<Policy>::computeWetNetUpdates(
+    unsigned int count,
+    const Work*  h,
+    const Work*  hu,
+    const Work*  dropLeft,
+    const Work*  dropRight,
+    const Work* /*deltaB*/,
+    Work* hNetUpdatesLeft,
+    Work* hNetUpdatesRight,
+    Work* huNetUpdatesLeft,
+    Work* huNetUpdatesRight,
+    Work& maxEdgeSpeed
+  ) const {
+    Work maxSpeed = Work(0);
+
+    // Same arithmetic as computeNetUpdates without the dry and wall branches
+    for (unsigned int k = 0; k < count; k++) {
+      const Work hL = h[k], hR = h[k + 1], huL = hu[k], huR = hu[k + 1];
+
+      const Work hLstar  = max_work(Work(0), hL + dropLeft[k]);
+      const Work hRstar  = max_work(Work(0), hR + dropRight[k]);
+      const Work uL      = div_work<Policy>(huL, hL);
+      const Work uR      = div_work<Policy>(huR, hR);
+      const Work huLstar = hLstar * uL;
+      const Work huRstar = hRstar * uR;
+
+      const Work pressureLeft  = (Work(0.5) * G) * (hL * hL - hLstar * hLstar);
+      const Work pressureRight = (Work(0.5) * G) * (hR * hR - hRstar * hRstar);
+
+      const Work cL = sqrt_work<Policy>(G * hLstar);
+      const Work cR = sqrt_work<Policy>(G * hRstar);
+      const Work sL = min_work(uL - cL, uR - cR);
+      const Work sR = max_work(uL + cL, uR + cR);
+
+      const Work fL_h  = huLstar;
+      const Work fL_hu = huLstar * uL + (Work(0.5) * G) * hLstar * hLstar;
+      const Work fR_h  = huRstar;
+      const Work fR_hu = huRstar * uR + (Work(0.5) * G) * hRstar * hRstar;
+
+      const bool right = sL >= Work(0);
+      const bool left  = !right && sR <= Work(0);
+      const bool fan   = !right && !left;
+
+      const Work sM = div_work<Policy>(
+        huRstar * (sR - uR) - huLstar * (sL - uL) + (Work(0.5) * G) * (hLstar * hLstar - hRstar * hRstar),
+        hRstar * (sR - uR) - hLstar * (sL - uL)
+      );
+      const bool leftStar = sM >= Work(0);
+      const Work hStarL   = hLstar * div_work<Policy>(sL - uL, select_work(fan && leftStar, sL - sM, Work(1)));
+      const Work hStarR   = hRstar * div_work<Policy>(sR - uR, select_work(fan && !leftStar, sR - sM, Work(1)));
+
+      const Work hFan  = select_work(leftStar, fL_h + sL * (hStarL - hLstar), fR_h + sR * (hStarR - hRstar));
+      const Work huFan = select_work(leftStar, fL_hu + sL * (hStarL * sM - huLstar), fR_hu + sR * (hStarR * sM - huRstar));
+      const Work hFlux  = select_work(right, fL_h, select_work(left, fR_h, hFan));
+      const Work huFlux = select_work(right, fL_hu, select_work(left, fR_hu, huFan));
+
+      hNetUpdatesLeft[k]   = hFlux;
+      hNetUpdatesRight[k]  = -hFlux;
+      huNetUpdatesLeft[k]  = huFlux + pressureLeft;
+      huNetUpdatesRight[k] = -huFlux - pressureRight;
+      maxSpeed             = max_work(maxSpeed, max_work(std::abs(sL), std::abs(sR)));
+    }
+
+    maxEdgeSpeed = maxSpeed;
+  }
+
+} // namespace Solvers
@@ -1,5 +0,0 @@
-//
-// Created by Lena Elisabeth Holtmannspötter on 19.08.25.
-//
-
-#include "HLLCWetDry.hpp"
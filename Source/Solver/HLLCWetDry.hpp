@@ -1,16 +1,13 @@
-//
-// Created by Lena Elisabeth Holtmannspötter on 19.08.25.
-//
+/**
+ * @file HLLCWetDry.hpp
+ * HLLC solver with hydrostatic reconstruction in RealType (see HLLCMixed.hpp).
+ */
 
-#ifndef SWE1D_HLLCWETDRY_HPP
-#define SWE1D_HLLCWETDRY_HPP
+#pragma once
 
+#include "Solver/HLLCMixed.hpp"
 
-
-class HLLCWetDry {
-
-};
-
-
-
-#endif //SWE1D_HLLCWETDRY_HPP
+namespace Solvers {
+  /** The wet/dry HLLC solver with RealType arithmetic, e.g. for the RealType blocks */
+  using HLLCWetDry = HLLCMixed<Precision::RealTypePolicy>;
+} // namespace Solvers
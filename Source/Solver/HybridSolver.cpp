@@ -0,0 +1,13 @@
+/**
+* @file HybridSolver.cpp
+* Explicit instantiations of the hybrid Rusanov/Osher solver for all
+* precision policies.
+ */
+
+#include "HybridSolver.hpp"
+
+#define INSTANTIATE_SOLVER(name, Policy, ARG) \
+  template class Solvers::HybridSolver<Policy>; \
+  template class Solvers::HybridSolver<Precision::Primed<Policy>>;
+
+SWE_PRECISION_POLICIES(INSTANTIATE_SOLVER, )
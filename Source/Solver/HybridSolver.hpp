@@ -0,0 +1,192 @@
+/**
+* @file HybridSolver.hpp
+* Per-edge selection between the cheap Rusanov flux (RusanovMixed) and an
+* expensive solver on the same policy (default: OsherMixed).
+*
+* A division-free sensor marks an edge as "rough" if the surface jumps by
+* more than jumpTolerance relative to the depth, or if the flow is
+* transcritical (Froude number within sonicBand of 1 on one side, or 1
+* between the sides). Only rough edges are passed to the expensive solver.
+*
+* Edges with a dry neighbour always use RusanovMixed. Edges over a
+* bathymetry step go to the expensive solver only if it is well-balanced
+* (Expensive::wellBalanced, e.g. HLLCMixed and RoeMixed with their
+* hydrostatic reconstruction); OsherMixed ignores the bed, so with the
+* default they stay on RusanovMixed.
+*
+* The batch interface groups the edges of a chunk by solver, so that the
+* cheap edges run as one contiguous loop.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+#include "Solver/OsherMixed.hpp"
+#include "Solver/RusanovMixed.hpp"
+#include "Tools/PrecisionPolicy.hpp"
+
+namespace Solvers {
+  template <class Policy, class Expensive = OsherMixed<Policy>>
+  class HybridSolver {
+  public:
+    using Work = typename Policy::Work;
+
+    static_assert(std::is_same_v<typename Expensive::Work, Work>, "The expensive solver computes in the work precision of the policy");
+
+    /** The block passes whole chunks to computeNetUpdates(count, ...) */
+    static constexpr bool batched = true;
+    /** Maximum number of edges per batch */
+    static constexpr unsigned int MaxBatch = 64;
+
+    static constexpr Work G = Policy::G;
+
+    /** Whether edges over a bathymetry step may be rough */
+    static constexpr bool expensiveBathymetry = requires { requires Expensive::wellBalanced; };
+
+    /**
+     * @param jumpTolerance Relative surface jump above which an edge is rough; negative: every wet, flat edge
+     * @param sonicBand Half width of the Froude number band around 1 that is rough
+     */
+    explicit HybridSolver(Work jumpTolerance = Work(1e-2), Work sonicBand = Work(0.2)):
+      jumpTolerance_(jumpTolerance),
+      sonicBand_(sonicBand) {}
+
+    /**
+     * @return Whether the edge is routed to the expensive solver
+     */
+    bool isRough(Work hL, Work hR, Work huL, Work huR, Work bL, Work bR) const {
+      if (hL < Work(Policy::DRY_TOL) || hR < Work(Policy::DRY_TOL) || (bL != bR && !expensiveBathymetry)) {
+        return false;
+      }
+      // Surface jump; exactly the depth jump on a flat bed
+      if (std::abs(hR - hL + (bR - bL)) > jumpTolerance_ * std::max(hL, hR)) {
+        return true;
+      }
+
+      // Fr^2 = hu^2 / (G h^3), compared without dividing
+      const Work lower  = (Work(1) - sonicBand_) * (Work(1) - sonicBand_);
+      const Work upper  = (Work(1) + sonicBand_) * (Work(1) + sonicBand_);
+      const Work gh3L   = G * hL * hL * hL;
+      const Work gh3R   = G * hR * hR * hR;
+      const Work hu2L   = huL * huL;
+      const Work hu2R   = huR * huR;
+      const bool sonicL = hu2L >= lower * gh3L && hu2L <= upper * gh3L;
+      const bool sonicR = hu2R >= lower * gh3R && hu2R <= upper * gh3R;
+      return sonicL || sonicR || (hu2L - gh3L) * (hu2R - gh3R) < Work(0);
+    }
+
+    /**
+     * Net updates of one edge, see RusanovMixed::computeNetUpdates
+     */
+    void computeNetUpdates(
+      const Work& hL, const Work& hR,
+      const Work& huL, const Work& huR,
+      const Work& bL, const Work& bR,
+      Work& hNetUpdateLeft,
+      Work& hNetUpdateRight,
+      Work& huNetUpdateLeft,
+      Work& huNetUpdateRight,
+      Work& maxEdgeSpeed)
+    {
+      if (isRough(hL, hR, huL, huR, bL, bR)) {
+        expensive_.computeNetUpdates(hL, hR, huL, huR, bL, bR, hNetUpdateLeft, hNetUpdateRight, huNetUpdateLeft, huNetUpdateRight, maxEdgeSpeed);
+        expensiveEdges_++;
+      } else {
+        cheap_.computeNetUpdates(hL, hR, huL, huR, bL, bR, hNetUpdateLeft, hNetUpdateRight, huNetUpdateLeft, huNetUpdateRight, maxEdgeSpeed);
+        cheapEdges_++;
+      }
+    }
+
+    /**
+     * Net updates of count edges; edge k lies between the cells k and k+1
+     * of h, hu and b.
+     *
+     * @param maxEdgeSpeed Maximum signal speed of all edges
+     */
+    void computeNetUpdates(
+      unsigned int count,
+      const Work*  h,
+      const Work*  hu,
+      const Work*  b,
+      Work*        hNetUpdatesLeft,
+      Work*        hNetUpdatesRight,
+      Work*        huNetUpdatesLeft,
+      Work*        huNetUpdatesRight,
+      Work&        maxEdgeSpeed)
+    {
+      unsigned int cheap[MaxBatch], rough[MaxBatch];
+      unsigned int cheapCount = 0, roughCount = 0;
+      for (unsigned int k = 0; k < count; k++) {
+        if (isRough(h[k], h[k + 1], hu[k], hu[k + 1], b[k], b[k + 1])) {
+          rough[roughCount++] = k;
+        } else {
+          cheap[cheapCount++] = k;
+        }
+      }
+
+      // Cheap edges: gather into contiguous arrays, one loop, scatter back
+      Work hL[MaxBatch], hR[MaxBatch], huL[MaxBatch], huR[MaxBatch], bL[MaxBatch], bR[MaxBatch];
+      Work hOutL[MaxBatch], hOutR[MaxBatch], huOutL[MaxBatch], huOutR[MaxBatch], speed[MaxBatch];
+      for (unsigned int j = 0; j < cheapCount; j++) {
+        const unsigned int k = cheap[j];
+        hL[j]                = h[k];
+        hR[j]                = h[k + 1];
+        huL[j]               = hu[k];
+        huR[j]               = hu[k + 1];
+        bL[j]                = b[k];
+        bR[j]                = b[k + 1];
+      }
+      for (unsigned int j = 0; j < cheapCount; j++) {
+        cheap_.computeNetUpdates(hL[j], hR[j], huL[j], huR[j], bL[j], bR[j], hOutL[j], hOutR[j], huOutL[j], huOutR[j], speed[j]);
+      }
+
+      maxEdgeSpeed = Work(0);
+      for (unsigned int j = 0; j < cheapCount; j++) {
+        const unsigned int k = cheap[j];
+        hNetUpdatesLeft[k]   = hOutL[j];
+        hNetUpdatesRight[k]  = hOutR[j];
+        huNetUpdatesLeft[k]  = huOutL[j];
+        huNetUpdatesRight[k] = huOutR[j];
+        maxEdgeSpeed         = std::max(maxEdgeSpeed, speed[j]);
+      }
+
+      for (unsigned int j = 0; j < roughCount; j++) {
+        const unsigned int k         = rough[j];
+        Work               edgeSpeed = Work(0);
+        expensive_.computeNetUpdates(
+          h[k], h[k + 1], hu[k], hu[k + 1], b[k], b[k + 1],
+          hNetUpdatesLeft[k], hNetUpdatesRight[k], huNetUpdatesLeft[k], huNetUpdatesRight[k], edgeSpeed
+        );
+        maxEdgeSpeed = std::max(maxEdgeSpeed, edgeSpeed);
+      }
+
+      cheapEdges_ += cheapCount;
+      expensiveEdges_ += roughCount;
+    }
+
+    /// Edges computed by each solver since the last resetCounters()
+    unsigned long long getCheapEdges() const { return cheapEdges_; }
+    unsigned long long getExpensiveEdges() const { return expensiveEdges_; }
+    void resetCounters() { cheapEdges_ = expensiveEdges_ = 0; }
+
+    /// Getter/Setter for the sensor thresholds
+    Work getJumpTolerance() const { return jumpTolerance_; }
+    void setJumpTolerance(Work v) { jumpTolerance_ = v; }
+    Work getSonicBand() const { return sonicBand_; }
+    void setSonicBand(Work v) { sonicBand_ = v; }
+
+  private:
+    RusanovMixed<Policy> cheap_;
+    Expensive            expensive_;
+
+    Work jumpTolerance_;
+    Work sonicBand_;
+
+    unsigned long long cheapEdges_     = 0;
+    unsigned long long expensiveEdges_ = 0;
+  };
+
+} // namespace Solvers
@@ -0,0 +1,60 @@
+/**
+ * @file HydrostaticReconstruction.hpp
+ * Static bathymetry terms of the hydrostatic reconstruction, shared by the
+ * solvers that use it (RusanovMixed, HLLCMixed).
+ *
+ * References:
+ * - Audusse, E., Bouchut, F., Bristeau, M.-O., Klein, R., Perthame, B. (2004).
+ *   A fast and stable well-balanced scheme with hydrostatic reconstruction for shallow water flows.
+ */
+
+#pragma once
+
+#include "Tools/RealMath.hpp"
+
+namespace Solvers::HydrostaticReconstruction {
+
+  /// Wall (b >= 0) on one side of an edge: that side takes the mirrored other side
+  enum Wall : unsigned char { NoWall, LeftWall, RightWall };
+
+  /**
+   * @brief Static bathymetry terms of an edge.
+   *
+   * Bathymetry does not change during a run, so a block can compute these
+   * once per edge (see Blocks::WavePropagationBlockMixed).
+   *
+   * @param[out] dropLeft  bL - max(bL, bR) after the wall handling (<= 0)
+   * @param[out] dropRight bR - max(bL, bR) after the wall handling (<= 0)
+   * @param[out] deltaB    bR - bL after the wall handling (0 at a wall)
+   * @param[out] wall      Side whose state is replaced by the mirrored other side
+   */
+  template <class Work>
+  inline void computeEdgeBathymetry(Work bL, Work bR, Work& dropLeft, Work& dropRight, Work& deltaB, unsigned char& wall) {
+    wall = NoWall;
+    if (bL >= Work(0)) {
+      wall = LeftWall;
+      bL   = bR;
+    } else if (bR >= Work(0)) {
+      wall = RightWall;
+      bR   = bL;
+    }
+
+    const Work bmax = max_work(bL, bR);
+    dropLeft        = bL - bmax;
+    dropRight       = bR - bmax;
+    deltaB          = bR - bL;
+  }
+
+  /** Replaces the wall side of an edge by the mirrored other side */
+  template <class Work>
+  inline void applyWall(unsigned char wall, Work& hL, Work& hR, Work& huL, Work& huR) {
+    if (wall == LeftWall) {
+      hL  = hR;
+      huL = -huR;
+    } else if (wall == RightWall) {
+      hR  = hL;
+      huR = -huL;
+    }
+  }
+
+} // namespace Solvers::HydrostaticReconstruction
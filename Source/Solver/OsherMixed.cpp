@@ -1,5 +1,13 @@
-//
-// Created by Lena Elisabeth Holtmannspötter on 27.08.25.
-//
+/**
+* @file OsherMixed.cpp
+* Explicit instantiations of the Osher (Dumbser-Osher-Toro) solver for all
+* precision policies.
+ */
 
 #include "OsherMixed.hpp"
+
+#define INSTANTIATE_SOLVER(name, Policy, ARG) \
+  template class Solvers::OsherMixed<Policy>; \
+  template class Solvers::OsherMixed<Precision::Primed<Policy>>;
+
+SWE_PRECISION_POLICIES(INSTANTIATE_SOLVER, )
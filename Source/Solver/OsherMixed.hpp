@@ -1,16 +1,376 @@
-//
-// Created by Lena Elisabeth Holtmannspötter on 27.08.25.
-//
+/**
+* @file OsherMixed.hpp
+*
+*  Osher-type Solver for shallow water equations
+**
+*  This Osher (more specific Dumbser-Osher-Toro) solver is implemented using the theories and explanations provided by the following sources:
+*  Dumbser, M., Toro, E.F. A Simple Extension of the Osher Riemann Solver to Non-conservative Hyperbolic Systems. J Sci Comput 48, 70–88 (2011). https://doi.org/10.1007/s10915-010-9400-3
+*  Castro, M.J., Gallardo, J.M., Marquina, A. (2016). Approximate Osher-Solomon Schemes for Hyperbolic Systems. In: Ortegón Gallego, F., Redondo Neble, M., Rodríguez Galván, J. (eds) Trends in Differential Equations and Applications. SEMA SIMAI Springer Series, vol 8. Springer, Cham. https://doi.org/10.1007/978-3-319-32013-7_1
+*
+*  Furthermore, the following book was helpful:
+*  Toro, Eleuterio. (2009). Riemann Solvers and Numerical Methods for Fluid Dynamics: A Practical Introduction. https://doi.org/10.1007/b79761.
+*  Bachelorpraktikum - Lena Holtmannspötter, Jonathan Pins, Johannes Karrer
+*
+*  The solver is templated on a precision policy (see Tools/PrecisionPolicy.hpp)
+*  like Solvers::RusanovMixed: all arithmetic is done in Policy::Work, square
+*  roots and divisions use the accuracy tier Policy::math.
+ */
 
-#ifndef SWE1D_OSHERMIXED_HPP
-#define SWE1D_OSHERMIXED_HPP
+#pragma once
 
+#include <cmath>
 
+#include "Tools/PrecisionPolicy.hpp"
+#include "Tools/RealMath.hpp"
 
-class OsherMixed {
+namespace Solvers {
+  template <class Policy>
+  class OsherMixed {
+  public:
+    using Work = typename Policy::Work;
 
-};
+    // Gravity, 1 for Precision::Primed policies (the multiplications fold away)
+    static constexpr Work G = Policy::G; // (m/s^2)
+    // 3-point Gauss-Legendre rule on [0, 1]; sqrt(15) / 10 = 0.38729833462074168852
+    static constexpr Work weights[3] = { Work(5) / Work(18), Work(8) / Work(18), Work(5) / Work(18) };
+    static constexpr Work points[3] = { Work(0.5) - Work(0.38729833462074168852), Work(0.5), Work(0.5) + Work(0.38729833462074168852) };
 
+    /**
+     * Sign pattern of the eigenvalues u +- c along the linear path between two wet states
+     */
+    enum class Path {
+      RightSupercritical, // u - c > 0 everywhere: |A| = A
+      LeftSupercritical,  // u + c < 0 everywhere: |A| = -A
+      Subcritical,        // u - c < 0 < u + c everywhere
+      Sonic               // an eigenvalue changes sign, or a side is dry
+    };
 
+    // Precision-dependent tolerances of the policy
+    static constexpr Work H_MIN   = Work(Policy::H_MIN);
+    static constexpr Work DRY_TOL = Work(Policy::DRY_TOL);
+    static constexpr Work EPS_LAM = Work(Policy::EPS_LAM);
 
-#endif //SWE1D_OSHERMIXED_HPP
+    /**
+     * Net updates from the Osher integral of |A| along the linear path.
+     *
+     * On supercritical paths the integral is F(qR) - F(qL) up to the sign,
+     * so the flux is the upwind flux in closed form. Subcritical paths use
+     * the quadrature with |A| = (u/c) A + ((c^2 - u^2)/c) I, which needs no
+     * eigenvalue difference. Only sonic and dry edges run the general
+     * quadrature (computeNetUpdatesQuadrature).
+     */
+    void computeNetUpdates(
+      const Work& hLTrueValue, const Work& hRTrueValue,
+      const Work& huLTrueValue, const Work& huRTrueValue,
+      const Work& bLTrueValue, const Work& bRTrueValue,
+      Work& hNetUpdateLeft,
+      Work& hNetUpdateRight,
+      Work& huNetUpdateLeft,
+      Work& huNetUpdateRight,
+      Work& maxEdgeSpeed);
+
+    /**
+     * Net updates from the 3-point quadrature of |A| for every edge
+     * (the reference for the fast paths of computeNetUpdates)
+     */
+    void computeNetUpdatesQuadrature(
+      const Work& hLTrueValue, const Work& hRTrueValue,
+      const Work& huLTrueValue, const Work& huRTrueValue,
+      const Work& bLTrueValue, const Work& bRTrueValue,
+      Work& hNetUpdateLeft,
+      Work& hNetUpdateRight,
+      Work& huNetUpdateLeft,
+      Work& huNetUpdateRight,
+      Work& maxEdgeSpeed);
+
+    /**
+     * Classifies the linear path between two states (after applyBoundaryCondition).
+     *
+     * The sign of u -+ c equals the sign of hu -+ sqrt(G) h^(3/2), which is
+     * concave (-) or convex (+) along the path: the endpoints decide where it
+     * cannot have an interior extremum, otherwise the extremum is evaluated.
+     */
+    Path classifyPath(Work hL, Work hR, Work huL, Work huR) const;
+
+    /**
+    *
+    * @param h parameter height to evaluate value of eigenvalues with
+    * @param hu parameter momentum to evaluate value of eigenvalues with
+    * @param eigenvalues destination of computed eigenvalues
+     */
+    void computeEigenvalues(Work h, Work hu, Work eigenvalues[2]);
+
+    /**
+    * Computes the value of the simple segment path between left and right state at point s
+    *
+    * @param hL height on left side
+    * @param hR height on right side
+    * @param huL momentum on left side
+    * @param huR momentum on right side
+    * @param bL bathymetry on left side (unused in this version of the solver)
+    * @param bR bathymetry on right side (unused in this version of the solver)
+    * @param s point where the segment path will be evaluated at
+    * @param resultQ state according to the chosen simple segment path at point s
+     */
+    void computeSegmentPath(Work hL, Work hR, Work huL, Work huR, Work bL, Work bR, Work s, Work resultQ[2]);
+
+    /**
+    * Computes the absolute Jacobian
+    *
+    * @param eigenvalues eigenvalues
+    * @param absoluteJacobian computed absolute Jacobian matrix will be stored here
+     */
+    void computeAbsoluteJacobian(Work eigenvalues[2], Work absoluteJacobian[2][2]);
+
+    void applyBoundaryCondition(Work& hL, Work& hR, Work& huL, Work& huR, Work& bL, Work& bR);
+  };
+
+  template <class Policy>
+  void OsherMixed<Policy>::computeNetUpdates(
+    const Work& hLTrueValue, const Work& hRTrueValue,
+    const Work& huLTrueValue, const Work& huRTrueValue,
+    const Work& bLTrueValue, const Work& bRTrueValue,
+    Work& hNetUpdateLeft,
+    Work& hNetUpdateRight,
+    Work& huNetUpdateLeft,
+    Work& huNetUpdateRight,
+    Work& maxEdgeSpeed)
+  {
+    // Local copies
+    Work hL = hLTrueValue, hR = hRTrueValue;
+    Work huL = huLTrueValue, huR = huRTrueValue;
+    Work bL = bLTrueValue,  bR = bRTrueValue;
+
+    applyBoundaryCondition(hL, hR, huL, huR, bL, bR);
+
+    const Path path = classifyPath(hL, hR, huL, huR);
+    if (path == Path::Sonic) {
+      computeNetUpdatesQuadrature(
+        hLTrueValue, hRTrueValue, huLTrueValue, huRTrueValue, bLTrueValue, bRTrueValue,
+        hNetUpdateLeft, hNetUpdateRight, huNetUpdateLeft, huNetUpdateRight, maxEdgeSpeed
+      );
+      return;
+    }
+
+    // Both sides are wet here (classifyPath)
+    const Work uL = div_work<Policy>(huL, hL);
+    const Work uR = div_work<Policy>(huR, hR);
+
+    Work flux0, flux1;
+    if (path != Path::Subcritical) {
+      // Upwind flux, signal speeds of the cell states
+      const bool right = path == Path::RightSupercritical;
+      flux0 = right ? huL : huR;
+      flux1 = right ? huL * uL + Work(0.5) * G * hL * hL : huR * uR + Work(0.5) * G * hR * hR;
+
+      maxEdgeSpeed = max_work(std::abs(uL) + sqrt_work<Policy>(G * hL), std::abs(uR) + sqrt_work<Policy>(G * hR));
+    } else {
+      // |A| = (u/c) A + ((c^2 - u^2)/c) I for u - c < 0 < u + c
+      Work integralResult[2][2] = {{0,0},{0,0}};
+      maxEdgeSpeed = 0;
+
+      for (int i = 0; i < 3; ++i) {
+        const Work h  = hL  + points[i] * (hR  - hL);
+        const Work hu = huL + points[i] * (huR - huL);
+        const Work u  = div_work<Policy>(hu, h);
+        const Work c2 = G * h;
+        const Work c  = sqrt_work<Policy>(c2);
+        const Work wc = div_work<Policy>(weights[i], c);
+
+        integralResult[0][0] += (c2 - u * u) * wc;
+        integralResult[0][1] += u * wc;
+        integralResult[1][0] += u * (c2 - u * u) * wc;
+        integralResult[1][1] += (u * u + c2) * wc;
+
+        maxEdgeSpeed = max_work(maxEdgeSpeed, std::abs(u) + c);
+      }
+
+      const Work deltaQ0 = Work(0.5) * (hR - hL);
+      const Work deltaQ1 = Work(0.5) * (huR - huL);
+
+      const Work fluxFunction0 = Work(0.5) * (huR + huL);
+      const Work fluxFunction1 = Work(0.5) * (huL * uL + huR * uR
+                                              + Work(0.5) * G * (hL * hL + hR * hR));
+
+      flux0 = fluxFunction0 - (integralResult[0][0] * deltaQ0 + integralResult[0][1] * deltaQ1);
+      flux1 = fluxFunction1 - (integralResult[1][0] * deltaQ0 + integralResult[1][1] * deltaQ1);
+    }
+
+    hNetUpdateLeft   =  flux0;
+    huNetUpdateLeft  =  flux1;
+    hNetUpdateRight  = -flux0;
+    huNetUpdateRight = -flux1;
+  }
+
+  template <class Policy>
+  typename OsherMixed<Policy>::Path OsherMixed<Policy>::classifyPath(Work hL, Work hR, Work huL, Work huR) const {
+    if (hL <= DRY_TOL || hR <= DRY_TOL) {
+      return Path::Sonic;
+    }
+
+    // phi(s) = hu(s) + sign * sqrt(G) h(s)^(3/2) has the sign of u + sign * c
+    const Work sqrtG  = sqrt_work<Policy>(G);
+    const Work sqrtHL = sqrt_work<Policy>(hL);
+    const Work sqrtHR = sqrt_work<Policy>(hR);
+    const Work phiL   = sqrtG * hL * sqrtHL; // sqrt(G) h^(3/2) = h c
+    const Work phiR   = sqrtG * hR * sqrtHR;
+
+    // u - c is concave: positive at both ends means positive everywhere
+    if (huL - phiL > 0 && huR - phiR > 0) {
+      return Path::RightSupercritical;
+    }
+    // u + c is convex: negative at both ends means negative everywhere
+    if (huL + phiL < 0 && huR + phiR < 0) {
+      return Path::LeftSupercritical;
+    }
+    if (!(huL + phiL > 0 && huR + phiR > 0 && huL - phiL < 0 && huR - phiR < 0)) {
+      return Path::Sonic;
+    }
+
+    // Interior extrema at d/ds = 0: sqrt(h*) = -+dhu / (1.5 sqrt(G) dh)
+    const Work dh = hR - hL;
+    if (dh == 0) {
+      return Path::Subcritical; // both are linear
+    }
+    const Work dhu    = huR - huL;
+    const Work sqrtLo = min_work(sqrtHL, sqrtHR);
+    const Work sqrtHi = max_work(sqrtHL, sqrtHR);
+    for (const Work sign : {Work(1), Work(-1)}) {
+      const Work sqrtH = div_work<Policy>(-sign * dhu, Work(1.5) * sqrtG * dh);
+      if (sqrtH > sqrtLo && sqrtH < sqrtHi) {
+        const Work h   = sqrtH * sqrtH;
+        const Work phi = huL + (h - hL) * div_work<Policy>(dhu, dh) + sign * sqrtG * h * sqrtH;
+        if (sign * phi <= 0) {
+          return Path::Sonic;
+        }
+      }
+    }
+    return Path::Subcritical;
+  }
+
+  template <class Policy>
+  void OsherMixed<Policy>::computeNetUpdatesQuadrature(
+    const Work& hLTrueValue, const Work& hRTrueValue,
+    const Work& huLTrueValue, const Work& huRTrueValue,
+    [[maybe_unused]] const Work& bLTrueValue, [[maybe_unused]] const Work& bRTrueValue,
+    Work& hNetUpdateLeft,
+    Work& hNetUpdateRight,
+    Work& huNetUpdateLeft,
+    Work& huNetUpdateRight,
+    Work& maxEdgeSpeed)
+  {
+    // Local copies
+    Work hL = hLTrueValue, hR = hRTrueValue;
+    Work huL = huLTrueValue, huR = huRTrueValue;
+    Work bL = bLTrueValue,  bR = bRTrueValue; // kept only to satisfy signature
+
+    // Optional: basic dry handling (no bathymetry logic)
+    applyBoundaryCondition(hL, hR, huL, huR, bL, bR);
+
+    // Guard tiny/negative
+    const Work hLpos = max_work(hL, H_MIN);
+    const Work hRpos = max_work(hR, H_MIN);
+
+    // Speeds from raw states (bathymetry-free)
+    const Work uL = (hL > DRY_TOL) ? div_work<Policy>(huL, hLpos) : Work(0);
+    const Work uR = (hR > DRY_TOL) ? div_work<Policy>(huR, hRpos) : Work(0);
+
+    // Osher integral of |A| along straight segment
+    Work integralResult[2][2] = {{0,0},{0,0}};
+    maxEdgeSpeed = 0;
+
+    for (int i = 0; i < 3; ++i) {
+      Work pathQ[2];
+      computeSegmentPath(hL, hR, huL, huR, bL, bR, points[i], pathQ);
+
+      Work eigenvalues[2] = {0,0};
+      computeEigenvalues(pathQ[0], pathQ[1], eigenvalues);
+
+      Work Aabs[2][2] = {{0,0},{0,0}};
+      computeAbsoluteJacobian(eigenvalues, Aabs);
+
+      integralResult[0][0] += Aabs[0][0] * weights[i];
+      integralResult[0][1] += Aabs[0][1] * weights[i];
+      integralResult[1][0] += Aabs[1][0] * weights[i];
+      integralResult[1][1] += Aabs[1][1] * weights[i];
+
+      maxEdgeSpeed = max_work(maxEdgeSpeed,
+                              max_work(std::abs(eigenvalues[0]), std::abs(eigenvalues[1])));
+    }
+
+    // Difference and arithmetic flux (no gravity/bathymetry correction)
+    const Work deltaQ0 = Work(0.5) * (hR - hL);
+    const Work deltaQ1 = Work(0.5) * (huR - huL);
+
+    Work fluxFunction0 = Work(0.5) * (huR + huL);
+    Work fluxFunction1 = Work(0.5) * (huL * uL + huR * uR
+                                      + Work(0.5) * G * (hL * hL + hR * hR));
+
+    Work flux0 = fluxFunction0 - (integralResult[0][0] * deltaQ0 + integralResult[0][1] * deltaQ1);
+    Work flux1 = fluxFunction1 - (integralResult[1][0] * deltaQ0 + integralResult[1][1] * deltaQ1);
+
+    // Return as net updates
+    hNetUpdateLeft   =  flux0;
+    huNetUpdateLeft  =  flux1;
+    hNetUpdateRight  = -flux0;
+    huNetUpdateRight = -flux1;
+  }
+
+  template <class Policy>
+  void OsherMixed<Policy>::computeSegmentPath(Work hL, Work hR, Work huL, Work huR,
+                                              [[maybe_unused]] Work bL, [[maybe_unused]] Work bR,
+                                              const Work s, Work resultQ[2]) {
+    resultQ[0] = hL  + s * (hR  - hL);
+    resultQ[1] = huL + s * (huR - huL);
+  }
+
+  template <class Policy>
+  void OsherMixed<Policy>::computeEigenvalues(Work h, Work hu, Work eigenvalues[2]) {
+    const Work hpos = max_work(h, H_MIN);
+    const Work u = (h > DRY_TOL) ? div_work<Policy>(hu, hpos) : Work(0);
+    const Work c = sqrt_work<Policy>(G * hpos);
+    eigenvalues[0] = u + c;
+    eigenvalues[1] = u - c;
+  }
+
+  template <class Policy>
+  void OsherMixed<Policy>::computeAbsoluteJacobian(Work eigenvalues[2], Work Aabs[2][2]) {
+    const Work a  = eigenvalues[0], b = eigenvalues[1];
+    const Work aa = std::abs(a),    bb = std::abs(b);
+    const Work d  = a - b;
+    const Work scale = max_work(max_work(Work(1), aa), bb);
+
+    if (std::abs(d) <= EPS_LAM * scale) {
+      const Work m = Work(0.5) * (aa + bb);
+      Aabs[0][0] = m; Aabs[0][1] = 0;
+      Aabs[1][0] = 0; Aabs[1][1] = m;
+      return;
+    }
+    Aabs[0][0] = div_work<Policy>(-b * aa + a * bb, d);
+    Aabs[0][1] = div_work<Policy>(aa - bb, d);
+    Aabs[1][0] = div_work<Policy>(a * b * (bb - aa), d);
+    Aabs[1][1] = div_work<Policy>(a * aa - b * bb, d);
+  }
+
+  // Now a no-bathymetry, minimal boundary/dry handler
+  template <class Policy>
+  void OsherMixed<Policy>::applyBoundaryCondition(Work& hL, Work& hR,
+                                                  Work& huL, Work& huR,
+                                                  [[maybe_unused]] Work& bL,
+                                                  [[maybe_unused]] Work& bR)
+  {
+    // Zero tiny depths/momenta; no use of bathymetry at all
+    if (hL < DRY_TOL) { hL = 0; huL = 0; }
+    if (hR < DRY_TOL) { hR = 0; huR = 0; }
+
+    // Optional: reflective at wet–dry interface (purely algebraic)
+    if (hL < DRY_TOL && hR >= DRY_TOL) {
+      hL  = hR;
+      huL = -huR;
+    } else if (hR < DRY_TOL && hL >= DRY_TOL) {
+      hR  = hL;
+      huR = -huL;
+    }
+  }
+
+} // namespace Solvers
@@ -0,0 +1,13 @@
+/**
+ * @file RoeMixed.cpp
+ * Explicit instantiations of the Roe solver for all precision
+ * policies.
+ */
+
+#include "RoeMixed.hpp"
+
+#define INSTANTIATE_SOLVER(name, Policy, ARG) \
+  template class Solvers::RoeMixed<Policy>; \
+  template class Solvers::RoeMixed<Precision::Primed<Policy>>;
+
+SWE_PRECISION_POLICIES(INSTANTIATE_SOLVER, )
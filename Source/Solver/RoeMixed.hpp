@@ -0,0 +1,370 @@
+/**
+ * @file RoeMixed.hpp
+ * Roe solver with Harten's entropy fix and hydrostatic reconstruction for
+ * shallow water equations with wetting & drying.
+ *
+ * The solver is templated on a precision policy (see Tools/PrecisionPolicy.hpp)
+ * like Solvers::RusanovMixed and plugs into Blocks::WavePropagationBlockMixed
+ * the same way. It is built for a low cost per edge at the accuracy of the
+ * f-wave solver: a wet edge that is not sonic takes three square roots and
+ * two divisions (the velocities and the Roe average share one each).
+ *
+ * The Roe linearization has no dry state, so an edge with one dry
+ * reconstructed side takes the HLL flux with the dry-front speeds instead.
+ *
+ * References:
+ * - Roe, P. L. (1981). Approximate Riemann solvers, parameter vectors, and difference schemes.
+ * - Harten, A., Hyman, J. M. (1983). Self adjusting grid methods for one-dimensional hyperbolic conservation laws.
+ * - Audusse, E., Bouchut, F., Bristeau, M.-O., Klein, R., Perthame, B. (2004).
+ *   A fast and stable well-balanced scheme with hydrostatic reconstruction for shallow water flows.
+ */
+
+#pragma once
+
+#include <cmath>
+
+#include "Solver/HydrostaticReconstruction.hpp"
+#include "Tools/PrecisionPolicy.hpp"
+#include "Tools/RealMath.hpp"
+
+namespace Solvers {
+  template <class Policy>
+  class RoeMixed {
+  public:
+    using Work = typename Policy::Work;
+
+    // Gravity, 1 for Precision::Primed policies (the multiplications fold away)
+    static constexpr Work G = Policy::G; // (m/s^2)
+    // Well-balanced by the hydrostatic reconstruction (see HybridSolver::expensiveBathymetry)
+    static constexpr bool wellBalanced = true;
+
+    // Depth threshold for "dry" handling (positivity protection)
+    explicit RoeMixed(Work h_min_ = Work(Policy::H_MIN)):
+      h_min(h_min_),
+      sqrtG(sqrt_work<Policy>(G)) {}
+
+    /**
+     * @brief Roe flux with entropy fix and hydrostatic reconstruction.
+     *
+     * @param[in] hLTrueValue  Water height on left cell center
+     * @param[in] hRTrueValue  Water height on right cell center
+     * @param[in] huLTrueValue Water momentum on left cell center
+     * @param[in] huRTrueValue Water momentum on right cell center
+     * @param[in] bLTrueValue  Bathymetry at left cell center
+     * @param[in] bRTrueValue  Bathymetry at right cell center
+     * @param[out] hNetUpdateLeft   Net update for height to the left cell
+     * @param[out] hNetUpdateRight  Net update for height to the right cell
+     * @param[out] huNetUpdateLeft  Net update for momentum to the left cell
+     * @param[out] huNetUpdateRight Net update for momentum to the right cell
+     * @param[out] maxEdgeSpeed     Maximum signal speed at the interface (for CFL)
+     */
+    void computeNetUpdates(
+      const Work& hLTrueValue,
+      const Work& hRTrueValue,
+      const Work& huLTrueValue,
+      const Work& huRTrueValue,
+      const Work& bLTrueValue,
+      const Work& bRTrueValue,
+      Work&       hNetUpdateLeft,
+      Work&       hNetUpdateRight,
+      Work&       huNetUpdateLeft,
+      Work&       huNetUpdateRight,
+      Work&       maxEdgeSpeed
+    ) const;
+
+    /** @brief Static bathymetry terms of an edge (see HydrostaticReconstruction::computeEdgeBathymetry) */
+    static void computeEdgeBathymetry(Work bL, Work bR, Work& dropLeft, Work& dropRight, Work& deltaB, unsigned char& wall) {
+      HydrostaticReconstruction::computeEdgeBathymetry(bL, bR, dropLeft, dropRight, deltaB, wall);
+    }
+
+    /**
+     * @brief computeNetUpdates with precomputed bathymetry terms (see computeEdgeBathymetry).
+     *
+     * Bit-identical to computeNetUpdates with bL and bR; deltaB is not needed.
+     */
+    void computeNetUpdates(
+      const Work&   hLTrueValue,
+      const Work&   hRTrueValue,
+      const Work&   huLTrueValue,
+      const Work&   huRTrueValue,
+      Work          dropLeft,
+      Work          dropRight,
+      Work          deltaB,
+      unsigned char wall,
+      Work&         hNetUpdateLeft,
+      Work&         hNetUpdateRight,
+      Work&         huNetUpdateLeft,
+      Work&         huNetUpdateRight,
+      Work&         maxEdgeSpeed
+    ) const;
+
+    /**
+     * @brief computeNetUpdates for count edges of an all-wet chunk.
+     *
+     * Same contract as RusanovMixed::computeWetNetUpdates. Every edge takes
+     * the Roe flux; the only branch left is the entropy fix of sonic edges.
+     * Bit-identical to computeNetUpdates for such states, as long as the
+     * compiler fuses no multiply-adds (CMakeLists.txt sets -ffp-contract=off).
+     *
+     * @param[out] maxEdgeSpeed Maximum signal speed of all edges
+     */
+    void computeWetNetUpdates(
+      unsigned int count,
+      const Work*  h,
+      const Work*  hu,
+      const Work*  dropLeft,
+      const Work*  dropRight,
+      const Work*  deltaB,
+      Work*        hNetUpdatesLeft,
+      Work*        hNetUpdatesRight,
+      Work*        huNetUpdatesLeft,
+      Work*        huNetUpdatesRight,
+      Work&        maxEdgeSpeed
+    ) const;
+
+    /**
+     * @brief |lambda| with Harten's entropy fix.
+     *
+     * Near a sonic point (the wave speed changes sign between the left and
+     * the right state) |lambda| is smoothed to (lambda^2 + delta^2) / (2 delta)
+     * with the Harten-Hyman width delta = max(0, lambda - lambdaL, lambdaR - lambda),
+     * which removes the expansion shocks of the plain Roe flux. Only sonic
+     * edges pay for the division; they are rare, so the branch predicts
+     * well also in the wet kernel.
+     */
+    static Work entropyFix(Work lambda, Work lambdaL, Work lambdaR) {
+      // No clamp of delta at 0: |lambda| < delta implies delta > 0, and the
+      // clamp would add a data-dependent branch on every edge
+      const Work delta = max_work(lambda - lambdaL, lambdaR - lambda);
+      const Work abs   = std::abs(lambda);
+      if (abs < delta) {
+        return div_work<Policy>(lambda * lambda + delta * delta, Work(2) * delta);
+      }
+      return abs;
+    }
+
+    /// Getter/Setter for the dry threshold
+    Work getHMin() const { return h_min; }
+    void setHMin(Work v) { h_min = v; }
+
+  private:
+    Work h_min; // threshold below which a state is treated as dry
+    Work sqrtG; // c = sqrtG * sqrt(h) shares the square root with the Roe average
+  };
+
+  template <class Policy>
+  void RoeMixed<Policy>::computeNetUpdates(
+    const Work& hLTrueValue,
+    const Work& hRTrueValue,
+    const Work& huLTrueValue,
+    const Work& huRTrueValue,
+    const Work& bLTrueValue,
+    const Work& bRTrueValue,
+    Work&       hNetUpdateLeft,
+    Work&       hNetUpdateRight,
+    Work&       huNetUpdateLeft,
+    Work&       huNetUpdateRight,
+    Work&       maxEdgeSpeed
+  ) const {
+    Work          dropLeft, dropRight, deltaB;
+    unsigned char wall;
+    computeEdgeBathymetry(bLTrueValue, bRTrueValue, dropLeft, dropRight, deltaB, wall);
+
+    computeNetUpdates(
+      hLTrueValue,
+      hRTrueValue,
+      huLTrueValue,
+      huRTrueValue,
+      dropLeft,
+      dropRight,
+      deltaB,
+      wall,
+      hNetUpdateLeft,
+      hNetUpdateRight,
+      huNetUpdateLeft,
+      huNetUpdateRight,
+      maxEdgeSpeed
+    );
+  }
+
+  template <class Policy>
+  void RoeMixed<Policy>::computeNetUpdates(
+    const Work&   hLTrueValue,
+    const Work&   hRTrueValue,
+    const Work&   huLTrueValue,
+    const Work&   huRTrueValue,
+    Work          dropLeft,
+    Work          dropRight,
+    Work          /*deltaB*/,
+    unsigned char wall,
+    Work&         hNetUpdateLeft,
+    Work&         hNetUpdateRight,
+    Work&         huNetUpdateLeft,
+    Work&         huNetUpdateRight,
+    Work&         maxEdgeSpeed
+  ) const {
+    Work hL = hLTrueValue, hR = hRTrueValue, huL = huLTrueValue, huR = huRTrueValue;
+
+    // Reflective/dry boundary handling: mirror the other side
+    HydrostaticReconstruction::applyWall(wall, hL, hR, huL, huR);
+
+    // tiny depths: treat as dry
+    if (hL < h_min) {
+      hL = huL = Work(0);
+    }
+    if (hR < h_min) {
+      hR = huR = Work(0);
+    }
+
+    // Hydrostatic reconstruction, velocities of the cell states
+    const Work hLstar  = max_work(Work(0), hL + dropLeft);
+    const Work hRstar  = max_work(Work(0), hR + dropRight);
+    Work uL = Work(0), uR = Work(0);
+    if (hL > Work(0) && hR > Work(0)) {
+      // One division for both velocities
+      const Work rcpDepths = div_work<Policy>(Work(1), hL * hR);
+      uL                   = huL * hR * rcpDepths;
+      uR                   = huR * hL * rcpDepths;
+    } else if (hL > Work(0)) {
+      uL = div_work<Policy>(huL, hL);
+    } else if (hR > Work(0)) {
+      uR = div_work<Policy>(huR, hR);
+    }
+    const Work huLstar = hLstar * uL;
+    const Work huRstar = hRstar * uR;
+
+    // Pressure correction of the reconstruction, this balances the bed slope
+    const Work pressureLeft  = (Work(0.5) * G) * (hL * hL - hLstar * hLstar);
+    const Work pressureRight = (Work(0.5) * G) * (hR * hR - hRstar * hRstar);
+
+    if (hLstar <= Work(0) && hRstar <= Work(0)) {
+      hNetUpdateLeft = hNetUpdateRight = Work(0);
+      huNetUpdateLeft                  = pressureLeft;
+      huNetUpdateRight                 = -pressureRight;
+      maxEdgeSpeed                     = Work(0);
+      return;
+    }
+
+    const Work sqrtHL = sqrt_work<Policy>(hLstar);
+    const Work sqrtHR = sqrt_work<Policy>(hRstar);
+    const Work cL     = sqrtG * sqrtHL;
+    const Work cR     = sqrtG * sqrtHR;
+
+    const Work fL_h  = huLstar;
+    const Work fL_hu = huLstar * uL + (Work(0.5) * G) * hLstar * hLstar;
+    const Work fR_h  = huRstar;
+    const Work fR_hu = huRstar * uR + (Work(0.5) * G) * hRstar * hRstar;
+
+    Work hFlux, huFlux;
+    if (hLstar > Work(0) && hRstar > Work(0)) {
+      // Roe averages and wave strengths
+      const Work sqrtSum = sqrtHL + sqrtHR;
+      const Work cRoe    = sqrt_work<Policy>((Work(0.5) * G) * (hLstar + hRstar));
+      const Work rcpBoth = div_work<Policy>(Work(1), sqrtSum * cRoe); // shared by uRoe and 1 / (2 cRoe)
+      const Work uRoe    = (sqrtHL * uL + sqrtHR * uR) * cRoe * rcpBoth;
+      const Work lambda1 = uRoe - cRoe;
+      const Work lambda2 = uRoe + cRoe;
+      const Work rcp2c   = Work(0.5) * sqrtSum * rcpBoth;
+      const Work dh      = hRstar - hLstar;
+      const Work dhu     = huRstar - huLstar;
+      const Work alpha1  = (lambda2 * dh - dhu) * rcp2c;
+      const Work alpha2  = (dhu - lambda1 * dh) * rcp2c;
+
+      const Work wave1 = entropyFix(lambda1, uL - cL, uR - cR) * alpha1;
+      const Work wave2 = entropyFix(lambda2, uL + cL, uR + cR) * alpha2;
+
+      hFlux        = Work(0.5) * (fL_h + fR_h) - Work(0.5) * (wave1 + wave2);
+      huFlux       = Work(0.5) * (fL_hu + fR_hu) - Work(0.5) * (wave1 * lambda1 + wave2 * lambda2);
+      maxEdgeSpeed = max_work(std::abs(lambda1), std::abs(lambda2));
+    } else {
+      // One side dry: HLL with the dry-front speeds (Toro 10.78)
+      const Work sL = hLstar > Work(0) ? uL - cL : uR - Work(2) * cR;
+      const Work sR = hLstar > Work(0) ? uL + Work(2) * cL : uR + cR;
+      if (sL >= Work(0)) {
+        hFlux  = fL_h;
+        huFlux = fL_hu;
+      } else if (sR <= Work(0)) {
+        hFlux  = fR_h;
+        huFlux = fR_hu;
+      } else {
+        const Work rcpSpan = div_work<Policy>(Work(1), sR - sL);
+        hFlux              = (sR * fL_h - sL * fR_h + sL * sR * (hRstar - hLstar)) * rcpSpan;
+        huFlux             = (sR * fL_hu - sL * fR_hu + sL * sR * (huRstar - huLstar)) * rcpSpan;
+      }
+      maxEdgeSpeed = max_work(std::abs(sL), std::abs(sR));
+    }
+
+    hNetUpdateLeft   = hFlux;
+    hNetUpdateRight  = -hFlux;
+    huNetUpdateLeft  = huFlux + pressureLeft;
+    huNetUpdateRight = -huFlux - pressureRight;
+  }
+
+  template <class Policy>
+  void RoeMixed<Policy>::computeWetNetUpdates(
+    unsigned int count,
+    const Work*  h,
+    const Work*  hu,
+    const Work*  dropLeft,
+    const Work*  dropRight,
+    const Work* /*deltaB*/,
+    Work* hNetUpdatesLeft,
+    Work* hNetUpdatesRight,
+    Work* huNetUpdatesLeft,
+    Work* huNetUpdatesRight,
+    Work& maxEdgeSpeed
+  ) const {
+    Work maxSpeed = Work(0);
+
+    // Same arithmetic as computeNetUpdates without the dry and wall branches
+    for (unsigned int k = 0; k < count; k++) {
+      const Work hL = h[k], hR = h[k + 1], huL = hu[k], huR = hu[k + 1];
+
+      const Work hLstar    = max_work(Work(0), hL + dropLeft[k]);
+      const Work hRstar    = max_work(Work(0), hR + dropRight[k]);
+      const Work rcpDepths = div_work<Policy>(Work(1), hL * hR);
+      const Work uL        = huL * hR * rcpDepths;
+      const Work uR        = huR * hL * rcpDepths;
+      const Work huLstar   = hLstar * uL;
+      const Work huRstar   = hRstar * uR;
+
+      const Work pressureLeft  = (Work(0.5) * G) * (hL * hL - hLstar * hLstar);
+      const Work pressureRight = (Work(0.5) * G) * (hR * hR - hRstar * hRstar);
+
+      const Work sqrtHL = sqrt_work<Policy>(hLstar);
+      const Work sqrtHR = sqrt_work<Policy>(hRstar);
+      const Work cL     = sqrtG * sqrtHL;
+      const Work cR     = sqrtG * sqrtHR;
+
+      const Work fL_hu = huLstar * uL + (Work(0.5) * G) * hLstar * hLstar;
+      const Work fR_hu = huRstar * uR + (Work(0.5) * G) * hRstar * hRstar;
+
+      const Work sqrtSum = sqrtHL + sqrtHR;
+      const Work cRoe    = sqrt_work<Policy>((Work(0.5) * G) * (hLstar + hRstar));
+      const Work rcpBoth = div_work<Policy>(Work(1), sqrtSum * cRoe); // shared by uRoe and 1 / (2 cRoe)
+      const Work uRoe    = (sqrtHL * uL + sqrtHR * uR) * cRoe * rcpBoth;
+      const Work lambda1 = uRoe - cRoe;
+      const Work lambda2 = uRoe + cRoe;
+      const Work rcp2c   = Work(0.5) * sqrtSum * rcpBoth;
+      const Work dh      = hRstar - hLstar;
+      const Work dhu     = huRstar - huLstar;
+      const Work alpha1  = (lambda2 * dh - dhu) * rcp2c;
+      const Work alpha2  = (dhu - lambda1 * dh) * rcp2c;
+
+      const Work wave1 = entropyFix(lambda1, uL - cL, uR - cR) * alpha1;
+      const Work wave2 = entropyFix(lambda2, uL + cL, uR + cR) * alpha2;
+
+      const Work hFlux  = Work(0.5) * (huLstar + huRstar) - Work(0.5) * (wave1 + wave2);
+      const Work huFlux = Work(0.5) * (fL_hu + fR_hu) - Work(0.5) * (wave1 * lambda1 + wave2 * lambda2);
+
+      hNetUpdatesLeft[k]   = hFlux;
+      hNetUpdatesRight[k]  = -hFlux;
+      huNetUpdatesLeft[k]  = huFlux + pressureLeft;
+      huNetUpdatesRight[k] = -huFlux - pressureRight;
+      maxSpeed             = max_work(maxSpeed, max_work(std::abs(lambda1), std::abs(lambda2)));
+    }
+
+    maxEdgeSpeed = maxSpeed;
+  }
+
+} // namespace Solvers
@@ -4,6 +4,10 @@
 * Rusanov (local Lax–Friedrichs) solver with hydrostatic reconstruction
 * for shallow water equations with wetting & drying.
 *
+* The solver is templated on a precision policy (see Tools/PrecisionPolicy.hpp):
+* all arithmetic is done in Policy::Work, square roots and divisions use the
+* accuracy tier Policy::math.
+*
 * References:
 * - Toro, E. F. (1999). Riemann Solvers and Numerical Methods for Fluid Dynamics (2nd ed.). Springer.
 * - Audusse, E., Bouchut, F., Bristeau, M.-O., Klein, R., Perthame, B. (2004).
@@ -12,20 +16,23 @@
 
 #pragma once
 
-#include "Tools/RealType.hpp"
+#include <iostream>
+
+#include "Solver/HydrostaticReconstruction.hpp"
+#include "Tools/PrecisionPolicy.hpp"
+#include "Tools/RealMath.hpp"
 
 namespace Solvers {
+  template <class Policy>
   class RusanovMixed {
   public:
-    // XXX Physical constant: gravity
-#ifdef SWE_PRIMED_SCALING
-    const ComputeType G = 1.; // (m/s^2)
-#else
-    const ComputeType G = 9.81; // (m/s^2)
-#endif
+    using Work = typename Policy::Work;
+
+    // Gravity, 1 for Precision::Primed policies (the multiplications fold away)
+    static constexpr Work G = Policy::G; // (m/s^2)
 
     // Depth threshold for "dry" handling (positivity protection)
-    explicit RusanovMixed(RealType h_min_ = RealType(1e-8)) : h_min(h_min_) {}
+    explicit RusanovMixed(Work h_min_ = Work(Policy::H_MIN)) : h_min(h_min_) {}
 
     /**
      * @brief Rusanov (local Lax–Friedrichs) flux with hydrostatic reconstruction.
@@ -47,28 +54,339 @@ namespace Solvers {
      * @param[out] maxEdgeSpeed     Maximum signal speed at the interface (for CFL)
      */
     void computeNetUpdates(
-      const ComputeType& hLTrueValue, const ComputeType& hRTrueValue,
-      const ComputeType& huLTrueValue, const ComputeType& huRTrueValue,
-      const ComputeType& bLTrueValue, const ComputeType& bRTrueValue,
-      ComputeType& hNetUpdateLeft,
-      ComputeType& hNetUpdateRight,
-      ComputeType& huNetUpdateLeft,
-      ComputeType& huNetUpdateRight,
-      ComputeType& maxEdgeSpeed);
+      const Work& hLTrueValue, const Work& hRTrueValue,
+      const Work& huLTrueValue, const Work& huRTrueValue,
+      const Work& bLTrueValue, const Work& bRTrueValue,
+      Work& hNetUpdateLeft,
+      Work& hNetUpdateRight,
+      Work& huNetUpdateLeft,
+      Work& huNetUpdateRight,
+      Work& maxEdgeSpeed);
+
+    /**
+     * @brief Static bathymetry terms of an edge (see HydrostaticReconstruction::computeEdgeBathymetry).
+     *
+     * A block can compute these once per edge and pass them to the
+     * overloads below instead of bL, bR.
+     */
+    static void computeEdgeBathymetry(Work bL, Work bR, Work& dropLeft, Work& dropRight, Work& deltaB, unsigned char& wall) {
+      HydrostaticReconstruction::computeEdgeBathymetry(bL, bR, dropLeft, dropRight, deltaB, wall);
+    }
+
+    /**
+     * @brief computeNetUpdates with precomputed bathymetry terms (see computeEdgeBathymetry).
+     *
+     * Bit-identical to computeNetUpdates with bL and bR.
+     */
+    void computeNetUpdates(
+      const Work& hLTrueValue, const Work& hRTrueValue,
+      const Work& huLTrueValue, const Work& huRTrueValue,
+      Work dropLeft, Work dropRight, Work deltaB, unsigned char wall,
+      Work& hNetUpdateLeft,
+      Work& hNetUpdateRight,
+      Work& huNetUpdateLeft,
+      Work& huNetUpdateRight,
+      Work& maxEdgeSpeed);
+
+    /**
+     * @brief Branch-free computeNetUpdates for count edges of an all-wet chunk.
+     *
+     * Edge k lies between the cells k and k+1 of h and hu and has the
+     * bathymetry terms dropLeft[k], dropRight[k] and deltaB[k]. The caller
+     * guarantees that every cell is wet (h >= h_min), that no edge has a
+     * wall and that the bathymetry varies by less than the smallest depth,
+     * so that the reconstructed depths stay positive. The results equal
+     * those of computeNetUpdates for such states.
+     *
+     * @param[out] maxEdgeSpeed Maximum signal speed of all edges
+     */
+    void computeWetNetUpdates(
+      unsigned int count,
+      const Work*  h,
+      const Work*  hu,
+      const Work*  dropLeft,
+      const Work*  dropRight,
+      const Work*  deltaB,
+      Work*        hNetUpdatesLeft,
+      Work*        hNetUpdatesRight,
+      Work*        huNetUpdatesLeft,
+      Work*        huNetUpdatesRight,
+      Work&        maxEdgeSpeed);
+
+    /**
+     * @brief Branch-free computeNetUpdates.
+     *
+     * The wall, dry and sanitize cases are blended with select_work instead
+     * of early returns, divisions use a denominator of 1 in the lanes whose
+     * result is discarded. Inline, so that loops over edges vectorize.
+     * Bit-identical to computeNetUpdates.
+     */
+    inline void computeNetUpdatesBranchFree(
+      Work hL, Work hR,
+      Work huL, Work huR,
+      Work bL, Work bR,
+      Work& hNetUpdateLeft,
+      Work& hNetUpdateRight,
+      Work& huNetUpdateLeft,
+      Work& huNetUpdateRight,
+      Work& maxEdgeSpeed) const;
 
     /**
      * @brief Apply reflecting boundary condition when one side is marked "dry" by bathymetry flag.
      */
     void applyBoundaryCondition(
-      ComputeType& hL, ComputeType& hR,
-      ComputeType& huL, ComputeType& huR,
-      ComputeType& bL, ComputeType& bR);
+      Work& hL, Work& hR,
+      Work& huL, Work& huR,
+      Work& bL, Work& bR);
 
     /// Getter/Setter for the dry threshold
-    RealType getHMin() const { return h_min; }
-    void setHMin(RealType v) { h_min = v; }
+    Work getHMin() const { return h_min; }
+    void setHMin(Work v) { h_min = v; }
 
   private:
-    RealType h_min; // threshold below which a state is treated as dry
+    Work h_min; // threshold below which a state is treated as dry
   };
-}
+
+  template <class Policy>
+  void RusanovMixed<Policy>::computeNetUpdates(
+    const Work& hLTrueValue, const Work& hRTrueValue,
+    const Work& huLTrueValue, const Work& huRTrueValue,
+    const Work& bLTrueValue, const Work& bRTrueValue,
+    Work& hNetUpdateLeft,
+    Work& hNetUpdateRight,
+    Work& huNetUpdateLeft,
+    Work& huNetUpdateRight,
+    Work& maxEdgeSpeed)
+  {
+    Work          dropLeft, dropRight, deltaB;
+    unsigned char wall;
+    computeEdgeBathymetry(bLTrueValue, bRTrueValue, dropLeft, dropRight, deltaB, wall);
+
+    computeNetUpdates(
+      hLTrueValue, hRTrueValue, huLTrueValue, huRTrueValue, dropLeft, dropRight, deltaB, wall,
+      hNetUpdateLeft, hNetUpdateRight, huNetUpdateLeft, huNetUpdateRight, maxEdgeSpeed
+    );
+  }
+
+  template <class Policy>
+  void RusanovMixed<Policy>::computeNetUpdates(
+    const Work& hLTrueValue, const Work& hRTrueValue,
+    const Work& huLTrueValue, const Work& huRTrueValue,
+    Work dropLeft, Work dropRight, Work deltaB, unsigned char wall,
+    Work& hNetUpdateLeft,
+    Work& hNetUpdateRight,
+    Work& huNetUpdateLeft,
+    Work& huNetUpdateRight,
+    Work& maxEdgeSpeed)
+  {
+    // Local copies in work precision
+    Work hL  = hLTrueValue;
+    Work hR  = hRTrueValue;
+    Work huL = huLTrueValue;
+    Work huR = huRTrueValue;
+
+    // Reflective/dry boundary handling: mirror the other side
+    HydrostaticReconstruction::applyWall(wall, hL, hR, huL, huR);
+
+    // tiny depths: treat as dry
+    auto sanitize = [&](Work& h, Work& hu) {
+      if (h < h_min) { h = Work(0); hu = Work(0); }
+    };
+    sanitize(hL, huL);
+    sanitize(hR, huR);
+
+    // Hydrostatic reconstruction (Audusse et al. 2004)
+    const Work hLstar = max_work(Work(0), hL + dropLeft);
+    const Work hRstar = max_work(Work(0), hR + dropRight);
+
+    // Scale momentum consistently with reconstructed depth
+    const Work huLstar = (hLstar > Work(0) && hL > Work(0))
+                           ? huL * div_work<Policy>(hLstar, hL) : Work(0);
+    const Work huRstar = (hRstar > Work(0) && hR > Work(0))
+                           ? huR * div_work<Policy>(hRstar, hR) : Work(0);
+
+    // If both reconstructed sides are dry → no flux, no source
+    if (hLstar <= Work(0) && hRstar <= Work(0)) {
+      hNetUpdateLeft = hNetUpdateRight = huNetUpdateLeft = huNetUpdateRight = Work(0);
+      maxEdgeSpeed = Work(0);
+      return;
+    }
+
+    // Velocities and wave speeds from reconstructed states
+    const Work uL = (hLstar > Work(0)) ? div_work<Policy>(huLstar, hLstar) : Work(0);
+    const Work uR = (hRstar > Work(0)) ? div_work<Policy>(huRstar, hRstar) : Work(0);
+    const Work cL = sqrt_work<Policy>(G * hLstar);
+    const Work cR = sqrt_work<Policy>(G * hRstar);
+
+    // Rusanov alpha = max(|u| + c)
+    const Work alpha = max_work(std::abs(uL) + cL, std::abs(uR) + cR);
+
+    // Physical fluxes from reconstructed states
+    const Work fL_h  = huLstar;
+    const Work fL_hu = huLstar * uL + (Work(0.5) * G) * hLstar * hLstar;
+    const Work fR_h  = huRstar;
+    const Work fR_hu = huRstar * uR + (Work(0.5) * G) * hRstar * hRstar;
+
+    // Rusanov (LLF) numerical flux
+    const Work hFlux  = Work(0.5) * (fL_h  + fR_h )
+                      - Work(0.5) * alpha * (hRstar  - hLstar);
+    const Work huFlux = Work(0.5) * (fL_hu + fR_hu)
+                      - Work(0.5) * alpha * (huRstar - huLstar);
+
+    // Well-balanced bed source term (split form) using reconstructed depths
+    const Work psi = -Work(0.5) * G * (hLstar + hRstar) * deltaB;
+
+    // Net updates (left gets +flux, right gets -flux), add bed split
+    hNetUpdateLeft   =  hFlux;
+    huNetUpdateLeft  =  huFlux - Work(0.5) * psi;
+    hNetUpdateRight  = -hFlux;
+    huNetUpdateRight = -huFlux - Work(0.5) * psi;
+
+    // CFL edge speed
+    maxEdgeSpeed = alpha;
+
+#ifdef DEBUG
+    std::cout << "RusanovMixed (" << Policy::name << "):\n"
+              << "  hL=" << static_cast<float>(hL) << ", huL=" << static_cast<float>(huL) << ", dropL=" << static_cast<float>(dropLeft) << "\n"
+              << "  hR=" << static_cast<float>(hR) << ", huR=" << static_cast<float>(huR) << ", dropR=" << static_cast<float>(dropRight) << "\n"
+              << "  hL*=" << static_cast<float>(hLstar) << ", huL*=" << static_cast<float>(huLstar)
+              << ", hR*=" << static_cast<float>(hRstar) << ", huR*=" << static_cast<float>(huRstar) << "\n"
+              << "  uL=" << static_cast<float>(uL) << ", uR=" << static_cast<float>(uR)
+              << ", cL=" << static_cast<float>(cL) << ", cR=" << static_cast<float>(cR) << ", alpha=" << static_cast<float>(alpha) << "\n"
+              << "  hFlux=" << static_cast<float>(hFlux) << ", huFlux=" << static_cast<float>(huFlux) << ", psi=" << static_cast<float>(psi) << "\n"
+              << "  hΔL=" << static_cast<float>(hNetUpdateLeft) << ", hΔR=" << static_cast<float>(hNetUpdateRight) << "\n"
+              << "  huΔL=" << static_cast<float>(huNetUpdateLeft) << ", huΔR=" << static_cast<float>(huNetUpdateRight) << "\n"
+              << "  maxEdgeSpeed=" << static_cast<float>(maxEdgeSpeed) << "\n\n";
+#endif
+  }
+
+  template <class Policy>
+  void RusanovMixed<Policy>::computeWetNetUpdates(
+    unsigned int count,
+    const Work*  h,
+    const Work*  hu,
+    const Work*  dropLeft,
+    const Work*  dropRight,
+    const Work*  deltaB,
+    Work*        hNetUpdatesLeft,
+    Work*        hNetUpdatesRight,
+    Work*        huNetUpdatesLeft,
+    Work*        huNetUpdatesRight,
+    Work&        maxEdgeSpeed)
+  {
+    Work maxSpeed = Work(0);
+
+    // Same arithmetic as computeNetUpdates without the dry and wall branches
+    for (unsigned int k = 0; k < count; k++) {
+      const Work hL = h[k], hR = h[k + 1], huL = hu[k], huR = hu[k + 1];
+
+      const Work hLstar  = max_work(Work(0), hL + dropLeft[k]);
+      const Work hRstar  = max_work(Work(0), hR + dropRight[k]);
+      const Work huLstar = huL * div_work<Policy>(hLstar, hL);
+      const Work huRstar = huR * div_work<Policy>(hRstar, hR);
+
+      const Work uL    = div_work<Policy>(huLstar, hLstar);
+      const Work uR    = div_work<Policy>(huRstar, hRstar);
+      const Work cL    = sqrt_work<Policy>(G * hLstar);
+      const Work cR    = sqrt_work<Policy>(G * hRstar);
+      const Work alpha = max_work(std::abs(uL) + cL, std::abs(uR) + cR);
+
+      const Work fL_hu = huLstar * uL + (Work(0.5) * G) * hLstar * hLstar;
+      const Work fR_hu = huRstar * uR + (Work(0.5) * G) * hRstar * hRstar;
+
+      const Work hFlux  = Work(0.5) * (huLstar + huRstar) - Work(0.5) * alpha * (hRstar - hLstar);
+      const Work huFlux = Work(0.5) * (fL_hu + fR_hu) - Work(0.5) * alpha * (huRstar - huLstar);
+      const Work psi    = -Work(0.5) * G * (hLstar + hRstar) * deltaB[k];
+
+      hNetUpdatesLeft[k]   = hFlux;
+      huNetUpdatesLeft[k]  = huFlux - Work(0.5) * psi;
+      hNetUpdatesRight[k]  = -hFlux;
+      huNetUpdatesRight[k] = -huFlux - Work(0.5) * psi;
+      maxSpeed             = max_work(maxSpeed, alpha);
+    }
+
+    maxEdgeSpeed = maxSpeed;
+  }
+
+  template <class Policy>
+  inline void RusanovMixed<Policy>::computeNetUpdatesBranchFree(
+    Work hL, Work hR,
+    Work huL, Work huR,
+    Work bL, Work bR,
+    Work& hNetUpdateLeft,
+    Work& hNetUpdateRight,
+    Work& huNetUpdateLeft,
+    Work& huNetUpdateRight,
+    Work& maxEdgeSpeed) const
+  {
+    // Reflective/dry boundary handling (see HydrostaticReconstruction)
+    const bool wallL = bL >= Work(0);
+    const bool wallR = !wallL && bR >= Work(0);
+    const Work hL0 = hL, huL0 = huL, bL0 = bL;
+    hL  = select_work(wallL, hR, hL);
+    huL = select_work(wallL, -huR, huL);
+    bL  = select_work(wallL, bR, bL);
+    hR  = select_work(wallR, hL0, hR);
+    huR = select_work(wallR, -huL0, huR);
+    bR  = select_work(wallR, bL0, bR);
+
+    // tiny depths: treat as dry
+    const bool wetL = !(hL < h_min);
+    const bool wetR = !(hR < h_min);
+    hL  = select_work(wetL, hL, Work(0));
+    huL = select_work(wetL, huL, Work(0));
+    hR  = select_work(wetR, hR, Work(0));
+    huR = select_work(wetR, huR, Work(0));
+
+    // Hydrostatic reconstruction (Audusse et al. 2004)
+    const Work bmax   = max_work(bL, bR);
+    const Work hLstar = max_work(Work(0), hL + (bL - bmax));
+    const Work hRstar = max_work(Work(0), hR + (bR - bmax));
+
+    const bool posL    = hLstar > Work(0);
+    const bool posR    = hRstar > Work(0);
+    const Work huLstar = select_work(posL && hL > Work(0), huL * div_work<Policy>(hLstar, select_work(hL > Work(0), hL, Work(1))), Work(0));
+    const Work huRstar = select_work(posR && hR > Work(0), huR * div_work<Policy>(hRstar, select_work(hR > Work(0), hR, Work(1))), Work(0));
+
+    // Velocities and wave speeds from reconstructed states
+    const Work uL = select_work(posL, div_work<Policy>(huLstar, select_work(posL, hLstar, Work(1))), Work(0));
+    const Work uR = select_work(posR, div_work<Policy>(huRstar, select_work(posR, hRstar, Work(1))), Work(0));
+    const Work cL = sqrt_work<Policy>(G * hLstar);
+    const Work cR = sqrt_work<Policy>(G * hRstar);
+
+    const Work alpha = max_work(std::abs(uL) + cL, std::abs(uR) + cR);
+
+    const Work fL_hu = huLstar * uL + (Work(0.5) * G) * hLstar * hLstar;
+    const Work fR_hu = huRstar * uR + (Work(0.5) * G) * hRstar * hRstar;
+
+    const Work hFlux  = Work(0.5) * (huLstar + huRstar) - Work(0.5) * alpha * (hRstar - hLstar);
+    const Work huFlux = Work(0.5) * (fL_hu + fR_hu) - Work(0.5) * alpha * (huRstar - huLstar);
+    const Work psi    = -Work(0.5) * G * (hLstar + hRstar) * (bR - bL);
+
+    // No flux and no source if both reconstructed sides are dry
+    const bool zero = !posL && !posR;
+    hNetUpdateLeft   = select_work(zero, Work(0), hFlux);
+    huNetUpdateLeft  = select_work(zero, Work(0), huFlux - Work(0.5) * psi);
+    hNetUpdateRight  = select_work(zero, Work(0), -hFlux);
+    huNetUpdateRight = select_work(zero, Work(0), -huFlux - Work(0.5) * psi);
+    maxEdgeSpeed     = select_work(zero, Work(0), alpha);
+  }
+
+  template <class Policy>
+  void RusanovMixed<Policy>::applyBoundaryCondition(
+    Work& hL, Work& hR,
+    Work& huL, Work& huR,
+    Work& bL, Work& bR)
+  {
+    if (bL >= Work(0)) {
+      hL  = hR;
+      huL = -huR;
+      bL  = bR;
+    } else if (bR >= Work(0)) {
+      hR  = hL;
+      huR = -huL;
+      bR  = bL;
+    }
+  }
+
+} // namespace Solvers
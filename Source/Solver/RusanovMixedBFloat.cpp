@@ -1,5 +0,0 @@
-//
-// Created by Lena Elisabeth Holtmannspötter on 26.08.25.
-//
-
-#include "RusanovMixedBFloat.hpp"
@@ -1,16 +1,13 @@
-//
-// Created by Lena Elisabeth Holtmannspötter on 26.08.25.
-//
+/**
+* @file RusanovMixedBFloat.hpp
+* Rusanov solver for bfloat16 storage (see RusanovMixed.hpp).
+ */
 
-#ifndef SWE1D_RUSANOVMIXEDBFLOAT_HPP
-#define SWE1D_RUSANOVMIXEDBFLOAT_HPP
+#pragma once
 
+#include "Solver/RusanovMixed.hpp"
 
-
-class RusanovMixedBFloat {
-
-};
-
-
-
-#endif //SWE1D_RUSANOVMIXEDBFLOAT_HPP
+namespace Solvers {
+  /** The Rusanov solver on the bf16 storage policy, computing in float */
+  using RusanovMixedBFloat = RusanovMixed<Precision::MixedBAggressive>;
+} // namespace Solvers
@@ -0,0 +1,48 @@
+/**
+ * @file SolverList.hpp
+ *
+ * The solvers of the policy-based block (Blocks/WavePropagationBlockMixed.hpp)
+ * as X-macros. The --solver registry and all explicit instantiations over
+ * (policy x solver) are generated from these lists, so a new solver is one
+ * line here (plus the instantiation of the solver class itself).
+ */
+
+#pragma once
+
+#include "Solver/AugumentedMixed.hpp"
+#include "Solver/FWaveMixed.hpp"
+#include "Solver/HLLCMixed.hpp"
+#include "Solver/HybridSolver.hpp"
+#include "Solver/OsherMixed.hpp"
+#include "Solver/RoeMixed.hpp"
+#include "Solver/RusanovMixed.hpp"
+#include "Tools/PrecisionPolicy.hpp"
+
+/**
+ * Calls X(name, Solver, ARG) for every solver, name as accepted by --solver
+ * and Solver the class template over the policy
+ */
+#define SWE_SOLVERS(X, ARG) \
+  X("rusanov", Solvers::RusanovMixed, ARG) \
+  X("hllc", Solvers::HLLCMixed, ARG) \
+  X("roe", Solvers::RoeMixed, ARG) \
+  X("osher", Solvers::OsherMixed, ARG) \
+  X("fwave", Solvers::FWaveMixed, ARG) \
+  X("augmented", Solvers::AugumentedMixed, ARG) \
+  X("hybrid", Solvers::HybridSolver, ARG)
+
+/** The solvers instantiated for Precision::Primed policies, like SWE_SOLVERS */
+#define SWE_PRIMED_SOLVERS(X, ARG) \
+  X("rusanov", Solvers::RusanovMixed, ARG) \
+  X("hybrid", Solvers::HybridSolver, ARG)
+
+/** Helper of SWE_POLICIES_AND_SOLVERS: every policy for one solver */
+#define SWE_SOLVER_POLICIES(name, Solver, X) SWE_PRECISION_POLICIES(X, Solver)
+
+/**
+ * Calls X(name, Policy, Solver) for every policy with every solver of
+ * SWE_SOLVERS; SWE_PRIMED_POLICIES_AND_SOLVERS likewise for the solvers of
+ * SWE_PRIMED_SOLVERS, X forms Precision::Primed<Policy> itself.
+ */
+#define SWE_POLICIES_AND_SOLVERS(X)        SWE_SOLVERS(SWE_SOLVER_POLICIES, X)
+#define SWE_PRIMED_POLICIES_AND_SOLVERS(X) SWE_PRIMED_SOLVERS(SWE_SOLVER_POLICIES, X)
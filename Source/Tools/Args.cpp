@@ -47,7 +47,21 @@ Tools::Args::Args(int argc, char** argv):
   scenarioName_('D'),
   h_(15.0, 10.0),
   huL_(0.0),
-  uR_(0.0) {
+  uR_(0.0),
+  precision_(),
+  tolerance_(1e-2),
+  shadowChunks_(-1),
+  primed_(false),
+  solver_(),
+  memoize_(false),
+  linear_(0.0),
+  semiImplicit_(false),
+  steadyTolerance_(0.0),
+  steadyWindow_(100),
+  sequenceLevels_(0),
+  pseudoTime_(false),
+  pararealSlices_(0),
+  endTime_(0.0) {
 
   const struct option longOptions[] = {
     {"width", required_argument, 0, 'w'},
@@ -57,12 +71,27 @@ Tools::Args::Args(int argc, char** argv):
     {"height", required_argument, 0, 'H'},
     {"momentum", required_argument, 0, 'M'},
     {"parVelo", required_argument, 0, 'P'},
+    {"precision", required_argument, 0, 'p'},
+    {"tolerance", required_argument, 0, 'T'},
+    {"shadow", required_argument, 0, 'C'},
+    {"primed", no_argument, 0, 'N'},
+    {"solver", required_argument, 0, 'R'},
+    {"hybrid", no_argument, 0, 'Y'},
+    {"memoize", no_argument, 0, 'm'},
+    {"linear", required_argument, 0, 'L'},
+    {"semi-implicit", no_argument, 0, 'I'},
+    {"steady-tol", required_argument, 0, 'E'},
+    {"steady-window", required_argument, 0, 'W'},
+    {"sequence", required_argument, 0, 'G'},
+    {"pseudo-time", no_argument, 0, 'Q'},
+    {"parareal", required_argument, 0, 'A'},
+    {"end-time", required_argument, 0, 'e'},
     {"help", no_argument, 0, 'h'},
     {0, 0, 0, 0}};
 
   int                c, optionIndex;
   std::istringstream ss;
-  while ((c = getopt_long(argc, argv, "w:s:t:S:H:M:P:h", longOptions, &optionIndex)) >= 0) {
+  while ((c = getopt_long(argc, argv, "w:s:t:S:H:M:P:p:T:C:NR:YmL:IE:W:G:QA:e:h", longOptions, &optionIndex)) >= 0) {
     switch (c) {
     case 0:
       Logger::logger.error("Could not parse command line arguments");
@@ -126,6 +155,77 @@ Tools::Args::Args(int argc, char** argv):
       ss.str(optarg);
       ss >> uR_;
       break;
+    case 'p':
+      precision_ = optarg;
+      std::cout << precision_ << std::endl;
+      break;
+    case 'T':
+      ss.clear();
+      ss.str(optarg);
+      ss >> tolerance_;
+      std::cout << tolerance_ << std::endl;
+      break;
+    case 'C':
+      ss.clear();
+      ss.str(optarg);
+      ss >> shadowChunks_;
+      std::cout << shadowChunks_ << std::endl;
+      break;
+    case 'N':
+      primed_ = true;
+      break;
+    case 'R':
+      solver_ = optarg;
+      std::cout << solver_ << std::endl;
+      break;
+    case 'Y':
+      solver_ = "hybrid";
+      break;
+    case 'm':
+      memoize_ = true;
+      break;
+    case 'L':
+      ss.clear();
+      ss.str(optarg);
+      ss >> linear_;
+      std::cout << linear_ << std::endl;
+      break;
+    case 'I':
+      semiImplicit_ = true;
+      break;
+    case 'E':
+      ss.clear();
+      ss.str(optarg);
+      ss >> steadyTolerance_;
+      std::cout << steadyTolerance_ << std::endl;
+      break;
+    case 'W':
+      ss.clear();
+      ss.str(optarg);
+      ss >> steadyWindow_;
+      std::cout << steadyWindow_ << std::endl;
+      break;
+    case 'G':
+      ss.clear();
+      ss.str(optarg);
+      ss >> sequenceLevels_;
+      std::cout << sequenceLevels_ << std::endl;
+      break;
+    case 'Q':
+      pseudoTime_ = true;
+      break;
+    case 'A':
+      ss.clear();
+      ss.str(optarg);
+      ss >> pararealSlices_;
+      std::cout << pararealSlices_ << std::endl;
+      break;
+    case 'e':
+      ss.clear();
+      ss.str(optarg);
+      ss >> endTime_;
+      std::cout << endTime_ << std::endl;
+      break;
     case 'h':
       printHelpMessage();
       exit(0);
@@ -157,6 +257,34 @@ RealType Tools::Args::getHuL() { return huL_; }
 
 RealType Tools::Args::getUR() { return uR_; }
 
+const std::string& Tools::Args::getPrecision() { return precision_; }
+
+RealType Tools::Args::getTolerance() { return tolerance_; }
+
+int Tools::Args::getShadowChunks() { return shadowChunks_; }
+
+bool Tools::Args::getPrimed() { return primed_; }
+
+const std::string& Tools::Args::getSolver() { return solver_; }
+
+bool Tools::Args::getMemoize() { return memoize_; }
+
+RealType Tools::Args::getLinear() { return linear_; }
+
+bool Tools::Args::getSemiImplicit() { return semiImplicit_; }
+
+RealType Tools::Args::getSteadyTolerance() { return steadyTolerance_; }
+
+unsigned int Tools::Args::getSteadyWindow() { return steadyWindow_; }
+
+unsigned int Tools::Args::getSequenceLevels() { return sequenceLevels_; }
+
+bool Tools::Args::getPseudoTime() { return pseudoTime_; }
+
+unsigned int Tools::Args::getPararealSlices() { return pararealSlices_; }
+
+RealType Tools::Args::getEndTime() { return endTime_; }
+
 void Tools::Args::printHelpMessage(std::ostream& out) {
   out
     << "Usage: SWE1D [OPTIONS...]" << std::endl
@@ -168,6 +296,7 @@ void Tools::Args::printHelpMessage(std::ostream& out) {
     << "                                  'S' : Shock-Shock/Rare-Rare"<< std::endl
     << "                                  'P' : Supercritical Flow"<< std::endl
     << "                                  'B' : Subcritical Flow" << std::endl
+    << "                                  'O' : Ocean to shelf (long-distance propagation)" << std::endl
     << "  -H, --height=HEIGHT          initial height for simulation in the following format: <hL>:<hR>" << std::endl
     << "  -M, --momentum=MOMENTUM      initial momentum of left side for simulation in the following format: <huL>," << std::endl
     << "                                  huR is defined as -huL," << std::endl
@@ -175,5 +304,46 @@ void Tools::Args::printHelpMessage(std::ostream& out) {
     << "  -P, --parVelo=PARVELO        initial particle speed of right side for simulation in the following format: <uR>," << std::endl
     << "                                  uL is defined as 0 in DamBreakScenario," << std::endl
     << "                                  will be ignored if scenario is not DamBreakScenario" << std::endl
+    << "  -p, --precision=PRECISION    precision policy, or a comma-separated list run back to back:" << std::endl
+    << "                                  double, float, mixedA, mixedB, mixedC," << std::endl
+    << "                                  mixedB-anomaly, mixedB-blockfloat, fixed32, fixed16" << std::endl
+    << "                                  auto: cheapest policy within --tolerance, chosen in a short calibration run" << std::endl
+    << "                                  with the selected --solver and --primed" << std::endl
+    << "                                  default: RealType (compile time) with the f-wave solver, or with --solver" << std::endl
+    << "                                  the policy matching RealType" << std::endl
+    << "  -T, --tolerance=TOLERANCE    error budget of --precision=auto: max. difference of h to double in m (default 0.01)," << std::endl
+    << "                                  also the divergence reported as first divergence by --shadow" << std::endl
+    << "  -C, --shadow=CHUNKS          with --precision: run a double shadow in lockstep on CHUNKS sampled chunks" << std::endl
+    << "                                  (0: whole domain) and write the divergence per step to <output>_shadow.txt" << std::endl
+    << "  -N, --primed                 with --precision: compute in nondimensional variables (g = 1, h and hu of order 1)" << std::endl
+    << "  -R, --solver=SOLVER          solver of the precision policies, default rusanov: SOLVER can be:" << std::endl
+    << "                                  rusanov, hllc, roe, osher, fwave, augmented," << std::endl
+    << "                                  hybrid: Rusanov on smooth edges, Osher on shocks and transcritical edges" << std::endl
+    << "                                  followed by parameters :KEY=VALUE, e.g. rusanov:hmin=1e-6" << std::endl
+    << "                                  (hmin: rusanov, hllc, roe; drytol: fwave, augmented; jump, sonic: hybrid)" << std::endl
+    << "                                  with --primed only rusanov and hybrid" << std::endl
+    << "  -Y, --hybrid                 same as --solver=hybrid" << std::endl
+    << "  -m, --memoize                with --precision or --solver: solve runs of identical edges once," << std::endl
+    << "                                  turns itself off once the state has become heterogeneous" << std::endl
+    << "  -L, --linear=RATIO           with --precision or --solver: linear flux on wet chunks whose amplitude-to-depth" << std::endl
+    << "                                  ratio and Froude number are below RATIO, e.g. 1e-3" << std::endl
+    << "  -I, --semi-implicit          with --precision or --solver: implicit gravity terms, the time step is bounded" << std::endl
+    << "                                  by the flow speed and at most ten explicit steps (wet subcritical runs)," << std::endl
+    << "                                  not with --shadow" << std::endl
+    << "  -E, --steady-tol=TOL         with --precision or --solver: stop once max |dh/dt|, |d(hu)/dt| of all cells" << std::endl
+    << "                                  stays below TOL for --steady-window steps, e.g. 1e-6; writes the residual" << std::endl
+    << "                                  per step to <output>_residual.txt" << std::endl
+    << "  -W, --steady-window=STEPS    steps the residual has to stay below --steady-tol (default 100)" << std::endl
+    << "  -G, --sequence=LEVELS        with --steady-tol: grid sequencing, converge on SIZE/2^LEVELS cells first and" << std::endl
+    << "                                  prolong grid by grid to SIZE cells, e.g. 3 (steady scenarios 'B' and 'P')," << std::endl
+    << "                                  not with --shadow" << std::endl
+    << "  -Q, --pseudo-time            with --steady-tol: every cell advances with its own maximum stable time step," << std::endl
+    << "                                  not time accurate; output times are pseudo-time; not with --semi-implicit" << std::endl
+    << "                                  or --shadow" << std::endl
+    << "  -A, --parareal=SLICES        with --precision or --solver and --end-time: parareal, SLICES time slices on" << std::endl
+    << "                                  one thread each, corrected by Rusanov on SIZE/4 cells until no slice end" << std::endl
+    << "                                  changes by more than 1e-6; --time is ignored; not with --shadow, --sequence," << std::endl
+    << "                                  --steady-tol, --semi-implicit or --pseudo-time" << std::endl
+    << "  -e, --end-time=TIME          simulated time of --parareal in s" << std::endl
     << "  -h, --help                   this help message" << std::endl;
 }
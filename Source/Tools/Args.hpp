@@ -38,6 +38,7 @@
 
 #include <iostream>
 #include <sstream>
+#include <string>
 
 #include "RealType.hpp"
 
@@ -62,6 +63,34 @@ namespace Tools {
     RealType huL_;
     /** Initial particle speed on right side to initialize basic scenarios with */
     RealType uR_;
+    /** Comma-separated precision policies to run; empty for the RealType block */
+    std::string precision_;
+    /** Error budget of --precision=auto: maximum difference of h to double in m */
+    RealType tolerance_;
+    /** Chunks followed by a double shadow (0: whole domain); negative for no shadow */
+    int shadowChunks_;
+    /** Run the precision policies in nondimensional variables (Precision::Primed) */
+    bool primed_;
+    /** Solver of the policy-based block with its parameters (see Simulation::SolverSpec); empty for the default */
+    std::string solver_;
+    /** Solve runs of identical edges once (see Simulation::RunOptions) */
+    bool memoize_;
+    /** Amplitude-to-depth ratio and Froude number of the linear deep-water region (see Simulation::RunOptions); 0 for none */
+    RealType linear_;
+    /** Semi-implicit gravity terms instead of a Riemann solver (see Simulation::RunOptions) */
+    bool semiImplicit_;
+    /** Residual below which a run counts as steady and stops (see Simulation::RunOptions); 0 for none */
+    RealType steadyTolerance_;
+    /** Steps the residual has to stay below the tolerance */
+    unsigned int steadyWindow_;
+    /** Number of coarse grids of grid sequencing (see Simulation::runSequenced); 0 for none */
+    unsigned int sequenceLevels_;
+    /** Local time steps per cell, pseudo-time for steady states (see Simulation::RunOptions) */
+    bool pseudoTime_;
+    /** Time slices of parareal (see Simulation::runParareal); 0 for serial time stepping */
+    unsigned int pararealSlices_;
+    /** End time of the parareal window in s */
+    RealType endTime_;
 
 
     /**
@@ -84,6 +113,20 @@ namespace Tools {
     RealType getHR();
     RealType getHuL();
     RealType getUR();
+    const std::string& getPrecision();
+    RealType getTolerance();
+    int getShadowChunks();
+    bool getPrimed();
+    const std::string& getSolver();
+    bool getMemoize();
+    RealType getLinear();
+    bool getSemiImplicit();
+    RealType getSteadyTolerance();
+    unsigned int getSteadyWindow();
+    unsigned int getSequenceLevels();
+    bool getPseudoTime();
+    unsigned int getPararealSlices();
+    RealType getEndTime();
   };
 
 } // namespace Tools
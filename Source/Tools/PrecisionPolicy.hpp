@@ -3,18 +3,94 @@
 
 #pragma once
 
+#include <cstdint>
+#include <type_traits>
+
+#include "RealMath.hpp"
+#include "RealType.hpp"
+
 namespace Precision {
 
+  /**
+   * Memory layout of the cell state (see Blocks/StateStorage.hpp)
+   */
+  enum class Layout {
+    Plain,     // h and hu in Store
+    Anomaly,   // surface anomaly eta' = h + b - eta0 and hu in Store, eta0 per chunk
+    BlockFloat, // integer mantissas (Store) of h, hu and b with one shared exponent per chunk
+    FixedPoint  // h, hu and b as integer multiples (Store) of h_scale, hu_scale and b_scale
+  };
+
+  /*
+   * Every policy provides:
+   *   Store, Work, Accum   types of the state, the arithmetic and accumulators
+   *   G                    gravity
+   *   H_MIN                depth below which a cell is treated as dry
+   *   DRY_TOL              depth below which velocities are not computed (10 * H_MIN)
+   *   EPS_LAM              relative eigenvalue gap below which |A| is taken as diagonal (Osher)
+   *   CFL                  Courant number
+   *   use_kahan, keep_bathymetry_in_f32, math, layout   see StateStorage and RealMath.hpp
+   *   primed               state in nondimensional variables (see Primed)
+   *   name                 for logs and reports
+   */
+
+  /**
+   * Everything in double; the reference the mixed policies are measured against
+   */
+  struct Double {
+    using Store = double;
+    using Work  = double;
+    using Accum = double;
+
+    static constexpr Work G       = 9.81;
+    static constexpr Work H_MIN   = 1.5e-8;
+    static constexpr Work DRY_TOL = 1.5e-7;
+    static constexpr Work EPS_LAM = 7.7e-4;
+    static constexpr double CFL  = 0.9;
+    static constexpr bool use_kahan = false;
+    static constexpr bool keep_bathymetry_in_f32 = false;
+    static constexpr MathTier math = MathTier::Exact;
+    static constexpr Layout layout = Layout::Plain;
+    static constexpr bool primed = false;
+    static constexpr const char* name = "Double";
+  };
+
+  /**
+   * Everything in float
+   */
+  struct Float {
+    using Store = float;
+    using Work  = float;
+    using Accum = double;
+
+    static constexpr Work G       = 9.81f;
+    static constexpr Work H_MIN   = 3.5e-4f;
+    static constexpr Work DRY_TOL = 3.5e-3f;
+    static constexpr Work EPS_LAM = 1.2e-1f;
+    static constexpr double CFL  = 0.9;
+    static constexpr bool use_kahan = false;
+    static constexpr bool keep_bathymetry_in_f32 = false;
+    static constexpr MathTier math = MathTier::Exact;
+    static constexpr Layout layout = Layout::Plain;
+    static constexpr bool primed = false;
+    static constexpr const char* name = "Float";
+  };
+
   struct MixedASafe {
     using Store = _Float16;   // global state
     using Work  = double;  // arithmetic
     using Accum = double;  // accumulators
 
-    static constexpr Work G      = 9.81;
-    static constexpr Work H_MIN  = 1e-6;
+    static constexpr Work G       = 9.81;
+    static constexpr Work H_MIN   = 1e-6;
+    static constexpr Work DRY_TOL = 1e-5;
+    static constexpr Work EPS_LAM = 7.7e-4;
     static constexpr double CFL  = 0.9;
     static constexpr bool use_kahan = false;
     static constexpr bool keep_bathymetry_in_f32 = true;
+    static constexpr MathTier math = MathTier::Exact;
+    static constexpr Layout layout = Layout::Plain;
+    static constexpr bool primed = false;
     static constexpr const char* name = "Mixed A (safe)";
   };
 
@@ -23,11 +99,16 @@ namespace Precision {
     using Work  = float;
     using Accum = double;
 
-    static constexpr Work G      = 9.81f;
-    static constexpr Work H_MIN  = 5e-4f;
+    static constexpr Work G       = 9.81f;
+    static constexpr Work H_MIN   = 5e-4f;
+    static constexpr Work DRY_TOL = 5e-3f;
+    static constexpr Work EPS_LAM = 1.2e-1f;
     static constexpr double CFL  = 0.8;
     static constexpr bool use_kahan = true;
     static constexpr bool keep_bathymetry_in_f32 = true;
+    static constexpr MathTier math = MathTier::Exact; // Newton tolerated, see TestMathTier "[.report]"
+    static constexpr Layout layout = Layout::Plain;
+    static constexpr bool primed = false;
     static constexpr const char* name = "Mixed B (aggressive)";
   };
 
@@ -36,12 +117,124 @@ namespace Precision {
     using Work  = double;
     using Accum = double;
 
-    static constexpr Work G      = 9.81f;
-    static constexpr Work H_MIN  = 1e-6;
+    static constexpr Work G       = 9.81f;
+    static constexpr Work H_MIN   = 1e-6;
+    static constexpr Work DRY_TOL = 1e-5;
+    static constexpr Work EPS_LAM = 7.7e-4;
     static constexpr double CFL  = 0.8;
     static constexpr bool use_kahan = true;
     static constexpr bool keep_bathymetry_in_f32 = true;
+    static constexpr MathTier math = MathTier::Exact;
+    static constexpr Layout layout = Layout::Plain;
+    static constexpr bool primed = false;
     static constexpr const char* name = "Mixed C";
   };
 
+  /**
+   * Mixed B with the water column stored as surface anomaly.
+   * Deep water at rest is a constant background, so the 16 bits are spent
+   * on the perturbation instead of on thousands of meters of depth.
+   */
+  struct MixedBAnomaly: MixedBAggressive {
+    static constexpr bool use_kahan = false;
+    static constexpr Layout layout = Layout::Anomaly;
+    static constexpr const char* name = "Mixed B (anomaly)";
+  };
+
+  /**
+   * Mixed B with block floating-point state: 16 bit mantissas relative to
+   * the largest value of their chunk. Smooth fields keep ~15 bits instead
+   * of the 8 of bf16, for the same 2 bytes.
+   */
+  struct MixedBBlockFloat: MixedBAggressive {
+    using Store = std::int16_t;
+
+    static constexpr bool use_kahan = false;
+    static constexpr Layout layout = Layout::BlockFloat;
+    static constexpr const char* name = "Mixed B (block float)";
+  };
+
+  /**
+   * Fixed-point state: h, hu and b are integers in units of h_scale,
+   * hu_scale and b_scale. Net updates are rounded once per edge and added
+   * as integers, so flux-form solvers conserve mass bit for bit.
+   * Values outside the Store range are saturated and reported
+   * (see StateStorage::hasOverflowed).
+   */
+  struct FixedPoint32 {
+    using Store = std::int32_t;
+    using Work  = double;
+    using Accum = double;
+
+    static constexpr Work G       = 9.81;
+    static constexpr Work H_MIN   = 1e-4;
+    static constexpr Work DRY_TOL = 1e-3;
+    static constexpr Work EPS_LAM = 7.7e-4;
+    static constexpr double CFL  = 0.9;
+    static constexpr bool use_kahan = false;
+    static constexpr bool keep_bathymetry_in_f32 = false;
+    static constexpr MathTier math = MathTier::Exact;
+    static constexpr Layout layout = Layout::FixedPoint;
+    static constexpr bool primed = false;
+    static constexpr const char* name = "Fixed point 32";
+
+    static constexpr double h_scale  = 0x1p-16; // m, |h| < 32768 m
+    static constexpr double hu_scale = 0x1p-12; // m^2/s, |hu| < 524288 m^2/s
+    static constexpr double b_scale  = 0x1p-16; // m, |b| < 32768 m
+  };
+
+  /**
+   * 16 bit fixed point for shallow scenarios (|h|, |b| < 32 m)
+   */
+  struct FixedPoint16: FixedPoint32 {
+    using Store = std::int16_t;
+    using Work  = float;
+
+    static constexpr Work G       = 9.81f;
+    static constexpr Work H_MIN   = 5e-3f;
+    static constexpr Work DRY_TOL = 5e-2f;
+    static constexpr Work EPS_LAM = 1.2e-1f;
+    static constexpr const char* name = "Fixed point 16";
+
+    static constexpr double h_scale  = 0x1p-10; // m, |h| < 32 m
+    static constexpr double hu_scale = 0x1p-8;  // m^2/s, |hu| < 128 m^2/s
+    static constexpr double b_scale  = 0x1p-10; // m, |b| < 32 m
+  };
+
+  /**
+   * Policy in nondimensional (primed) variables, see Simulation/Scaling.hpp:
+   *   h' = h / H, b' = b / H, hu' = hu / (H sqrt(g H)), x' = x / dx, t' = t sqrt(g H) / dx
+   * Gravity becomes 1 and drops out of the solvers, and h' and hu' are O(1),
+   * where 16 bit formats have their range and subnormals farthest away.
+   * H_MIN and DRY_TOL are kept, now relative to the depth scale H: they
+   * follow the resolution of Store, which is relative as well.
+   */
+  template <class Policy>
+  struct Primed: Policy {
+    static constexpr typename Policy::Work G = 1;
+    static constexpr bool primed = true;
+  };
+
+  /**
+   * Policy matching RealType, for the solvers that still compute in RealType
+   */
+  using RealTypePolicy = std::conditional_t<std::is_same_v<RealType, float>, Float, Double>;
+
 } // namespace Precision
+
+/**
+ * Calls X(name, Policy, ARG) for every precision policy, name as accepted by
+ * --precision. The selection at runtime and all explicit instantiations are
+ * generated from this list, so a new policy is one line here. Primed
+ * variants are formed by the caller as Precision::Primed<Policy>.
+ */
+#define SWE_PRECISION_POLICIES(X, ARG) \
+  X("double", Precision::Double, ARG) \
+  X("float", Precision::Float, ARG) \
+  X("mixedA", Precision::MixedASafe, ARG) \
+  X("mixedB", Precision::MixedBAggressive, ARG) \
+  X("mixedC", Precision::MixedC, ARG) \
+  X("mixedB-anomaly", Precision::MixedBAnomaly, ARG) \
+  X("mixedB-blockfloat", Precision::MixedBBlockFloat, ARG) \
+  X("fixed32", Precision::FixedPoint32, ARG) \
+  X("fixed16", Precision::FixedPoint16, ARG)
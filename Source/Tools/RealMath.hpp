@@ -1,10 +1,18 @@
 #pragma once
 #include <cmath>
+#include <limits>
 #include <type_traits>
 #include <sstream>
 #include <iostream>
 
-#include "RealType.hpp"   // defines RealType, ComputeType, bf16 (if used)
+#if defined(__SSE__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "RealType.hpp"   // defines RealType, ComputeType
+#include "bf16.hpp"
 
 /* -----------------------------------------------------------------------
    Helper: promote to a safe math type for the call, then cast back.
@@ -102,26 +110,19 @@ inline RealType min_real(RealType a, RealType b){
   return (b < a) ? b : a;
 }
 
+// select (blend): both operands are evaluated, compiles to a mask blend in vectorized loops
+inline RealType select_real(bool condition, RealType a, RealType b){
+  return condition ? a : b;
+}
+
 /* IO helpers for RealType */
 inline std::istringstream& read_real(std::istringstream& ss, RealType& value) {
-#if defined(ENABLE_HALF_PRECISION) || defined(ENABLE_FLOAT16_MIXED)
-  float tmp; ss >> tmp; value = static_cast<_Float16>(tmp);
-#elif defined(ENABLE_BFLOAT16_MIXED) || defined(ENABLE_HALFB_PRECISION)
-  float tmp; ss >> tmp; value = static_cast<__bf16>(tmp);
-#else
   ss >> value;
-#endif
   return ss;
 }
 
 inline void print_real(const RealType& value, std::ostream& os = std::cout) {
-#if defined(ENABLE_HALF_PRECISION) || defined(ENABLE_FLOAT16_MIXED) || defined(ENABLE_HALFB_PRECISION)
-  os << static_cast<float>(value);
-#elif defined(ENABLE_BFLOAT16_MIXED)
-  os << static_cast<float>(value);
-#else
   os << value;
-#endif
 }
 
 /* =========================
@@ -183,3 +184,137 @@ inline ComputeType max_compute(ComputeType a, ComputeType b){
 inline ComputeType min_compute(ComputeType a, ComputeType b){
   return (b < a) ? b : a;
 }
+
+/* =========================
+   Policy-selected math tier
+   ========================= */
+
+/**
+ * Accuracy tier for the square roots and divisions inside the solvers.
+ *
+ * Picked per precision policy (Policy::math): a policy that stores bf16
+ * keeps 8 significant bits, so paying for a correctly rounded sqrt or
+ * division in the work precision buys nothing.
+ */
+enum class MathTier {
+  Exact,    // std::sqrt and IEEE division
+  Newton,   // hardware estimate refined by one Newton-Raphson step (~22 bits)
+  Estimate  // raw hardware estimate (~12 bits)
+};
+
+namespace detail {
+
+  // Hardware reciprocal square root estimate (relative error <= 1.5 * 2^-12)
+  inline float rsqrt_estimate(float x) {
+#if defined(__SSE__)
+    return _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+#elif defined(__ARM_NEON)
+    return vrsqrtes_f32(x);
+#else
+    // No estimate instruction available: fall back to the exact value
+    return 1.0f / std::sqrt(x);
+#endif
+  }
+
+  // Hardware reciprocal estimate (relative error <= 1.5 * 2^-12)
+  inline float rcp_estimate(float x) {
+#if defined(__SSE__)
+    return _mm_cvtss_f32(_mm_rcp_ss(_mm_set_ss(x)));
+#elif defined(__ARM_NEON)
+    return vrecpes_f32(x);
+#else
+    return 1.0f / x;
+#endif
+  }
+
+} // namespace detail
+
+// 1/sqrt(x) for x > 0
+template <MathTier Tier, class T>
+inline T rsqrt_tier(T x) {
+  if constexpr (Tier == MathTier::Exact) {
+    using C = typename detail::safe_compute_for_arg<T>::type;
+    return static_cast<T>(C(1) / std::sqrt(static_cast<C>(x)));
+  } else {
+    using C = std::conditional_t<std::is_same_v<T, double>, double, float>;
+    const C xc = static_cast<C>(x);
+    C y = static_cast<C>(detail::rsqrt_estimate(static_cast<float>(xc)));
+    if constexpr (Tier == MathTier::Newton) {
+      y = y * (C(1.5) - C(0.5) * xc * y * y);
+    }
+    return static_cast<T>(y);
+  }
+}
+
+// sqrt(x) for x >= 0; computed as x * rsqrt(x) below the exact tier
+template <MathTier Tier, class T>
+inline T sqrt_tier(T x) {
+  if constexpr (Tier == MathTier::Exact) {
+    using C = typename detail::safe_compute_for_arg<T>::type;
+    return static_cast<T>(std::sqrt(static_cast<C>(x)));
+  } else {
+    // Clamp the estimate argument so that x = 0 yields 0 instead of 0 * inf
+    const T tiny = static_cast<T>(std::numeric_limits<float>::min());
+    return x * rsqrt_tier<Tier>(x < tiny ? tiny : x);
+  }
+}
+
+// 1/x for x != 0
+template <MathTier Tier, class T>
+inline T rcp_tier(T x) {
+  if constexpr (Tier == MathTier::Exact) {
+    return T(1) / x;
+  } else {
+    using C = std::conditional_t<std::is_same_v<T, double>, double, float>;
+    const C xc = static_cast<C>(x);
+    C y = static_cast<C>(detail::rcp_estimate(static_cast<float>(xc)));
+    if constexpr (Tier == MathTier::Newton) {
+      y = y * (C(2) - xc * y);
+    }
+    return static_cast<T>(y);
+  }
+}
+
+// a/b for b != 0
+template <MathTier Tier, class T>
+inline T div_tier(T a, T b) {
+  if constexpr (Tier == MathTier::Exact) {
+    return a / b;
+  } else {
+    return a * rcp_tier<Tier>(b);
+  }
+}
+
+/* =========================
+   Work-precision versions, tier taken from the precision policy
+   ========================= */
+
+// max/min for the work precision (same sign rules as max_real/min_real)
+template <class T>
+inline T max_work(T a, T b) {
+  return (a < b) ? b : a;
+}
+template <class T>
+inline T min_work(T a, T b) {
+  return (b < a) ? b : a;
+}
+// select for the work precision (see select_real)
+template <class T>
+inline T select_work(bool condition, T a, T b) {
+  return condition ? a : b;
+}
+
+template <class Policy>
+inline typename Policy::Work sqrt_work(typename Policy::Work x) {
+  return sqrt_tier<Policy::math>(x);
+}
+
+template <class Policy>
+inline typename Policy::Work rcp_work(typename Policy::Work x) {
+  return rcp_tier<Policy::math>(x);
+}
+
+template <class Policy>
+inline typename Policy::Work div_work(typename Policy::Work a, typename Policy::Work b) {
+  return div_tier<Policy::math>(a, b);
+}
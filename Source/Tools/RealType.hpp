@@ -43,3 +43,6 @@ using RealType = float;
 #else
 using RealType = double;
 #endif
+
+// Datatype used for arithmetic in the mixed-precision code paths
+using ComputeType = RealType;
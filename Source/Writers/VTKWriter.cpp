@@ -142,6 +142,8 @@ void Writers::VTKWriter::write(const RealType time, const RealType* h, const Rea
   timeStep_++;
 }
 
+void Writers::VTKWriter::comment(const std::string& text) { *vtpFile_ << "<!-- " << text << " -->" << std::endl; }
+
 std::string Writers::VTKWriter::generateFileName() {
   std::ostringstream name;
   name << basename_ << '_' << timeStep_ << ".vtr";
@@ -74,6 +74,11 @@ namespace Writers {
      * @param size Number of cells (without boundary values)
      */
     void write(const RealType time, const RealType* h, const RealType* hu, const RealType* b, unsigned int size);
+
+    /**
+     * Writes a comment into the VTP collection, e.g. what its time steps mean
+     */
+    void comment(const std::string& text);
   };
 
 } // namespace Writers
@@ -0,0 +1,117 @@
+/**
+ * @file EdgeStates.hpp
+ * contains the fuzzed edge states shared by the solver tests
+ *
+ * fuzzedStates draws the left and right cell of an edge from an EdgeRange:
+ * log-uniform depths, Froude numbers in both directions, optionally a depth
+ * ratio between the sides, bed steps and the wet/dry cases (dry and near-dry
+ * sides, walls, steps above the neighbouring surface). nsPerEdge times a
+ * solver over such states for the "[.report]" test cases.
+ */
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace Tests {
+
+  struct EdgeState {
+    double hL, hR, huL, huR, bL, bR;
+  };
+
+  struct EdgeRange {
+    unsigned int seed         = 42;
+    double       minLogDepth  = -2.0;  ///< log10 of the smallest depth
+    double       maxLogDepth  = 2.0;   ///< log10 of the largest depth
+    double       froude       = 2.0;   ///< Froude numbers in [-froude, froude]
+    double       depthJump    = 0.0;   ///< if > 1, hR is hL times a ratio in [1/depthJump, depthJump], else drawn like hL
+    double       bed          = -100.0;
+    double       bedStep      = 0.0;   ///< bL and bR in [bed - bedStep, bed + bedStep]
+    bool         levelSurface = false; ///< beds lowered by the depth of their side, both surfaces near bed
+    bool         wetDry       = false; ///< a share of the states gets dry and near-dry sides, walls and steps
+  };
+
+  inline std::vector<EdgeState> fuzzedStates(unsigned int count, const EdgeRange& range) {
+    std::mt19937                           gen(range.seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_real_distribution<double> depth(range.minLogDepth, range.maxLogDepth);
+    std::uniform_real_distribution<double> froude(-range.froude, range.froude);
+    std::uniform_real_distribution<double> step(-range.bedStep, range.bedStep);
+
+    std::vector<EdgeState> states(count);
+    for (auto& s : states) {
+      s.hL  = std::pow(10.0, depth(gen));
+      s.hR  = range.depthJump > 1.0 ? s.hL * std::exp(std::log(range.depthJump) * (2.0 * unit(gen) - 1.0)) : std::pow(10.0, depth(gen));
+      s.huL = s.hL * froude(gen) * std::sqrt(9.81 * s.hL);
+      s.huR = s.hR * froude(gen) * std::sqrt(9.81 * s.hR);
+      s.bL  = range.bed + step(gen) - (range.levelSurface ? s.hL : 0.0);
+      s.bR  = range.bed + step(gen) - (range.levelSurface ? s.hR : 0.0);
+      if (!range.wetDry) {
+        continue;
+      }
+
+      const double kind = unit(gen);
+      if (kind < 0.1) {
+        s.hL = s.huL = 0;
+      } else if (kind < 0.2) {
+        s.hR = s.huR = 0;
+      } else if (kind < 0.25) {
+        s.hL = s.hR = s.huL = s.huR = 0;
+      } else if (kind < 0.275) {
+        s.hL *= 1e-9; // below H_MIN, momentum kept
+      } else if (kind < 0.3) {
+        s.hR *= 1e-9;
+      } else if (kind < 0.35) {
+        s.bL = 1; // wall
+      } else if (kind < 0.4) {
+        s.bR = 1;
+      } else if (kind < 0.45) {
+        s.bR = 0; // at or above the left surface for shallow sides
+      } else if (kind < 0.5) {
+        s.bL = s.bR = 1;
+      } else if (kind < 0.6) {
+        s.bR = s.bL + 1.5 * s.hL; // step above the left surface
+      } else if (kind < 0.7) {
+        s.bL = s.bR + 1.5 * s.hR; // step above the right surface
+      }
+    }
+    return states;
+  }
+
+  /** Edge states between neighbouring cells of a snapshot with h, hu and b including the ghost cells */
+  template <class Snapshot>
+  std::vector<EdgeState> snapshotStates(const Snapshot& snapshot) {
+    std::vector<EdgeState> states(snapshot.h.size() - 1);
+    for (size_t k = 0; k < states.size(); k++) {
+      states[k] = {snapshot.h[k], snapshot.h[k + 1], snapshot.hu[k], snapshot.hu[k + 1], snapshot.b[k], snapshot.b[k + 1]};
+    }
+    return states;
+  }
+
+  /** @return Nanoseconds per computeNetUpdates call of the solver on the states converted to T */
+  template <class T, class Solver>
+  double nsPerEdge(Solver& solver, const std::vector<EdgeState>& states, unsigned int runs = 1) {
+    const unsigned int count = unsigned(states.size());
+    std::vector<T>     hL(count), hR(count), huL(count), huR(count), bL(count), bR(count);
+    for (unsigned int k = 0; k < count; k++) {
+      hL[k]  = T(states[k].hL);
+      hR[k]  = T(states[k].hR);
+      huL[k] = T(states[k].huL);
+      huR[k] = T(states[k].huR);
+      bL[k]  = T(states[k].bL);
+      bR[k]  = T(states[k].bR);
+    }
+    std::vector<T> out0(count), out1(count), out2(count), out3(count), speed(count);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned int run = 0; run < runs; run++) {
+      for (unsigned int k = 0; k < count; k++) {
+        solver.computeNetUpdates(hL[k], hR[k], huL[k], huR[k], bL[k], bR[k], out0[k], out1[k], out2[k], out3[k], speed[k]);
+      }
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (double(runs) * count);
+  }
+
+} // namespace Tests
@@ -0,0 +1,24 @@
+/**
+ * @file Results.hpp
+ * contains comparisons of Simulation::run results shared by the steady-flow tests
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "Simulation/Simulation.hpp"
+
+namespace Tests {
+
+  /** @return Largest difference in h or hu between the inner cells of two runs of the same size */
+  inline double maxDifference(const Simulation::Result& a, const Simulation::Result& b) {
+    double difference = 0.0;
+    for (unsigned int i = 1; i < a.h.size() - 1; i++) {
+      difference = std::max(difference, std::abs(double(a.h[i]) - double(b.h[i])));
+      difference = std::max(difference, std::abs(double(a.hu[i]) - double(b.hu[i])));
+    }
+    return difference;
+  }
+
+} // namespace Tests
@@ -0,0 +1,157 @@
+/**
+ * @file TestAnomalyStorage.cpp
+ * contains tests for the anomaly storage layout (Blocks/StateStorage.hpp)
+ *
+ * @test A small surface perturbation on deep water survives 16-bit storage as anomaly
+ * @test A lake at rest is stored exactly
+ * @test A block run with Mixed B (anomaly) follows the double reference
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <vector>
+
+#include "Blocks/StateStorage.hpp"
+#include "Blocks/WavePropagationBlockMixed.hpp"
+#include "Tools/PrecisionPolicy.hpp"
+
+namespace {
+
+  // Mixed B without compensation: the plain counterpart of Mixed B (anomaly)
+  struct PlainBF16: Precision::MixedBAggressive {
+    static constexpr bool use_kahan = false;
+  };
+
+  constexpr unsigned int Size     = 200;
+  constexpr double       Depth    = 5000.0;
+  constexpr double       Bump     = 0.5;
+  constexpr double       CellSize = 1000.0;
+  constexpr double       EndTime  = 200.0;
+
+  // Deep ocean at rest with a gaussian surface bump in the middle (incl. ghost cells)
+  void bumpOnDeepWater(std::vector<RealType>& h, std::vector<RealType>& hu, std::vector<RealType>& b, double relief = 100.0) {
+    h.assign(Size + 2, 0);
+    hu.assign(Size + 2, 0);
+    b.assign(Size + 2, 0);
+    for (unsigned int i = 0; i < Size + 2; i++) {
+      const double x = (double(i) - 0.5 * Size) / 10.0;
+      b[i]           = RealType(-Depth + relief * std::sin(0.05 * i));
+      h[i]           = RealType(-b[i] + Bump * std::exp(-x * x));
+    }
+  }
+
+  template <class Policy>
+  double maxSurfaceError(const std::vector<RealType>& h, const std::vector<RealType>& b) {
+    Blocks::StateStorage<Policy> storage(Size + 2);
+    std::vector<RealType>        zero(Size + 2, 0);
+    storage.assign(h.data(), zero.data(), b.data());
+
+    std::vector<RealType> hOut(Size + 2), huOut(Size + 2), bOut(Size + 2);
+    storage.extract(hOut.data(), huOut.data(), bOut.data());
+
+    double maxError = 0.0;
+    for (unsigned int i = 0; i < Size + 2; i++) {
+      maxError = std::max(maxError, std::fabs((double(hOut[i]) + double(bOut[i])) - (double(h[i]) + double(b[i]))));
+    }
+    return maxError;
+  }
+
+  template <class Policy>
+  std::vector<RealType> runSurface(double* mass) {
+    // Flat bottom: the split bed source of RusanovMixed is not exactly well-balanced
+    std::vector<RealType> h, hu, b;
+    bumpOnDeepWater(h, hu, b, 0.0);
+
+    Blocks::WavePropagationBlockMixed<Policy> block(h.data(), hu.data(), b.data(), Size, RealType(CellSize));
+    for (double t = 0.0; t < EndTime;) {
+      block.applyBoundaryConditions();
+      const auto dt = std::min(double(block.computeNumericalFluxes()), EndTime - t);
+      block.updateUnknowns(typename Policy::Work(dt));
+      t += dt;
+    }
+    block.getState(h.data(), hu.data(), b.data());
+
+    *mass = 0.0;
+    std::vector<RealType> eta(Size + 2);
+    for (unsigned int i = 0; i < Size + 2; i++) {
+      eta[i] = h[i] + b[i];
+      if (i > 0 && i <= Size) {
+        *mass += double(h[i]) - Depth;
+      }
+    }
+    return eta;
+  }
+
+} // namespace
+
+using Blocks::StateStorage;
+
+TEST_CASE("Anomaly storage resolves a small bump on deep water", "[AnomalyStorage]") {
+  std::vector<RealType> h, hu, b;
+  bumpOnDeepWater(h, hu, b);
+
+  // bf16 spacing at 5000 m is 32 m, the bump is gone
+  REQUIRE(maxSurfaceError<PlainBF16>(h, b) > 0.4 * Bump);
+  // eta' is O(1 m) and keeps 8 bits of it
+  REQUIRE(maxSurfaceError<Precision::MixedBAnomaly>(h, b) < 1e-2);
+}
+
+TEST_CASE("Anomaly storage keeps a lake at rest exactly", "[AnomalyStorage]") {
+  std::vector<RealType> h(Size + 2), hu(Size + 2, 0), b(Size + 2);
+  for (unsigned int i = 0; i < Size + 2; i++) {
+    b[i] = RealType(-Depth + 1000.0 * std::sin(0.1 * i));
+    h[i] = -b[i];
+  }
+
+  StateStorage<Precision::MixedBAnomaly> storage(Size + 2);
+  storage.assign(h.data(), hu.data(), b.data());
+
+  // Zero net updates must not move the surface
+  std::vector<float> zero(Size + 2, 0.0f);
+  storage.update(1, Size, 1.0f, zero.data(), zero.data(), zero.data(), zero.data());
+
+  std::vector<RealType> hOut(Size + 2), huOut(Size + 2), bOut(Size + 2);
+  storage.extract(hOut.data(), huOut.data(), bOut.data());
+  for (unsigned int i = 0; i < Size + 2; i++) {
+    REQUIRE(double(hOut[i]) + double(bOut[i]) == 0.0);
+    REQUIRE(huOut[i] == 0);
+  }
+}
+
+TEST_CASE("Anomaly storage marks dry cells", "[AnomalyStorage]") {
+  std::vector<RealType> h(Size + 2), hu(Size + 2, 0), b(Size + 2);
+  for (unsigned int i = 0; i < Size + 2; i++) {
+    b[i] = RealType(-10.0 + 0.1 * i); // beach reaching above the still water level
+    h[i] = std::max(RealType(0), -b[i]);
+  }
+
+  StateStorage<Precision::MixedBAnomaly> storage(Size + 2);
+  storage.assign(h.data(), hu.data(), b.data());
+
+  std::vector<RealType> hOut(Size + 2), huOut(Size + 2), bOut(Size + 2);
+  storage.extract(hOut.data(), huOut.data(), bOut.data());
+  for (unsigned int i = 0; i < Size + 2; i++) {
+    if (h[i] == 0) {
+      REQUIRE(hOut[i] == 0);
+    } else {
+      REQUIRE_THAT(double(hOut[i]), Catch::Matchers::WithinAbs(double(h[i]), 0.1));
+    }
+  }
+}
+
+TEST_CASE("Mixed B (anomaly) block follows the double reference", "[AnomalyStorage]") {
+  double     referenceMass = 0.0;
+  double     anomalyMass   = 0.0;
+  const auto reference     = runSurface<Precision::Double>(&referenceMass);
+  const auto anomaly       = runSurface<Precision::MixedBAnomaly>(&anomalyMass);
+
+  double maxError = 0.0;
+  for (unsigned int i = 1; i <= Size; i++) {
+    maxError = std::max(maxError, std::fabs(double(anomaly[i]) - double(reference[i])));
+  }
+  // Plain 16 bit storage loses most of the bump here (error 0.4 - 0.5 * Bump)
+  REQUIRE(maxError < 0.05 * Bump);
+  REQUIRE_THAT(anomalyMass, Catch::Matchers::WithinAbs(referenceMass, 0.05 * Bump * 20));
+
+  REQUIRE(StateStorage<Precision::MixedBAnomaly>::bytesPerCell < StateStorage<Precision::MixedBAggressive>::bytesPerCell);
+}
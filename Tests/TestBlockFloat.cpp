@@ -0,0 +1,165 @@
+/**
+ * @file TestBlockFloat.cpp
+ * contains tests for the block floating-point storage layout (Blocks/StateStorage.hpp)
+ *
+ * @test Round trip error is bounded by the chunk maximum times 2^-15
+ * @test A smooth hump with Mixed B (block float) follows the double reference
+ *
+ * The hidden test case "[.report]" compares accuracy, bytes per cell and cells per second
+ * of the block float layout against Mixed B (aggressive):
+ *   ./TestBlockFloat "[.report]"
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "Blocks/StateStorage.hpp"
+#include "Blocks/WavePropagationBlockMixed.hpp"
+#include "Scenarios/DamBreakScenario.hpp"
+#include "Tools/PrecisionPolicy.hpp"
+
+namespace {
+
+  struct RunResult {
+    std::vector<RealType> h;
+    double                mass;
+    double                cellsPerSecond;
+  };
+
+  template <class Policy>
+  RunResult run(bool damBreak, unsigned int size, double endTime) {
+    Scenarios::DamBreakScenario scenario(10000, size, 14, 3.5, 0);
+
+    std::vector<RealType> h(size + 2), hu(size + 2), b(size + 2);
+    for (unsigned int i = 0; i < size + 2; i++) {
+      const double x = (double(i) - 0.5 * size) / (0.05 * size);
+      h[i]           = damBreak ? scenario.getHeight(i) : RealType(14.0 + std::exp(-x * x));
+      hu[i]          = damBreak ? scenario.getMomentum(i) : RealType(0);
+      b[i]           = scenario.getBathymetry(i);
+    }
+
+    Blocks::WavePropagationBlockMixed<Policy> block(h.data(), hu.data(), b.data(), size, scenario.getCellSize());
+
+    unsigned long long cellUpdates = 0;
+    const auto         start       = std::chrono::steady_clock::now();
+    for (double t = 0.0; t < endTime;) {
+      block.applyBoundaryConditions();
+      const double dt = std::min(double(block.computeNumericalFluxes()), endTime - t);
+      block.updateUnknowns(typename Policy::Work(dt));
+      t += dt;
+      cellUpdates += size;
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    RunResult result;
+    result.cellsPerSecond = double(cellUpdates) / std::chrono::duration<double>(end - start).count();
+
+    block.getState(h.data(), hu.data(), b.data());
+    result.mass = 0.0;
+    for (unsigned int i = 1; i <= size; i++) {
+      result.mass += h[i];
+    }
+    result.h = std::move(h);
+    return result;
+  }
+
+  double maxDifference(const std::vector<RealType>& a, const std::vector<RealType>& b) {
+    double maxError = 0.0;
+    for (size_t i = 1; i + 1 < a.size(); i++) {
+      maxError = std::max(maxError, std::fabs(double(a[i]) - double(b[i])));
+    }
+    return maxError;
+  }
+
+  template <class Policy>
+  void reportRow(const RunResult& reference, bool damBreak, unsigned int size, double endTime) {
+    const RunResult result = run<Policy>(damBreak, size, endTime);
+    std::printf(
+      "%-24s | %10.3e | %10.3e | %7.3f | %8.2f\n",
+      Policy::name,
+      maxDifference(result.h, reference.h),
+      std::fabs(result.mass - reference.mass) / reference.mass,
+      Blocks::StateStorage<Policy>::bytesPerCell,
+      result.cellsPerSecond * 1e-6
+    );
+  }
+
+  void report(bool damBreak, unsigned int size, double endTime) {
+    const auto reference = run<Precision::Double>(damBreak, size, endTime);
+
+    std::printf("%s, %u cells, t = %.1f s, error against %s\n", damBreak ? "Dam break" : "Smooth hump", size, endTime, Precision::Double::name);
+    std::printf("%-24s | %10s | %10s | %7s | %8s\n", "policy", "max.err h", "mass err", "B/cell", "Mcells/s");
+    reportRow<Precision::Double>(reference, damBreak, size, endTime);
+    reportRow<Precision::MixedBAggressive>(reference, damBreak, size, endTime);
+    reportRow<Precision::MixedBBlockFloat>(reference, damBreak, size, endTime);
+    std::printf("\n");
+  }
+
+} // namespace
+
+TEST_CASE("Block float round trip", "[BlockFloat]") {
+  using Storage                = Blocks::StateStorage<Precision::MixedBBlockFloat>;
+  const unsigned int     cells = 10 * Blocks::ChunkSize + 7;
+  std::vector<RealType>  h(cells), hu(cells), b(cells);
+  for (unsigned int i = 0; i < cells; i++) {
+    b[i]  = RealType(-5000.0 + 4000.0 * std::sin(0.01 * i));
+    h[i]  = -b[i] + RealType(0.5 * std::cos(0.3 * i));
+    hu[i] = RealType(i % 2 ? -1e-3 * i : 1e3 * std::sin(0.1 * i));
+  }
+  h[3]  = 0;     // dry cell
+  hu[3] = 0;
+
+  Storage storage(cells);
+  storage.assign(h.data(), hu.data(), b.data());
+
+  std::vector<RealType> hOut(cells), huOut(cells), bOut(cells);
+  storage.extract(hOut.data(), huOut.data(), bOut.data());
+
+  for (unsigned int c = 0; c * Blocks::ChunkSize < cells; c++) {
+    const unsigned int first = c * Blocks::ChunkSize;
+    const unsigned int last  = std::min(cells, first + Blocks::ChunkSize);
+    double             hMax = 0.0, huMax = 0.0, bMax = 0.0;
+    for (unsigned int i = first; i < last; i++) {
+      hMax  = std::max(hMax, std::fabs(double(h[i])));
+      huMax = std::max(huMax, std::fabs(double(hu[i])));
+      bMax  = std::max(bMax, std::fabs(double(b[i])));
+    }
+    for (unsigned int i = first; i < last; i++) {
+      REQUIRE(std::fabs(double(hOut[i]) - double(h[i])) <= std::ldexp(hMax, -15));
+      REQUIRE(std::fabs(double(huOut[i]) - double(hu[i])) <= std::ldexp(huMax, -15));
+      REQUIRE(std::fabs(double(bOut[i]) - double(b[i])) <= std::ldexp(bMax, -15));
+    }
+  }
+  REQUIRE(hOut[3] == 0);
+}
+
+TEST_CASE("Block float mantissas do not overflow", "[BlockFloat]") {
+  // 32767.75 rounds past the int16 range with the natural exponent
+  std::vector<RealType> h(Blocks::ChunkSize, RealType(32767.75)), hu(Blocks::ChunkSize, RealType(-32767.75)), b(Blocks::ChunkSize, 0);
+
+  Blocks::StateStorage<Precision::MixedBBlockFloat> storage(Blocks::ChunkSize);
+  storage.assign(h.data(), hu.data(), b.data());
+
+  std::vector<RealType> hOut(Blocks::ChunkSize), huOut(Blocks::ChunkSize), bOut(Blocks::ChunkSize);
+  storage.extract(hOut.data(), huOut.data(), bOut.data());
+  REQUIRE_THAT(double(hOut[0]), Catch::Matchers::WithinAbs(32767.75, 1.0));
+  REQUIRE_THAT(double(huOut[0]), Catch::Matchers::WithinAbs(-32767.75, 1.0));
+}
+
+TEST_CASE("Mixed B (block float) smooth hump follows the double reference", "[BlockFloat]") {
+  const auto reference  = run<Precision::Double>(false, 1000, 200.0);
+  const auto blockFloat = run<Precision::MixedBBlockFloat>(false, 1000, 200.0);
+
+  // Hump height is 1 m; plain bf16 without compensation is off by ~0.45 m here
+  REQUIRE(maxDifference(blockFloat.h, reference.h) < 0.05);
+  REQUIRE_THAT(blockFloat.mass, Catch::Matchers::WithinRel(reference.mass, 1e-4));
+  REQUIRE(Blocks::StateStorage<Precision::MixedBBlockFloat>::bytesPerCell < Blocks::StateStorage<Precision::MixedBAggressive>::bytesPerCell);
+}
+
+TEST_CASE("Block float vs Mixed B: accuracy, bytes per cell and throughput", "[.report][BlockFloat]") {
+  report(false, 100000, 20.0);
+  report(true, 100000, 20.0);
+}
@@ -0,0 +1,189 @@
+/**
+ * @file TestChunkClassification.cpp
+ * contains tests for the all-wet / all-dry / mixed chunk dispatch of WavePropagationBlockMixed
+ *
+ * @test The branch-free wet kernel matches the general RusanovMixed on wet states
+ * @test The block classifies the chunks of a half-dry domain
+ * @test A dam break onto a dry bed runs through all three classes
+ *
+ * The hidden test case "[.report]" times the wet kernel against the per-edge solver:
+ *   ./TestChunkClassification "[.report]"
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Blocks/WavePropagationBlockMixed.hpp"
+#include "Scenarios/DamBreakScenario.hpp"
+#include "Simulation/Simulation.hpp"
+#include "Solver/RusanovMixed.hpp"
+
+namespace {
+
+  constexpr unsigned int Count = Blocks::ChunkSize;
+
+  // Wet cells over a gently varying bed, as the block classifies them as wet
+  void fuzzedWetCells(std::mt19937& gen, double* h, double* hu, double* b, unsigned int count) {
+    std::uniform_real_distribution<double> depth(0.5, 50.0);
+    std::uniform_real_distribution<double> froude(-1.5, 1.5);
+    std::uniform_real_distribution<double> bed(-0.4, 0.0);
+    for (unsigned int i = 0; i < count; i++) {
+      h[i]  = depth(gen);
+      hu[i] = h[i] * froude(gen) * std::sqrt(9.81 * h[i]);
+      b[i]  = -100.0 + bed(gen);
+    }
+  }
+
+  // Static bathymetry terms of the edges between count + 1 cells
+  template <class Policy, class Work>
+  void edgeBathymetry(const Work* b, unsigned int count, Work* dropLeft, Work* dropRight, Work* deltaB) {
+    for (unsigned int k = 0; k < count; k++) {
+      unsigned char wall;
+      Solvers::RusanovMixed<Policy>::computeEdgeBathymetry(b[k], b[k + 1], dropLeft[k], dropRight[k], deltaB[k], wall);
+    }
+  }
+
+  template <class Policy>
+  void requireWetKernelMatches(double tolerance) {
+    using Work = typename Policy::Work;
+    std::mt19937 gen(7);
+
+    for (unsigned int run = 0; run < 200; run++) {
+      double hd[Count + 1], hud[Count + 1], bd[Count + 1];
+      fuzzedWetCells(gen, hd, hud, bd, Count + 1);
+      Work h[Count + 1], hu[Count + 1], b[Count + 1];
+      for (unsigned int i = 0; i <= Count; i++) {
+        h[i]  = Work(hd[i]);
+        hu[i] = Work(hud[i]);
+        b[i]  = Work(bd[i]);
+      }
+
+      Work dropLeft[Count], dropRight[Count], deltaB[Count];
+      edgeBathymetry<Policy>(b, Count, dropLeft, dropRight, deltaB);
+
+      Solvers::RusanovMixed<Policy> solver;
+      Work                          hL[Count], hR[Count], huL[Count], huR[Count], maxSpeed;
+      solver.computeWetNetUpdates(Count, h, hu, dropLeft, dropRight, deltaB, hL, hR, huL, huR, maxSpeed);
+
+      Work maxGeneral = Work(0);
+      for (unsigned int k = 0; k < Count; k++) {
+        Work hLk, hRk, huLk, huRk, speed;
+        solver.computeNetUpdates(h[k], h[k + 1], hu[k], hu[k + 1], b[k], b[k + 1], hLk, hRk, huLk, huRk, speed);
+        const double scale = std::fabs(double(huLk)) + std::fabs(double(hLk)) + 1.0;
+        REQUIRE_THAT(double(hL[k]), Catch::Matchers::WithinAbs(double(hLk), tolerance * scale));
+        REQUIRE_THAT(double(hR[k]), Catch::Matchers::WithinAbs(double(hRk), tolerance * scale));
+        REQUIRE_THAT(double(huL[k]), Catch::Matchers::WithinAbs(double(huLk), tolerance * scale));
+        REQUIRE_THAT(double(huR[k]), Catch::Matchers::WithinAbs(double(huRk), tolerance * scale));
+        maxGeneral = std::max(maxGeneral, speed);
+      }
+      REQUIRE_THAT(double(maxSpeed), Catch::Matchers::WithinRel(double(maxGeneral), tolerance));
+    }
+  }
+
+  template <class Policy>
+  void reportRow(const char* name) {
+    using Work                   = typename Policy::Work;
+    constexpr unsigned int Edges = 1 << 20;
+
+    std::mt19937        gen(3);
+    std::vector<double> hd(Edges + 1), hud(Edges + 1), bd(Edges + 1);
+    fuzzedWetCells(gen, hd.data(), hud.data(), bd.data(), Edges + 1);
+    std::vector<Work> h(Edges + 1), hu(Edges + 1), b(Edges + 1), hL(Edges), hR(Edges), huL(Edges), huR(Edges);
+    for (unsigned int i = 0; i <= Edges; i++) {
+      h[i]  = Work(hd[i]);
+      hu[i] = Work(hud[i]);
+      b[i]  = Work(bd[i]);
+    }
+    std::vector<Work> dropLeft(Edges), dropRight(Edges), deltaB(Edges);
+    edgeBathymetry<Policy>(b.data(), Edges, dropLeft.data(), dropRight.data(), deltaB.data());
+
+    Solvers::RusanovMixed<Policy> solver;
+    Work                          sink = Work(0);
+
+    auto       start = std::chrono::steady_clock::now();
+    for (unsigned int k = 0; k < Edges; k++) {
+      Work speed;
+      solver.computeNetUpdates(h[k], h[k + 1], hu[k], hu[k + 1], b[k], b[k + 1], hL[k], hR[k], huL[k], huR[k], speed);
+      sink = std::max(sink, speed);
+    }
+    const double general = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / Edges;
+
+    start = std::chrono::steady_clock::now();
+    for (unsigned int first = 0; first < Edges; first += Count) {
+      Work speed;
+      solver.computeWetNetUpdates(
+        Count, &h[first], &hu[first], &dropLeft[first], &dropRight[first], &deltaB[first], &hL[first], &hR[first], &huL[first], &huR[first], speed
+      );
+      sink = std::max(sink, speed);
+    }
+    const double wet = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / Edges;
+
+    REQUIRE(double(sink) > 0.0);
+    std::printf("%-22s %9.2f %9.2f %9.2f\n", name, general, wet, general / wet);
+  }
+
+} // namespace
+
+TEST_CASE("Wet kernel matches the general solver", "[ChunkClassification]") {
+  requireWetKernelMatches<Precision::Double>(1e-13);
+  requireWetKernelMatches<Precision::Float>(1e-5);
+  requireWetKernelMatches<Precision::MixedC>(1e-5);
+}
+
+TEST_CASE("Block classifies wet, dry and mixed chunks", "[ChunkClassification]") {
+  constexpr unsigned int Size = 8 * Count;
+
+  // Wet left half, dry right half
+  std::vector<RealType> h(Size + 2), hu(Size + 2, 0), b(Size + 2, -1);
+  for (unsigned int i = 0; i < Size + 2; i++) {
+    h[i] = i <= Size / 2 ? 1 : 0;
+  }
+
+  Blocks::WavePropagationBlockMixed<Precision::Double> block(h.data(), hu.data(), b.data(), Size, 1);
+  block.applyBoundaryConditions();
+  block.computeNumericalFluxes();
+
+  // Edges [0, Size] form 9 chunks, the one at the shore line is mixed
+  REQUIRE(block.getWetChunks() == 4);
+  REQUIRE(block.getMixedChunks() == 1);
+  REQUIRE(block.getDryChunks() == 4);
+
+  block.resetChunkCounters();
+  REQUIRE(block.getWetChunks() + block.getMixedChunks() + block.getDryChunks() == 0);
+}
+
+TEST_CASE("Dam break onto a dry bed", "[ChunkClassification]") {
+  constexpr unsigned int Size  = 1000;
+  constexpr unsigned int Steps = 300;
+
+  // The scenario needs hR > 0; 1e-9 m is below Double's H_MIN
+  Scenarios::DamBreakScenario scenario(1000, Size, 2, 1e-9, 0);
+  const auto                  result = Simulation::run<Precision::Double>(scenario, Size, Steps);
+
+  const unsigned long long chunks = (Size + 1 + Count - 1) / Count;
+  REQUIRE(result.wetChunks + result.dryChunks + result.mixedChunks == chunks * Steps);
+  REQUIRE(result.wetChunks > 0);
+  REQUIRE(result.dryChunks > 0);
+  REQUIRE(result.mixedChunks > 0);
+
+  for (unsigned int i = 1; i <= Size; i++) {
+    REQUIRE(std::isfinite(double(result.h[i])));
+    REQUIRE(result.h[i] >= 0);
+  }
+  // Nothing reached the right boundary yet
+  REQUIRE(result.h[Size] < Precision::Double::H_MIN);
+}
+
+TEST_CASE("Wet kernel timings", "[.report][ChunkClassification]") {
+  std::printf("%-22s %9s %9s %9s\n", "policy", "general", "wet", "speedup");
+  std::printf("%-22s %9s %9s %9s\n", "", "ns/edge", "ns/edge", "");
+  reportRow<Precision::Double>("Double");
+  reportRow<Precision::Float>("Float");
+  reportRow<Precision::MixedASafe>("MixedASafe");
+  reportRow<Precision::MixedC>("MixedC");
+}
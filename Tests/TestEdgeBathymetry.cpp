@@ -0,0 +1,204 @@
+/**
+ * @file TestEdgeBathymetry.cpp
+ * contains tests for the precomputed per-edge bathymetry of WavePropagationBlockMixed
+ *
+ * @test RusanovMixed with precomputed terms is bit-identical to the overload taking bL, bR
+ * @test Block steps over a bumpy bed with walls match a reference that reads bL, bR per edge
+ * @test setCell refreshes the bathymetry of the chunk it touches
+ *
+ * The hidden test case "[.report]" times both per-edge overloads and the wet kernel:
+ *   ./TestEdgeBathymetry "[.report]"
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Blocks/WavePropagationBlockMixed.hpp"
+#include "EdgeStates.hpp"
+#include "Solver/RusanovMixed.hpp"
+
+namespace {
+
+  // Wet and dry sides, walls on either side and bed steps that dry a reconstructed depth
+  const Tests::EdgeRange WetDryStates = {.seed = 38, .bed = -75.0, .bedStep = 25.0, .wetDry = true};
+
+  template <class Policy>
+  void requireBitIdentical() {
+    using Work   = typename Policy::Work;
+    using Solver = Solvers::RusanovMixed<Policy>;
+    Solver solver;
+
+    for (const auto& s : Tests::fuzzedStates(100000, WetDryStates)) {
+      const Work hL = Work(s.hL), hR = Work(s.hR), huL = Work(s.huL), huR = Work(s.huR);
+
+      Work          dropLeft, dropRight, deltaB;
+      unsigned char wall;
+      Solver::computeEdgeBathymetry(Work(s.bL), Work(s.bR), dropLeft, dropRight, deltaB, wall);
+
+      Work raw[5], precomputed[5];
+      solver.computeNetUpdates(hL, hR, huL, huR, Work(s.bL), Work(s.bR), raw[0], raw[1], raw[2], raw[3], raw[4]);
+      solver.computeNetUpdates(
+        hL, hR, huL, huR, dropLeft, dropRight, deltaB, wall, precomputed[0], precomputed[1], precomputed[2], precomputed[3], precomputed[4]
+      );
+      for (int k = 0; k < 5; k++) {
+        REQUIRE(precomputed[k] == raw[k]);
+      }
+    }
+  }
+
+  // Reference step: per edge from the raw bathymetry of the cells, as before the precomputation
+  double referenceStep(std::vector<RealType>& h, std::vector<RealType>& hu, const std::vector<RealType>& b, unsigned int size) {
+    Solvers::RusanovMixed<Precision::Double> solver;
+    std::vector<double>                      hL(size + 1), hR(size + 1), huL(size + 1), huR(size + 1);
+
+    double maxSpeed = 0.0;
+    for (unsigned int e = 0; e <= size; e++) {
+      double speed;
+      solver.computeNetUpdates(h[e], h[e + 1], hu[e], hu[e + 1], b[e], b[e + 1], hL[e], hR[e], huL[e], huR[e], speed);
+      maxSpeed = std::max(maxSpeed, speed);
+    }
+
+    const double dt = 1.0 / maxSpeed * Precision::Double::CFL;
+    for (unsigned int i = 1; i <= size; i++) {
+      const double hNew  = std::fma(-dt, hR[i - 1] + hL[i], h[i]);
+      const double huNew = std::fma(-dt, huR[i - 1] + huL[i], hu[i]);
+      h[i]               = RealType(hNew < 0 ? 0 : hNew);
+      hu[i]              = RealType(hNew < 0 ? 0 : huNew);
+    }
+    return dt;
+  }
+
+  template <class Policy>
+  void reportRow(const char* name) {
+    using Work                   = typename Policy::Work;
+    using Solver                 = Solvers::RusanovMixed<Policy>;
+    constexpr unsigned int Edges = 1 << 20;
+
+    std::mt19937                           gen(5);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<Work>                      h(Edges + 1), hu(Edges + 1), b(Edges + 1);
+    for (unsigned int i = 0; i <= Edges; i++) {
+      h[i]  = Work(1.0 + 10.0 * unit(gen));
+      hu[i] = Work(h[i] * (unit(gen) - 0.5));
+      b[i]  = Work(-100.0 - 0.5 * unit(gen));
+    }
+    std::vector<Work>          dropLeft(Edges), dropRight(Edges), deltaB(Edges), hL(Edges), hR(Edges), huL(Edges), huR(Edges);
+    std::vector<unsigned char> wall(Edges);
+    for (unsigned int k = 0; k < Edges; k++) {
+      Solver::computeEdgeBathymetry(b[k], b[k + 1], dropLeft[k], dropRight[k], deltaB[k], wall[k]);
+    }
+
+    Solver solver;
+    Work   sink = Work(0);
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int k = 0; k < Edges; k++) {
+      Work speed;
+      solver.computeNetUpdates(h[k], h[k + 1], hu[k], hu[k + 1], b[k], b[k + 1], hL[k], hR[k], huL[k], huR[k], speed);
+      sink = std::max(sink, speed);
+    }
+    const double raw = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / Edges;
+
+    start = std::chrono::steady_clock::now();
+    for (unsigned int k = 0; k < Edges; k++) {
+      Work speed;
+      solver.computeNetUpdates(
+        h[k], h[k + 1], hu[k], hu[k + 1], dropLeft[k], dropRight[k], deltaB[k], wall[k], hL[k], hR[k], huL[k], huR[k], speed
+      );
+      sink = std::max(sink, speed);
+    }
+    const double precomputed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / Edges;
+
+    start = std::chrono::steady_clock::now();
+    for (unsigned int first = 0; first < Edges; first += Blocks::ChunkSize) {
+      Work speed;
+      solver.computeWetNetUpdates(
+        Blocks::ChunkSize, &h[first], &hu[first], &dropLeft[first], &dropRight[first], &deltaB[first], &hL[first], &hR[first], &huL[first], &huR[first], speed
+      );
+      sink = std::max(sink, speed);
+    }
+    const double wet = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / Edges;
+
+    REQUIRE(double(sink) > 0.0);
+    std::printf("%-12s %9.2f %12.2f %9.2f\n", name, raw, precomputed, wet);
+  }
+
+} // namespace
+
+TEST_CASE("Precomputed edge bathymetry is bit-identical", "[EdgeBathymetry]") {
+  requireBitIdentical<Precision::Double>();
+  requireBitIdentical<Precision::Float>();
+  requireBitIdentical<Precision::MixedC>();
+}
+
+TEST_CASE("Block matches the raw bathymetry reference", "[EdgeBathymetry]") {
+  constexpr unsigned int Size  = 500;
+  constexpr unsigned int Steps = 100;
+
+  // Bumpy bed rising above the surface at the right end (walls), a dam on the left
+  std::vector<RealType> h(Size + 2), hu(Size + 2, 0), b(Size + 2);
+  for (unsigned int i = 0; i < Size + 2; i++) {
+    const double x = double(i) / Size;
+    b[i]           = RealType(-2.0 + 0.5 * std::sin(40.0 * x) + 2.5 * x * x * x);
+    h[i]           = std::max(RealType(0), (x < 0.3 ? RealType(1) : RealType(0)) - b[i]);
+  }
+
+  Blocks::WavePropagationBlockMixed<Precision::Double> block(h.data(), hu.data(), b.data(), Size, 1);
+  std::vector<RealType>                                hOut(Size + 2), huOut(Size + 2), bOut(Size + 2);
+  for (unsigned int step = 0; step < Steps; step++) {
+    block.applyBoundaryConditions();
+    block.getState(hOut.data(), huOut.data(), bOut.data());
+
+    const double reference = referenceStep(hOut, huOut, bOut, Size);
+    const double dt        = block.computeNumericalFluxes();
+    block.updateUnknowns(dt);
+    REQUIRE_THAT(dt, Catch::Matchers::WithinRel(reference, 1e-12));
+
+    std::vector<RealType> h1(Size + 2), hu1(Size + 2), b1(Size + 2);
+    block.getState(h1.data(), hu1.data(), b1.data());
+    for (unsigned int i = 1; i <= Size; i++) {
+      REQUIRE_THAT(double(h1[i]), Catch::Matchers::WithinAbs(double(hOut[i]), 1e-12));
+      REQUIRE_THAT(double(hu1[i]), Catch::Matchers::WithinAbs(double(huOut[i]), 1e-12));
+      REQUIRE(b1[i] == bOut[i]);
+    }
+  }
+  REQUIRE(block.getWetChunks() > 0);
+  REQUIRE(block.getMixedChunks() > 0);
+}
+
+TEST_CASE("setCell refreshes the edge bathymetry", "[EdgeBathymetry]") {
+  constexpr unsigned int Size = 4 * Blocks::ChunkSize;
+
+  std::vector<RealType> h(Size + 2, 1), hu(Size + 2, 0), b(Size + 2, -1);
+  Blocks::WavePropagationBlockMixed<Precision::Double> block(h.data(), hu.data(), b.data(), Size, 1);
+  block.setLeftBoundaryCondition(Blocks::WavePropagationBlockMixed<Precision::Double>::PrescribedBoundary);
+
+  block.applyBoundaryConditions();
+  block.computeNumericalFluxes();
+  REQUIRE(block.getMixedChunks() == 0);
+
+  // A wall in the left ghost cell turns the first chunk mixed and reflects the flow
+  block.resetChunkCounters();
+  block.setCell(0, 1, 0, 1);
+  block.computeNumericalFluxes();
+  REQUIRE(block.getMixedChunks() == 1);
+
+  // Back to the old bed: all wet again
+  block.resetChunkCounters();
+  block.setCell(0, 1, 0, -1);
+  block.computeNumericalFluxes();
+  REQUIRE(block.getMixedChunks() == 0);
+}
+
+TEST_CASE("Raw and precomputed bathymetry timings", "[.report][EdgeBathymetry]") {
+  std::printf("%-12s %9s %12s %9s\n", "policy", "bL, bR", "precomputed", "wet");
+  std::printf("%-12s %9s %12s %9s\n", "", "ns/edge", "ns/edge", "ns/edge");
+  reportRow<Precision::Double>("Double");
+  reportRow<Precision::Float>("Float");
+  reportRow<Precision::MixedC>("MixedC");
+}
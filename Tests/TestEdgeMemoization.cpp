@@ -0,0 +1,142 @@
+/**
+ * @file TestEdgeMemoization.cpp
+ * contains tests for the memoization of repeated edges in WavePropagationBlockMixed
+ *
+ * @test Memoized runs give the state of unmemoized runs for every solver
+ * @test A dam break copies most of its edges while the constant states last
+ * @test Memoization turns itself off on a heterogeneous state
+ *
+ * The hidden test case "[.report]" prints hit rates and run times with and without memoization:
+ *   ./TestEdgeMemoization "[.report]"
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Scenarios/DamBreakScenario.hpp"
+#include "Scenarios/ShockRareProblemScenario.hpp"
+#include "Simulation/Simulation.hpp"
+#include "Simulation/SolverRegistry.hpp"
+
+namespace {
+
+  constexpr unsigned int Size  = 1000;
+  constexpr unsigned int Steps = 200;
+
+  // Lake with a randomly perturbed surface: no two neighbouring cells are equal
+  class NoisyLakeScenario: public Scenarios::Scenario {
+    std::vector<RealType> h_;
+
+  public:
+    explicit NoisyLakeScenario(unsigned int size):
+      h_(size + 2) {
+      std::mt19937                           gen(3);
+      std::uniform_real_distribution<double> noise(-0.01, 0.01);
+      for (auto& h : h_) {
+        h = RealType(10.0 + noise(gen));
+      }
+    }
+
+    RealType getCellSize() const override { return 1.0; }
+    RealType getHeight(unsigned int pos) const override { return h_[pos]; }
+    RealType getMomentum(unsigned int) const override { return 0.0; }
+  };
+
+  Simulation::RunOptions memoized() {
+    Simulation::RunOptions options;
+    options.memoize = true;
+    return options;
+  }
+
+  template <class Policy>
+  void requireSameAsUnmemoized(const Scenarios::Scenario& scenario) {
+    for (const std::string& name : Simulation::getSolverNames()) {
+      INFO(Policy::name << " with " << name);
+      Simulation::SolverSpec spec;
+      spec.name = name;
+      REQUIRE(Simulation::visitSolver<Policy>(spec, [&](const auto& solver) {
+        using Solver     = std::remove_cvref_t<decltype(solver)>;
+        const auto plain = Simulation::run<Policy, Solver>(scenario, Size, Steps, nullptr, solver);
+        const auto memo  = Simulation::run<Policy, Solver>(scenario, Size, Steps, nullptr, solver, memoized());
+        for (unsigned int i = 1; i <= Size; i++) {
+          // Memoized chunks solve their run heads edge by edge instead of with the wet kernel
+          REQUIRE_THAT(double(memo.h[i]), Catch::Matchers::WithinRel(double(plain.h[i]), 1e-5));
+          REQUIRE_THAT(double(memo.hu[i]), Catch::Matchers::WithinAbs(double(plain.hu[i]), 1e-5 * std::abs(double(plain.h[i]))));
+        }
+        REQUIRE_THAT(double(memo.time), Catch::Matchers::WithinRel(double(plain.time), 1e-5));
+      }));
+    }
+  }
+
+} // namespace
+
+TEST_CASE("Memoized runs match unmemoized runs", "[EdgeMemoization]") {
+  Scenarios::DamBreakScenario         damBreak(1000, Size, 14, 3.5, 0);
+  Scenarios::ShockRareProblemScenario shockShock(1000, Size, Size / 2, 10, 20);
+  requireSameAsUnmemoized<Precision::Double>(damBreak);
+  requireSameAsUnmemoized<Precision::Double>(shockShock);
+  requireSameAsUnmemoized<Precision::Float>(damBreak);
+  requireSameAsUnmemoized<Precision::MixedASafe>(shockShock);
+}
+
+TEST_CASE("A dam break copies most of its edges", "[EdgeMemoization]") {
+  Scenarios::DamBreakScenario                    damBreak(1000, Size, 14, 3.5, 0);
+  const Solvers::RusanovMixed<Precision::Double> solver;
+  const auto result = Simulation::run<Precision::Double>(damBreak, Size, Steps, nullptr, solver, memoized());
+
+  REQUIRE(result.memoEdges == Steps * (Size + 1ULL));
+  REQUIRE(result.memoOffStep == 0);
+  REQUIRE(double(result.memoHits) / double(result.memoEdges) > 0.5);
+
+  // Without the option, nothing is counted
+  const auto plain = Simulation::run<Precision::Double>(damBreak, Size, Steps);
+  REQUIRE(plain.memoEdges == 0);
+  REQUIRE(plain.memoHits == 0);
+}
+
+TEST_CASE("Memoization turns itself off on a heterogeneous state", "[EdgeMemoization]") {
+  const NoisyLakeScenario                        noisy(Size);
+  const Solvers::RusanovMixed<Precision::Double> solver;
+  const auto result = Simulation::run<Precision::Double>(noisy, Size, Steps, nullptr, solver, memoized());
+
+  REQUIRE(result.memoOffStep == 1);
+  REQUIRE(result.memoEdges == Size + 1);
+  REQUIRE(result.memoHits < (Size + 1) / Blocks::ChunkSize);
+}
+
+TEST_CASE("Memoization hit rates and run times", "[.report][EdgeMemoization]") {
+  constexpr unsigned int              LargeSize = 1 << 16;
+  Scenarios::DamBreakScenario         damBreak(1000, LargeSize, 14, 3.5, 0);
+  Scenarios::ShockRareProblemScenario shockShock(1000, LargeSize, LargeSize / 2, 10, 20);
+  const NoisyLakeScenario             noisy(LargeSize);
+
+  std::printf("%-12s %-10s %8s %8s %10s %10s\n", "scenario", "solver", "hitRate", "offStep", "plain[s]", "memo[s]");
+  const auto report = [&](const char* scenarioName, const Scenarios::Scenario& scenario, const std::string& name) {
+    Simulation::SolverSpec spec;
+    spec.name = name;
+    Simulation::visitSolver<Precision::Double>(spec, [&](const auto& solver) {
+      using Solver     = std::remove_cvref_t<decltype(solver)>;
+      const auto plain = Simulation::run<Precision::Double, Solver>(scenario, LargeSize, 500, nullptr, solver);
+      const auto memo  = Simulation::run<Precision::Double, Solver>(scenario, LargeSize, 500, nullptr, solver, memoized());
+      std::printf(
+        "%-12s %-10s %8.3f %8u %10.4f %10.4f\n",
+        scenarioName,
+        name.c_str(),
+        double(memo.memoHits) / double(memo.memoEdges),
+        memo.memoOffStep,
+        plain.seconds,
+        memo.seconds
+      );
+    });
+  };
+  for (const char* name : {"rusanov", "roe", "augmented"}) {
+    report("dam break", damBreak, name);
+    report("shock-shock", shockShock, name);
+    report("noisy lake", noisy, name);
+  }
+}
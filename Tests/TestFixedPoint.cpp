@@ -0,0 +1,149 @@
+/**
+ * @file TestFixedPoint.cpp
+ * contains tests for the fixed-point storage layout (Blocks/StateStorage.hpp)
+ *
+ * @test Quantization error is at most half a unit per variable
+ * @test A dam break between two walls conserves mass bit for bit
+ * @test Values outside the Store range are detected
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <vector>
+
+#include "Blocks/StateStorage.hpp"
+#include "Blocks/WavePropagationBlockMixed.hpp"
+#include "Scenarios/DamBreakScenario.hpp"
+#include "Tools/PrecisionPolicy.hpp"
+
+namespace {
+
+  constexpr unsigned int Size = 500;
+
+  template <class Policy>
+  struct DamBreakInBox {
+    std::vector<RealType>                     h, hu, b;
+    Blocks::WavePropagationBlockMixed<Policy> block;
+
+    static Blocks::WavePropagationBlockMixed<Policy> makeBlock(std::vector<RealType>& h, std::vector<RealType>& hu, std::vector<RealType>& b) {
+      Scenarios::DamBreakScenario scenario(1000, Size, 14, 3.5, 0);
+      for (unsigned int i = 0; i < Size + 2; i++) {
+        h[i]  = scenario.getHeight(i);
+        hu[i] = scenario.getMomentum(i);
+        b[i]  = scenario.getBathymetry(i);
+      }
+      return Blocks::WavePropagationBlockMixed<Policy>(h.data(), hu.data(), b.data(), Size, scenario.getCellSize());
+    }
+
+    DamBreakInBox():
+      h(Size + 2),
+      hu(Size + 2),
+      b(Size + 2),
+      block(makeBlock(h, hu, b)) {
+      block.setLeftBoundaryCondition(Blocks::WavePropagationBlockMixed<Policy>::ReflectingBoundary);
+      block.setRightBoundaryCondition(Blocks::WavePropagationBlockMixed<Policy>::ReflectingBoundary);
+    }
+
+    void run(unsigned int steps) {
+      for (unsigned int s = 0; s < steps; s++) {
+        block.applyBoundaryConditions();
+        block.updateUnknowns(block.computeNumericalFluxes());
+      }
+      block.getState(h.data(), hu.data(), b.data());
+    }
+
+    // Exact for fixed point: every h is a multiple of h_scale
+    double mass() const {
+      double mass = 0.0;
+      for (unsigned int i = 1; i <= Size; i++) {
+        mass += double(h[i]);
+      }
+      return mass;
+    }
+  };
+
+  template <class Policy>
+  void checkQuantization() {
+    std::vector<RealType> h(Size), hu(Size), b(Size);
+    for (unsigned int i = 0; i < Size; i++) {
+      h[i]  = RealType(10.0 + 5.0 * std::sin(0.37 * i));
+      hu[i] = RealType(50.0 * std::cos(0.11 * i));
+      b[i]  = RealType(-10.0 - 5.0 * std::sin(0.05 * i));
+    }
+
+    Blocks::StateStorage<Policy> storage(Size);
+    storage.assign(h.data(), hu.data(), b.data());
+    REQUIRE_FALSE(storage.hasOverflowed());
+
+    std::vector<RealType> hOut(Size), huOut(Size), bOut(Size);
+    storage.extract(hOut.data(), huOut.data(), bOut.data());
+    for (unsigned int i = 0; i < Size; i++) {
+      REQUIRE(std::fabs(double(hOut[i]) - double(h[i])) <= 0.5 * Policy::h_scale);
+      REQUIRE(std::fabs(double(huOut[i]) - double(hu[i])) <= 0.5 * Policy::hu_scale);
+      REQUIRE(std::fabs(double(bOut[i]) - double(b[i])) <= 0.5 * Policy::b_scale);
+    }
+  }
+
+  template <class Policy>
+  void checkConservation() {
+    DamBreakInBox<Policy> box;
+    box.run(0);
+    const double initialMass = box.mass();
+
+    box.run(1000);
+    REQUIRE_FALSE(box.block.hasOverflowed());
+    // Bit for bit, not within a tolerance
+    REQUIRE(box.mass() == initialMass);
+  }
+
+} // namespace
+
+TEST_CASE("Fixed point quantization", "[FixedPoint]") {
+  checkQuantization<Precision::FixedPoint32>();
+  checkQuantization<Precision::FixedPoint16>();
+}
+
+TEST_CASE("Fixed point conserves mass exactly", "[FixedPoint]") {
+  SECTION("int32") { checkConservation<Precision::FixedPoint32>(); }
+  SECTION("int16") { checkConservation<Precision::FixedPoint16>(); }
+}
+
+TEST_CASE("Fixed point follows the double reference", "[FixedPoint]") {
+  DamBreakInBox<Precision::Double>       reference;
+  DamBreakInBox<Precision::FixedPoint32> fixedPoint;
+  reference.run(200);
+  fixedPoint.run(200);
+
+  for (unsigned int i = 1; i <= Size; i++) {
+    REQUIRE_THAT(double(fixedPoint.h[i]), Catch::Matchers::WithinAbs(double(reference.h[i]), 1e-3));
+  }
+  REQUIRE(Blocks::StateStorage<Precision::FixedPoint32>::bytesPerCell == 0.5 * Blocks::StateStorage<Precision::Double>::bytesPerCell);
+}
+
+TEST_CASE("Fixed point detects overflow", "[FixedPoint]") {
+  SECTION("on import") {
+    std::vector<RealType> h(Size, 40), hu(Size, 0), b(Size, -40); // 40 m do not fit into 16 bit with 2^-10 m
+
+    Blocks::StateStorage<Precision::FixedPoint16> storage(Size);
+    storage.assign(h.data(), hu.data(), b.data());
+    REQUIRE(storage.hasOverflowed());
+
+    std::vector<RealType> hOut(Size), huOut(Size), bOut(Size);
+    storage.extract(hOut.data(), huOut.data(), bOut.data());
+    REQUIRE_THAT(double(hOut[0]), Catch::Matchers::WithinAbs(32767 * Precision::FixedPoint16::h_scale, 1e-9));
+  }
+
+  SECTION("during an update") {
+    std::vector<RealType> h(Size, 30), hu(Size, 0), b(Size, -30);
+
+    Blocks::StateStorage<Precision::FixedPoint16> storage(Size);
+    storage.assign(h.data(), hu.data(), b.data());
+    REQUIRE_FALSE(storage.hasOverflowed());
+
+    // Push 4 m into cell 1
+    std::vector<float> zero(Size, 0.0f), inflow(Size, 0.0f);
+    inflow[0] = -4.0f;
+    storage.update(1, 1, 1.0f, zero.data(), inflow.data(), zero.data(), zero.data());
+    REQUIRE(storage.hasOverflowed());
+  }
+}
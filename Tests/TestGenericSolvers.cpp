@@ -0,0 +1,147 @@
+/**
+ * @file TestGenericSolvers.cpp
+ * contains tests for the solvers templated on the precision policy
+ *
+ * @test Every solver gives the Double net updates up to the work precision for the Float and Mixed A policies
+ * @test The RealType aliases (RusanovWetDry, OsherSolver) are the solvers on Precision::RealTypePolicy
+ * @test FWaveMixed keeps a lake at rest and matches the mirrored problem at a dry neighbour
+ *
+ * The hidden test case "[.report]" times every solver for every base policy:
+ *   ./TestGenericSolvers "[.report]"
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "EdgeStates.hpp"
+#include "Solver/AugumentedMixed.hpp"
+#include "Solver/FWaveMixed.hpp"
+#include "Solver/HLLCMixed.hpp"
+#include "Solver/Osher.hpp"
+#include "Solver/RoeMixed.hpp"
+#include "Solver/RusanovWetDry.hpp"
+
+namespace {
+
+  using Tests::EdgeState;
+
+  // Wet states with Froude numbers up to 2 and small bed steps
+  const Tests::EdgeRange WetStates = {.minLogDepth = 0.0, .maxLogDepth = 1.0, .bed = -20.0, .bedStep = 0.5};
+
+  template <class Policy, template <class> class Solver>
+  void solve(const EdgeState& s, double out[5]) {
+    using Work = typename Policy::Work;
+    Solver<Policy> solver;
+    Work           r[5];
+    solver.computeNetUpdates(Work(s.hL), Work(s.hR), Work(s.huL), Work(s.huR), Work(s.bL), Work(s.bR), r[0], r[1], r[2], r[3], r[4]);
+    for (int k = 0; k < 5; k++) {
+      out[k] = double(r[k]);
+    }
+  }
+
+  // The policy's net updates relative to the Double ones, scaled by the largest flux magnitude of the edge
+  template <class Policy, template <class> class Solver>
+  double maxDeviationFromDouble(const std::vector<EdgeState>& states) {
+    double deviation = 0.0;
+    for (const auto& s : states) {
+      double reference[5], result[5];
+      solve<Precision::Double, Solver>(s, reference);
+      solve<Policy, Solver>(s, result);
+
+      double scale = 1.0;
+      for (int k = 0; k < 5; k++) {
+        scale = std::max(scale, std::abs(reference[k]));
+      }
+      for (int k = 0; k < 5; k++) {
+        deviation = std::max(deviation, std::abs(result[k] - reference[k]) / scale);
+      }
+    }
+    return deviation;
+  }
+
+  template <template <class> class Solver>
+  void requireConsistentAcrossPolicies(const std::vector<EdgeState>& states) {
+    CHECK(maxDeviationFromDouble<Precision::Float, Solver>(states) < 1e-4);
+    CHECK(maxDeviationFromDouble<Precision::MixedASafe, Solver>(states) < 1e-4);
+    CHECK(maxDeviationFromDouble<Precision::MixedC, Solver>(states) < 1e-2);
+  }
+
+  template <class Policy, template <class> class Solver>
+  double nsPerEdge(const std::vector<EdgeState>& states) {
+    Solver<Policy> solver;
+    return Tests::nsPerEdge<typename Policy::Work>(solver, states);
+  }
+
+  template <template <class> class Solver>
+  void reportRow(const char* name, const std::vector<EdgeState>& states) {
+    std::printf("%-10s", name);
+    std::printf(" %7.2f", nsPerEdge<Precision::Double, Solver>(states));
+    std::printf(" %7.2f", nsPerEdge<Precision::Float, Solver>(states));
+    std::printf(" %7.2f", nsPerEdge<Precision::MixedASafe, Solver>(states));
+    std::printf(" %7.2f", nsPerEdge<Precision::MixedBAggressive, Solver>(states));
+    std::printf(" %7.2f", nsPerEdge<Precision::MixedC, Solver>(states));
+    std::printf(" %7.2f", nsPerEdge<Precision::FixedPoint32, Solver>(states));
+    std::printf("\n");
+  }
+
+} // namespace
+
+TEST_CASE("Every solver is consistent across precision policies", "[GenericSolvers]") {
+  const auto states = Tests::fuzzedStates(10000, WetStates);
+  requireConsistentAcrossPolicies<Solvers::RusanovMixed>(states);
+  requireConsistentAcrossPolicies<Solvers::HLLCMixed>(states);
+  requireConsistentAcrossPolicies<Solvers::RoeMixed>(states);
+  requireConsistentAcrossPolicies<Solvers::OsherMixed>(states);
+  requireConsistentAcrossPolicies<Solvers::FWaveMixed>(states);
+  requireConsistentAcrossPolicies<Solvers::AugumentedMixed>(states);
+}
+
+TEST_CASE("The RealType solvers are the generic solvers on RealTypePolicy", "[GenericSolvers]") {
+#ifndef SWE_PRIMED_SCALING
+  STATIC_REQUIRE(std::is_same_v<Solvers::RusanovWetDry, Solvers::RusanovMixed<Precision::RealTypePolicy>>);
+#endif
+  STATIC_REQUIRE(std::is_same_v<Solvers::OsherSolver, Solvers::OsherMixed<Precision::RealTypePolicy>>);
+}
+
+TEST_CASE("F-wave keeps a lake at rest and reflects at a dry neighbour", "[GenericSolvers]") {
+  const Solvers::FWaveMixed<Precision::Double> solver;
+
+  std::mt19937                           gen(11);
+  std::uniform_real_distribution<double> bed(-100.0, -0.1);
+  for (unsigned int run = 0; run < 10000; run++) {
+    const double bL = bed(gen), bR = bed(gen);
+    double       out[5];
+    solver.computeNetUpdates(-bL, -bR, 0, 0, bL, bR, out[0], out[1], out[2], out[3], out[4]);
+    for (int k = 0; k < 4; k++) {
+      REQUIRE(std::abs(out[k]) < 1e-12 * std::max(1.0, out[4] * std::max(-bL, -bR)));
+    }
+  }
+
+  // Dry right cell: the left side gets the updates of the mirrored problem
+  const auto states = Tests::fuzzedStates(1000, WetStates);
+  for (const auto& s : states) {
+    double dry[5], mirrored[5];
+    solver.computeNetUpdates(s.hL, 0, s.huL, 0, s.bL, s.bL, dry[0], dry[1], dry[2], dry[3], dry[4]);
+    solver.computeNetUpdates(s.hL, s.hL, s.huL, -s.huL, s.bL, s.bL, mirrored[0], mirrored[1], mirrored[2], mirrored[3], mirrored[4]);
+    REQUIRE(dry[0] == mirrored[0]);
+    REQUIRE(dry[2] == mirrored[2]);
+    REQUIRE(dry[1] == 0);
+    REQUIRE(dry[3] == 0);
+    REQUIRE(dry[4] == mirrored[4]);
+  }
+}
+
+TEST_CASE("Solver cost per precision policy", "[.report][GenericSolvers]") {
+  const auto states = Tests::fuzzedStates(1 << 20, WetStates);
+  std::printf("ns/edge    %7s %7s %7s %7s %7s %7s\n", "Double", "Float", "MixedA", "MixedB", "MixedC", "Fixed32");
+  reportRow<Solvers::RusanovMixed>("Rusanov", states);
+  reportRow<Solvers::HLLCMixed>("HLLC", states);
+  reportRow<Solvers::RoeMixed>("Roe", states);
+  reportRow<Solvers::OsherMixed>("Osher", states);
+  reportRow<Solvers::FWaveMixed>("f-wave", states);
+  reportRow<Solvers::AugumentedMixed>("Augmented", states);
+}
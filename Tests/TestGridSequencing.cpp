@@ -0,0 +1,154 @@
+/**
+ * @file TestGridSequencing.cpp
+ * contains tests for grid sequencing (Simulation/GridSequencing.hpp)
+ *
+ * @test The scenarios evaluate the same flow at any resolution
+ * @test The prolongation conserves mass and momentum and keeps a flat surface flat
+ * @test The sequenced run converges to the steady state of the direct run
+ *
+ * The hidden test case "[.report]" prints the wall time to the steady state with and without grid sequencing:
+ *   ./TestGridSequencing "[.report]"
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "Results.hpp"
+#include "Scenarios/DamBreakScenario.hpp"
+#include "Scenarios/SubcriticalFlowScenario.hpp"
+#include "Scenarios/SupercriticalFlowScenario.hpp"
+#include "Simulation/GridSequencing.hpp"
+
+namespace {
+
+  constexpr unsigned int Size     = 512;
+  constexpr unsigned int MaxSteps = 100000;
+
+  Simulation::RunOptions steadyBelow(double tolerance) {
+    Simulation::RunOptions options;
+    options.steadyTolerance = tolerance;
+    return options;
+  }
+
+} // namespace
+
+TEST_CASE("The scenarios evaluate the same flow at any resolution", "[GridSequencing]") {
+  const Scenarios::SubcriticalFlowScenario fine(Size);
+  const auto                               coarse = fine.atResolution(Size / 4);
+  REQUIRE(coarse);
+  REQUIRE_THAT(double(coarse->getCellSize()), Catch::Matchers::WithinRel(4.0 * fine.getCellSize(), 1e-6));
+  // Coarse cell j lies at the position of fine cell 4j
+  for (unsigned int j = 0; j < Size / 4 + 2; j++) {
+    REQUIRE_THAT(double(coarse->getBathymetry(j)), Catch::Matchers::WithinAbs(double(fine.getBathymetry(4 * j)), 1e-6));
+    REQUIRE(coarse->getMomentum(j) == fine.getMomentum(4 * j));
+  }
+
+  // Given cells have one resolution only
+  const Simulation::GridState state(std::vector<RealType>(4, 1.0), std::vector<RealType>(4, 0.0), std::vector<RealType>(4, -1.0), 1.0);
+  REQUIRE_FALSE(state.atResolution(4));
+  REQUIRE(Simulation::getSequencingLevels(state, 2, 1) == 0);
+  // 500 = 4 * 125: two coarse grids at most
+  REQUIRE(Simulation::getSequencingLevels(fine, 500, 3) == 2);
+  REQUIRE(Simulation::getSequencingLevels(fine, Size, 3) == 3);
+}
+
+TEST_CASE("The prolongation conserves mass and momentum", "[GridSequencing]") {
+  const Scenarios::SubcriticalFlowScenario coarseScenario(Size / 2);
+  const Scenarios::SubcriticalFlowScenario fineScenario(Size);
+
+  // A wave on the steady-flow bathymetry
+  std::vector<RealType> h(Size / 2 + 2), hu(Size / 2 + 2), b(Size / 2 + 2), fineB(Size + 2), fineH(Size + 2), fineHu(Size + 2);
+  for (unsigned int j = 0; j < Size / 2 + 2; j++) {
+    b[j]  = coarseScenario.getBathymetry(j);
+    h[j]  = 0.1 * std::sin(0.05 * j) - b[j];
+    hu[j] = 4.42 + std::cos(0.03 * j);
+  }
+  for (unsigned int i = 0; i < Size + 2; i++) {
+    fineB[i] = fineScenario.getBathymetry(i);
+  }
+  Simulation::prolong(h.data(), hu.data(), b.data(), Size / 2, fineB.data(), fineH.data(), fineHu.data());
+
+  for (unsigned int j = 1; j <= Size / 2; j++) {
+    REQUIRE_THAT(double(fineH[2 * j - 1] + fineH[2 * j]), Catch::Matchers::WithinRel(2.0 * h[j], 1e-14));
+    REQUIRE_THAT(double(fineHu[2 * j - 1] + fineHu[2 * j]), Catch::Matchers::WithinRel(2.0 * hu[j], 1e-14));
+  }
+  REQUIRE(fineH[0] == fineH[1]);
+  REQUIRE(fineHu[Size + 1] == fineHu[Size]);
+
+  // Still water on a flat bottom stays flat, a dry cell stays dry
+  std::fill(b.begin(), b.end(), RealType(-2.0));
+  std::fill(fineB.begin(), fineB.end(), RealType(-2.0));
+  std::fill(h.begin(), h.end(), RealType(2.0));
+  std::fill(hu.begin(), hu.end(), RealType(0.0));
+  h[10] = 0.0;
+  Simulation::prolong(h.data(), hu.data(), b.data(), Size / 2, fineB.data(), fineH.data(), fineHu.data());
+  for (unsigned int i = 1; i <= Size; i++) {
+    REQUIRE(fineH[i] == (i == 19 || i == 20 ? 0.0 : 2.0));
+    REQUIRE(fineHu[i] == 0.0);
+  }
+}
+
+TEST_CASE("The sequenced run converges to the steady state of the direct run", "[GridSequencing]") {
+  const Scenarios::SubcriticalFlowScenario       subcritical(Size);
+  const Scenarios::SupercriticalFlowScenario     supercritical(Size);
+  const Solvers::RusanovMixed<Precision::Double> solver;
+
+  const Scenarios::Scenario* const flows[] = {&subcritical, &supercritical};
+  for (const Scenarios::Scenario* scenario : flows) {
+    const auto direct = Simulation::run<Precision::Double>(*scenario, Size, MaxSteps, nullptr, solver, steadyBelow(1e-6));
+
+    std::vector<Simulation::SequencingStage> stages;
+    const auto                               sequenced = Simulation::runSequenced<Precision::Double>(
+      *scenario, Size, 3, MaxSteps, nullptr, solver, steadyBelow(1e-6), &stages
+    );
+
+    REQUIRE(stages.size() == 4);
+    for (unsigned int k = 0; k < stages.size(); k++) {
+      REQUIRE(stages[k].size == Size / 8 << k);
+      REQUIRE(stages[k].steady);
+    }
+    REQUIRE(sequenced.h.size() == Size + 2);
+    REQUIRE(sequenced.steps == stages.back().steps);
+    // The finest grid starts close to its steady state
+    REQUIRE(sequenced.steps < direct.steps);
+    REQUIRE(Tests::maxDifference(sequenced, direct) < 1e-3);
+  }
+
+  // Without coarse grids it is the direct run
+  const auto direct = Simulation::run<Precision::Double>(subcritical, Size, 100, nullptr, solver);
+  const auto single = Simulation::runSequenced<Precision::Double>(subcritical, Size, 0, 100, nullptr, solver);
+  REQUIRE(Tests::maxDifference(single, direct) == 0.0);
+}
+
+TEST_CASE("Wall time to the steady state with grid sequencing", "[.report][GridSequencing]") {
+  const Solvers::RusanovMixed<Precision::Double> solver;
+
+  std::printf("%-14s %8s %7s %10s %10s %8s  %s\n", "scenario", "cells", "levels", "fineSteps", "wall[s]", "speedup", "steps per grid");
+  for (const unsigned int size : {2048u, 8192u}) {
+    const Scenarios::SubcriticalFlowScenario   subcritical(size);
+    const Scenarios::SupercriticalFlowScenario supercritical(size);
+    const Scenarios::Scenario* const           flows[] = {&subcritical, &supercritical};
+    for (const Scenarios::Scenario* scenario : flows) {
+      const char* name   = scenario == &subcritical ? "subcritical" : "supercritical";
+      const auto  direct = Simulation::run<Precision::Double>(*scenario, size, 1000000, nullptr, solver, steadyBelow(1e-6));
+      std::printf("%-14s %8u %7u %10u %10.4f %8s\n", name, size, 0, direct.steps, direct.seconds, "-");
+
+      for (const unsigned int levels : {1u, 2u, 3u, 4u}) {
+        std::vector<Simulation::SequencingStage> stages;
+        const auto                               sequenced = Simulation::runSequenced<Precision::Double>(
+          *scenario, size, levels, 1000000, nullptr, solver, steadyBelow(1e-6), &stages
+        );
+        std::printf(
+          "%-14s %8u %7u %10u %10.4f %8.2f ", name, size, levels, sequenced.steps, sequenced.seconds, direct.seconds / sequenced.seconds
+        );
+        for (const Simulation::SequencingStage& stage : stages) {
+          std::printf(" %u:%u", stage.size, stage.steps);
+        }
+        std::printf("\n");
+      }
+    }
+  }
+}
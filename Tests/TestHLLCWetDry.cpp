@@ -0,0 +1,209 @@
+/**
+ * @file TestHLLCWetDry.cpp
+ * contains tests for Solvers::HLLCMixed
+ *
+ * @test A lake at rest over a bumpy bed with dry banks and walls stays at rest
+ * @test Wet, dry, wall and near-dry states raise no floating-point exception and conserve mass
+ * @test The wet kernel is bit-identical to computeNetUpdates
+ * @test On a flat bed with subcritical wet states it matches Solvers::HLLC
+ * @test A dam break onto a dry bed stays non-negative and conserves mass
+ *
+ * The hidden test case "[.report]" times the solver against HLLC and RusanovMixed:
+ *   ./TestHLLCWetDry "[.report]"
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <algorithm>
+#include <cfenv>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Blocks/WavePropagationBlockMixed.hpp"
+#include "EdgeStates.hpp"
+#include "Scenarios/DamBreakScenario.hpp"
+#include "Simulation/Simulation.hpp"
+#include "Solver/HLLC.hpp"
+#include "Solver/HLLCMixed.hpp"
+#include "Solver/RusanovMixed.hpp"
+
+namespace {
+
+  // Wet states with Froude numbers in [-froude, froude]; optionally dry and near-dry sides, walls and bed steps
+  Tests::EdgeRange fuzzedRange(double froude, bool wetDry) {
+    return {.seed = 40, .froude = froude, .bed = wetDry ? -75.0 : -100.0, .bedStep = wetDry ? 25.0 : 0.0, .wetDry = wetDry};
+  }
+
+  template <class Policy>
+  void requireLakeAtRest(double tolerance) {
+    using Block                  = Blocks::WavePropagationBlockMixed<Policy, Solvers::HLLCMixed<Policy>>;
+    constexpr unsigned int Size  = 500;
+    constexpr unsigned int Steps = 100;
+
+    // Rippled bed with a dry island below zero and a shore rising into walls at the right end
+    std::vector<RealType> h(Size + 2), hu(Size + 2, 0), b(Size + 2);
+    for (unsigned int i = 0; i < Size + 2; i++) {
+      const double x = double(i) / Size;
+      b[i]           = RealType(-3.0 + 0.05 * std::sin(200.0 * x) + 4.0 * x * x * x + (std::fabs(x - 0.3) < 0.02 ? 2.8 : 0.0));
+      h[i]           = std::max(RealType(0), RealType(-0.5) - b[i]);
+    }
+
+    Block block(h.data(), hu.data(), b.data(), Size, 1);
+    for (unsigned int step = 0; step < Steps; step++) {
+      block.applyBoundaryConditions();
+      block.updateUnknowns(block.computeNumericalFluxes());
+    }
+    REQUIRE(block.getWetChunks() > 0);
+    REQUIRE(block.getMixedChunks() > 0);
+
+    std::vector<RealType> h1(Size + 2), hu1(Size + 2), b1(Size + 2);
+    block.getState(h1.data(), hu1.data(), b1.data());
+    for (unsigned int i = 1; i <= Size; i++) {
+      REQUIRE_THAT(double(h1[i]), Catch::Matchers::WithinAbs(double(h[i]), tolerance));
+      REQUIRE_THAT(double(hu1[i]), Catch::Matchers::WithinAbs(0.0, tolerance));
+    }
+  }
+
+  template <class Policy>
+  void requireWetKernelBitIdentical() {
+    using Work   = typename Policy::Work;
+    using Solver = Solvers::HLLCMixed<Policy>;
+    Solver solver;
+
+    // Wet chunks over a gently varying bed, sub- and supercritical in both directions
+    constexpr unsigned int                 Count = Blocks::ChunkSize;
+    std::mt19937                           gen(41);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    for (unsigned int run = 0; run < 1000; run++) {
+      const double      froude = 3.0 * unit(gen);
+      std::vector<Work> h(Count + 1), hu(Count + 1), b(Count + 1);
+      for (unsigned int i = 0; i <= Count; i++) {
+        h[i]  = Work(1.0 + 10.0 * unit(gen));
+        hu[i] = Work(double(h[i]) * froude * (2.0 * unit(gen) - 1.0) * std::sqrt(9.81 * double(h[i])));
+        b[i]  = Work(-100.0 - 0.5 * unit(gen));
+      }
+
+      std::vector<Work>          dropLeft(Count), dropRight(Count), deltaB(Count);
+      std::vector<unsigned char> wall(Count);
+      for (unsigned int k = 0; k < Count; k++) {
+        Solver::computeEdgeBathymetry(b[k], b[k + 1], dropLeft[k], dropRight[k], deltaB[k], wall[k]);
+      }
+
+      std::vector<Work> hL(Count), hR(Count), huL(Count), huR(Count);
+      Work              speed;
+      solver.computeWetNetUpdates(
+        Count, h.data(), hu.data(), dropLeft.data(), dropRight.data(), deltaB.data(), hL.data(), hR.data(), huL.data(), huR.data(), speed
+      );
+
+      // Exact equality holds because SWE-Interface turns off FMA contraction (-ffp-contract=off)
+      Work maxSpeed = Work(0);
+      for (unsigned int k = 0; k < Count; k++) {
+        Work out[5];
+        solver.computeNetUpdates(h[k], h[k + 1], hu[k], hu[k + 1], dropLeft[k], dropRight[k], deltaB[k], wall[k], out[0], out[1], out[2], out[3], out[4]);
+        REQUIRE(out[0] == hL[k]);
+        REQUIRE(out[1] == hR[k]);
+        REQUIRE(out[2] == huL[k]);
+        REQUIRE(out[3] == huR[k]);
+        maxSpeed = std::max(maxSpeed, out[4]);
+      }
+      REQUIRE(speed == maxSpeed);
+    }
+  }
+
+  void reportRow(const char* name, const Simulation::Result& snapshot) {
+    constexpr unsigned int Runs = 20;
+
+    const auto states = Tests::snapshotStates(snapshot);
+
+    Solvers::HLLC                                 hllc;
+    Solvers::HLLCMixed<Precision::RealTypePolicy> wetDry;
+    Solvers::RusanovMixed<Precision::Double>      rusanov;
+    const double                                  hllcCost    = Tests::nsPerEdge<RealType>(hllc, states, Runs);
+    const double                                  wetDryCost  = Tests::nsPerEdge<RealType>(wetDry, states, Runs);
+    const double                                  rusanovCost = Tests::nsPerEdge<RealType>(rusanov, states, Runs);
+    std::printf("%-16s %9.2f %9.2f %9.2f\n", name, hllcCost, wetDryCost, rusanovCost);
+  }
+
+} // namespace
+
+TEST_CASE("HLLCMixed keeps a lake at rest", "[HLLCWetDry]") {
+  requireLakeAtRest<Precision::Double>(1e-12);
+  requireLakeAtRest<Precision::Float>(1e-4);
+  requireLakeAtRest<Precision::MixedC>(1e-4);
+}
+
+TEST_CASE("HLLCMixed raises no floating-point exceptions", "[HLLCWetDry]") {
+  const Solvers::HLLCMixed<Precision::Double> solver;
+
+  std::feclearexcept(FE_ALL_EXCEPT);
+  for (const auto& s : Tests::fuzzedStates(100000, fuzzedRange(3.0, true))) {
+    double out[5];
+    solver.computeNetUpdates(s.hL, s.hR, s.huL, s.huR, s.bL, s.bR, out[0], out[1], out[2], out[3], out[4]);
+
+    for (double v : out) {
+      REQUIRE(std::isfinite(v));
+    }
+    REQUIRE(out[0] == -out[1]);
+    REQUIRE(out[4] >= 0.0);
+  }
+  REQUIRE_FALSE(std::fetestexcept(FE_DIVBYZERO | FE_INVALID));
+}
+
+TEST_CASE("HLLCMixed wet kernel is bit-identical", "[HLLCWetDry]") {
+  requireWetKernelBitIdentical<Precision::Double>();
+  requireWetKernelBitIdentical<Precision::Float>();
+  requireWetKernelBitIdentical<Precision::MixedC>();
+}
+
+TEST_CASE("HLLCMixed matches HLLC on a flat bed", "[HLLCWetDry]") {
+  Solvers::HLLC                                 hllc;
+  const Solvers::HLLCMixed<Precision::Double> wetDry;
+
+  // |Fr| < 1 on both sides keeps SL < 0 < SR
+  for (const auto& s : Tests::fuzzedStates(20000, fuzzedRange(0.9, false))) {
+    RealType reference[5];
+    double   out[5];
+    hllc.computeNetUpdates(s.hL, s.hR, s.huL, s.huR, s.bL, s.bR, reference[0], reference[1], reference[2], reference[3], reference[4]);
+    wetDry.computeNetUpdates(s.hL, s.hR, s.huL, s.huR, s.bL, s.bR, out[0], out[1], out[2], out[3], out[4]);
+
+    const double scale = std::fabs(double(reference[2])) + std::fabs(double(reference[0])) + 1.0;
+    for (int k = 0; k < 4; k++) {
+      REQUIRE_THAT(out[k], Catch::Matchers::WithinAbs(double(reference[k]), 1e-10 * scale));
+    }
+  }
+}
+
+TEST_CASE("HLLCMixed dam break onto a dry bed", "[HLLCWetDry]") {
+  constexpr unsigned int Size  = 1000;
+  constexpr unsigned int Steps = 300;
+
+  // The scenario needs hR > 0; 1e-9 m is below Double's DRY_TOL
+  Scenarios::DamBreakScenario scenario(1000, Size, 2, 1e-9, 0);
+  const auto                  result = Simulation::run<Precision::Double, Solvers::HLLCMixed<Precision::Double>>(scenario, Size, Steps);
+
+  double mass = 0.0, mass0 = 0.0;
+  for (unsigned int i = 1; i <= Size; i++) {
+    REQUIRE(std::isfinite(double(result.h[i])));
+    REQUIRE(result.h[i] >= 0);
+    mass += double(result.h[i]);
+    mass0 += double(scenario.getHeight(i));
+  }
+  // The front has not reached the boundaries
+  REQUIRE_THAT(mass, Catch::Matchers::WithinRel(mass0, 1e-10));
+  REQUIRE(result.h[Size] < Precision::Double::DRY_TOL);
+}
+
+TEST_CASE("HLLCMixed per-edge cost", "[.report][HLLCWetDry]") {
+  constexpr unsigned int Size = 100000;
+
+  Scenarios::DamBreakScenario wet(1000, Size, 14, 3.5, 0);
+  Scenarios::DamBreakScenario dry(1000, Size, 2, 1e-9, 0);
+  const auto                  wetSnapshot = Simulation::run<Precision::Double>(wet, Size, 2000);
+  const auto                  drySnapshot = Simulation::run<Precision::Double>(dry, Size, 2000);
+
+  std::printf("%-16s %9s %9s %9s\n", "snapshot", "HLLC", "HLLCMixed", "Rusanov");
+  std::printf("%-16s %9s %9s %9s\n", "", "ns/edge", "ns/edge", "ns/edge");
+  reportRow("wet dam break", wetSnapshot);
+  reportRow("dry dam break", drySnapshot);
+}
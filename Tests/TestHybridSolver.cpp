@@ -0,0 +1,209 @@
+/**
+ * @file TestHybridSolver.cpp
+ * contains tests for Solvers::HybridSolver
+ *
+ * @test The sensor routes jumps and transcritical edges to Osher, smooth and dry edges to Rusanov
+ * @test Rough edges get exactly the net updates of OsherMixed on the same policy
+ * @test With a well-balanced expensive solver, surface jumps over a bed step are rough, a lake at rest is not
+ * @test The batch interface returns the same net updates as edge by edge
+ * @test A hybrid dam break conserves mass and uses Osher on a small fraction of the edges
+ *
+ * The hidden test case "[.report]" times Rusanov, Osher and the hybrid on a dam break snapshot:
+ *   ./TestHybridSolver "[.report]"
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Scenarios/DamBreakScenario.hpp"
+#include "Simulation/Simulation.hpp"
+#include "Solver/HLLCMixed.hpp"
+#include "Solver/HybridSolver.hpp"
+
+namespace {
+
+  using Hybrid = Solvers::HybridSolver<Precision::Double>;
+
+  constexpr unsigned int Size  = 1000;
+  constexpr unsigned int Steps = 300;
+
+  double mass(const std::vector<RealType>& h) {
+    double mass = 0.0;
+    for (unsigned int i = 1; i <= Size; i++) {
+      mass += double(h[i]);
+    }
+    return mass;
+  }
+
+  // Chunk-sized rows of cells: smooth, shocked, transcritical and dry edges mixed
+  std::vector<double> fuzzedCells(std::mt19937& gen, double* hu, double* b, unsigned int count) {
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<double>                    h(count);
+    for (unsigned int i = 0; i < count; i++) {
+      const double kind = unit(gen);
+      h[i]              = kind < 0.1 ? 0.0 : (i > 0 && kind < 0.6 ? h[i - 1] * (1.0 + 1e-3 * unit(gen)) : 1.0 + 9.0 * unit(gen));
+      hu[i]             = h[i] * (2.0 * unit(gen) - 1.0) * 1.5 * std::sqrt(9.81 * h[i]);
+      b[i]              = unit(gen) < 0.1 ? -1.0 : 0.0;
+    }
+    return h;
+  }
+
+} // namespace
+
+TEST_CASE("Hybrid sensor", "[HybridSolver]") {
+  const Hybrid hybrid;
+
+  // Smooth, subcritical, wet and flat
+  REQUIRE_FALSE(hybrid.isRough(2.0, 2.001, 1.0, 1.0, 0.0, 0.0));
+  // Surface jump of 50%
+  REQUIRE(hybrid.isRough(2.0, 1.0, 0.0, 0.0, 0.0, 0.0));
+  // Dry neighbour and bathymetry step stay on the well-balanced Rusanov flux
+  REQUIRE_FALSE(hybrid.isRough(2.0, 0.0, 0.0, 0.0, 0.0, 0.0));
+  REQUIRE_FALSE(hybrid.isRough(2.0, 1.0, 0.0, 0.0, 0.0, 1.0));
+
+  // Fr = 1 on the left
+  const double h = 2.0, u = std::sqrt(9.81 * h);
+  REQUIRE(hybrid.isRough(h, h, h * u, h * u, 0.0, 0.0));
+  // Fr = 0.7 left and 1.5 right: transcritical between the sides
+  REQUIRE(hybrid.isRough(h, h, 0.7 * h * u, 1.5 * h * u, 0.0, 0.0));
+  // Supercritical on both sides
+  REQUIRE_FALSE(hybrid.isRough(h, h, 2.0 * h * u, 2.0 * h * u, 0.0, 0.0));
+
+  // A negative jump tolerance sends every wet, flat edge to Osher
+  REQUIRE(Hybrid(-1.0).isRough(2.0, 2.0, 0.0, 0.0, 0.0, 0.0));
+}
+
+TEST_CASE("Hybrid rough edges compute in the work precision", "[HybridSolver]") {
+  // Single precision: a RealType round trip would change the last bits
+  Solvers::HybridSolver<Precision::Float> hybrid;
+  Solvers::OsherMixed<Precision::Float>   osher;
+
+  const float h = 2.0f, u = std::sqrt(9.81f * h);
+  const float states[][4] = {{2.0f, 1.0f, 0.0f, 0.0f}, {3.7f, 0.3f, 1.1f, -0.2f}, {h, h, 0.7f * h * u, 1.5f * h * u}};
+  for (const auto& s : states) {
+    REQUIRE(hybrid.isRough(s[0], s[1], s[2], s[3], 0.0f, 0.0f));
+    float hybridOut[5], osherOut[5];
+    hybrid.computeNetUpdates(s[0], s[1], s[2], s[3], 0.0f, 0.0f, hybridOut[0], hybridOut[1], hybridOut[2], hybridOut[3], hybridOut[4]);
+    osher.computeNetUpdates(s[0], s[1], s[2], s[3], 0.0f, 0.0f, osherOut[0], osherOut[1], osherOut[2], osherOut[3], osherOut[4]);
+    for (int i = 0; i < 5; i++) {
+      REQUIRE(hybridOut[i] == osherOut[i]);
+    }
+  }
+}
+
+TEST_CASE("Hybrid over a bed step", "[HybridSolver]") {
+  const Solvers::HybridSolver<Precision::Double, Solvers::HLLCMixed<Precision::Double>> hybrid;
+  REQUIRE(hybrid.expensiveBathymetry);
+  REQUIRE_FALSE(Hybrid::expensiveBathymetry);
+
+  // Lake at rest: the depth jumps, the surface does not
+  REQUIRE_FALSE(hybrid.isRough(2.0, 1.0, 0.0, 0.0, 0.0, 1.0));
+  // Surface jump of 50% over the step
+  REQUIRE(hybrid.isRough(3.0, 1.0, 0.0, 0.0, 0.0, 1.0));
+  REQUIRE_FALSE(Hybrid().isRough(3.0, 1.0, 0.0, 0.0, 0.0, 1.0));
+}
+
+TEST_CASE("Hybrid batch matches the edge by edge results", "[HybridSolver]") {
+  constexpr unsigned int Count = Hybrid::MaxBatch;
+  std::mt19937           gen(42);
+
+  for (unsigned int run = 0; run < 100; run++) {
+    double                    hu[Count + 1], b[Count + 1];
+    const std::vector<double> h = fuzzedCells(gen, hu, b, Count + 1);
+
+    Hybrid batch, single;
+    double hL[Count], hR[Count], huL[Count], huR[Count], maxSpeed = 0.0;
+    batch.computeNetUpdates(Count, h.data(), hu, b, hL, hR, huL, huR, maxSpeed);
+
+    double maxSingle = 0.0;
+    for (unsigned int k = 0; k < Count; k++) {
+      double hLk, hRk, huLk, huRk, speed;
+      single.computeNetUpdates(h[k], h[k + 1], hu[k], hu[k + 1], b[k], b[k + 1], hLk, hRk, huLk, huRk, speed);
+      REQUIRE(hL[k] == hLk);
+      REQUIRE(hR[k] == hRk);
+      REQUIRE(huL[k] == huLk);
+      REQUIRE(huR[k] == huRk);
+      maxSingle = std::max(maxSingle, speed);
+    }
+    REQUIRE(maxSpeed == maxSingle);
+    REQUIRE(batch.getCheapEdges() == single.getCheapEdges());
+    REQUIRE(batch.getExpensiveEdges() == single.getExpensiveEdges());
+    REQUIRE(batch.getCheapEdges() + batch.getExpensiveEdges() == Count);
+  }
+}
+
+TEST_CASE("Hybrid dam break", "[HybridSolver]") {
+  Scenarios::DamBreakScenario scenario(1000, Size, 14, 3.5, 0);
+
+  const auto rusanov = Simulation::run<Precision::Double>(scenario, Size, Steps);
+  const auto hybrid  = Simulation::run<Precision::Double, Hybrid>(scenario, Size, Steps);
+
+  const unsigned long long edges = hybrid.cheapEdges + hybrid.expensiveEdges;
+  REQUIRE(edges == (unsigned long long)(Size + 1) * Steps);
+  // Only the shock, the rarefaction and the transcritical point are rough
+  REQUIRE(hybrid.expensiveEdges > 0);
+  REQUIRE(hybrid.expensiveEdges < edges / 5);
+
+  std::vector<RealType> h0(Size + 2);
+  for (unsigned int i = 0; i < Size + 2; i++) {
+    h0[i] = scenario.getHeight(i);
+  }
+  REQUIRE_THAT(mass(hybrid.h), Catch::Matchers::WithinRel(mass(h0), 1e-2));
+
+  // Both resolve the same waves, Osher only sharper at the fronts
+  for (unsigned int i = 1; i <= Size; i++) {
+    REQUIRE(std::isfinite(double(hybrid.h[i])));
+    REQUIRE_THAT(double(hybrid.h[i]), Catch::Matchers::WithinAbs(double(rusanov.h[i]), 1.0));
+  }
+}
+
+TEST_CASE("Rusanov, Osher and hybrid timings", "[.report][HybridSolver]") {
+  constexpr unsigned int Cells = 100000;
+  constexpr unsigned int Runs  = 20;
+
+  // Snapshot of a developed dam break, flux computation only
+  Scenarios::DamBreakScenario scenario(1000, Cells, 14, 3.5, 0);
+  const auto                  snapshot = Simulation::run<Precision::Double>(scenario, Cells, 2000);
+  std::vector<double>         h(snapshot.h.begin(), snapshot.h.end()), hu(snapshot.hu.begin(), snapshot.hu.end()),
+    b(snapshot.b.begin(), snapshot.b.end());
+  std::vector<double> hL(Cells + 1), hR(Cells + 1), huL(Cells + 1), huR(Cells + 1);
+
+  // Negative jump tolerance: Osher on every edge; plain: RusanovMixed without the sensor
+  const auto time = [&](Hybrid& solver, double jumpTolerance, bool plain) {
+    solver.setJumpTolerance(jumpTolerance);
+    solver.resetCounters();
+    Solvers::RusanovMixed<Precision::Double> rusanov;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned int run = 0; run < Runs; run++) {
+      for (unsigned int first = 0; first < Cells + 1; first += Hybrid::MaxBatch) {
+        const unsigned int count = std::min(Hybrid::MaxBatch, Cells + 1 - first);
+        double             speed = 0.0;
+        if (plain) {
+          for (unsigned int k = first; k < first + count; k++) {
+            rusanov.computeNetUpdates(h[k], h[k + 1], hu[k], hu[k + 1], b[k], b[k + 1], hL[k], hR[k], huL[k], huR[k], speed);
+          }
+        } else {
+          solver.computeNetUpdates(count, &h[first], &hu[first], &b[first], &hL[first], &hR[first], &huL[first], &huR[first], speed);
+        }
+      }
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (double(Runs) * (Cells + 1));
+  };
+
+  Hybrid       solver;
+  const double rusanov  = time(solver, 1e-2, true);
+  const double osher    = time(solver, -1.0, false);
+  const double hybrid   = time(solver, 1e-2, false);
+  const double fraction = double(solver.getExpensiveEdges()) / double(solver.getCheapEdges() + solver.getExpensiveEdges());
+
+  std::printf("%-10s %9s %9s %9s\n", "solver", "ns/edge", "osher", "speedup");
+  std::printf("%-10s %9.2f %9.4f %9.2f\n", "rusanov", rusanov, 0.0, osher / rusanov);
+  std::printf("%-10s %9.2f %9.4f %9.2f\n", "osher", osher, 1.0, 1.0);
+  std::printf("%-10s %9.2f %9.4f %9.2f\n", "hybrid", hybrid, fraction, osher / hybrid);
+}
@@ -0,0 +1,138 @@
+/**
+ * @file TestLinearRegion.cpp
+ * contains tests for the linear deep-water region of WavePropagationBlockMixed
+ *
+ * @test The sea at rest stays at rest in the linear region
+ * @test The coupled run conserves mass and follows the nonlinear run across the ocean
+ * @test Only chunks close to the sea at rest are linear
+ *
+ * The hidden test case "[.report]" prints cost and error of the coupled run against the nonlinear run:
+ *   ./TestLinearRegion "[.report]"
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+
+#include "Scenarios/DamBreakScenario.hpp"
+#include "Scenarios/OceanShelfScenario.hpp"
+#include "Simulation/Simulation.hpp"
+#include "Simulation/SolverRegistry.hpp"
+#include "Solver/AugumentedMixed.hpp"
+
+namespace {
+
+  constexpr unsigned int Size = 2000;
+  // About 900 s: the hump crosses the ocean, nothing leaves the domain
+  constexpr unsigned int Steps = 1000;
+
+  double mass(const Simulation::Result& result) {
+    double mass = 0.0;
+    for (unsigned int i = 1; i < result.h.size() - 1; i++) {
+      mass += double(result.h[i]);
+    }
+    return mass;
+  }
+
+  double maxDifference(const Simulation::Result& a, const Simulation::Result& b) {
+    double difference = 0.0;
+    for (unsigned int i = 1; i < a.h.size() - 1; i++) {
+      difference = std::max(difference, std::abs(double(a.h[i]) - double(b.h[i])));
+    }
+    return difference;
+  }
+
+  Simulation::RunOptions linearBelow(double threshold) {
+    Simulation::RunOptions options;
+    options.linearThreshold = threshold;
+    return options;
+  }
+
+} // namespace
+
+TEST_CASE("The sea at rest stays at rest in the linear region", "[LinearRegion]") {
+  const Scenarios::OceanShelfScenario               rest(Size, 0.0);
+  const Solvers::AugumentedMixed<Precision::Double> solver;
+  const auto result = Simulation::run<Precision::Double>(rest, Size, 100, nullptr, solver, linearBelow(1e-3));
+
+  REQUIRE(result.linearChunks > 0);
+  for (unsigned int i = 1; i <= Size; i++) {
+    // Round-off of the mixed chunks on the slope
+    REQUIRE_THAT(double(result.h[i]), Catch::Matchers::WithinAbs(double(rest.getHeight(i)), 1e-9));
+    REQUIRE_THAT(double(result.hu[i]), Catch::Matchers::WithinAbs(0.0, 1e-9));
+  }
+}
+
+TEST_CASE("The coupled run follows the nonlinear run", "[LinearRegion]") {
+  const Scenarios::OceanShelfScenario scenario(Size);
+
+  // The well-balanced solvers: RusanovMixed's centred bed term leaves a flow at the kinks of the slope
+  for (const std::string& name : {std::string("augmented"), std::string("roe"), std::string("hllc")}) {
+    INFO(name);
+    Simulation::SolverSpec spec;
+    spec.name = name;
+    REQUIRE(Simulation::visitSolver<Precision::Double>(spec, [&](const auto& solver) {
+      using Solver         = std::remove_cvref_t<decltype(solver)>;
+      const auto nonlinear = Simulation::run<Precision::Double, Solver>(scenario, Size, Steps, nullptr, solver);
+      const auto coupled   = Simulation::run<Precision::Double, Solver>(scenario, Size, Steps, nullptr, solver, linearBelow(1e-4));
+
+      // The crest (Froude number 2.5e-4) is not linear, the rest of the ocean is
+      REQUIRE(coupled.linearChunks > coupled.wetChunks / 2);
+      REQUIRE(coupled.linearChunks < coupled.wetChunks);
+
+      // A small nonlinear wave leaves to the left in both runs
+      REQUIRE_THAT(mass(coupled), Catch::Matchers::WithinRel(mass(nonlinear), 1e-10));
+      REQUIRE(maxDifference(coupled, nonlinear) < 1e-3);
+    }));
+  }
+}
+
+TEST_CASE("Only chunks close to the sea at rest are linear", "[LinearRegion]") {
+  // The upper pool is at rest, the lower pool 10.5 m below it never linear
+  Scenarios::DamBreakScenario                    damBreak(1000, Size, 14, 3.5, 0);
+  const Solvers::RusanovMixed<Precision::Double> solver;
+  const auto dam = Simulation::run<Precision::Double>(damBreak, Size, 100, nullptr, solver, linearBelow(0.5));
+  REQUIRE(dam.linearChunks > 0);
+  REQUIRE(dam.linearChunks <= dam.wetChunks - 100 * (Size / 2 / Blocks::ChunkSize - 1));
+
+  // Froude number 0.025 at the crest of the large hump, 2.5e-4 at the crest of the small one
+  const Scenarios::OceanShelfScenario large(Size, 100.0);
+  const Scenarios::OceanShelfScenario small(Size, 1.0);
+  const auto largeRun = Simulation::run<Precision::Double>(large, Size, 1, nullptr, solver, linearBelow(1e-4));
+  const auto smallRun = Simulation::run<Precision::Double>(small, Size, 1, nullptr, solver, linearBelow(1e-4));
+  REQUIRE(largeRun.linearChunks > 0);
+  REQUIRE(largeRun.linearChunks < smallRun.linearChunks);
+  REQUIRE(smallRun.linearChunks < smallRun.wetChunks);
+}
+
+TEST_CASE("Cost and error of the linear region", "[.report][LinearRegion]") {
+  constexpr unsigned int              LargeSize = 1 << 15;
+  const Scenarios::OceanShelfScenario scenario(LargeSize);
+  const unsigned int                  steps = 8 * Steps;
+
+  std::printf("%-10s %9s %10s %10s %8s %12s\n", "solver", "threshold", "linear", "time[s]", "speedup", "maxError[m]");
+  for (const char* name : {"augmented", "roe", "hllc", "fwave"}) {
+    Simulation::SolverSpec spec;
+    spec.name = name;
+    Simulation::visitSolver<Precision::Double>(spec, [&](const auto& solver) {
+      using Solver         = std::remove_cvref_t<decltype(solver)>;
+      const auto nonlinear = Simulation::run<Precision::Double, Solver>(scenario, LargeSize, steps, nullptr, solver);
+      std::printf("%-10s %9s %10s %10.4f %8s %12s\n", name, "-", "-", nonlinear.seconds, "-", "-");
+      for (const double threshold : {1e-4, 1e-3, 1e-2}) {
+        const auto coupled = Simulation::run<Precision::Double, Solver>(scenario, LargeSize, steps, nullptr, solver, linearBelow(threshold));
+        std::printf(
+          "%-10s %9.0e %9.1f%% %10.4f %8.2f %12.3e\n",
+          name,
+          threshold,
+          100.0 * double(coupled.linearChunks) / double(coupled.wetChunks),
+          coupled.seconds,
+          nonlinear.seconds / coupled.seconds,
+          maxDifference(coupled, nonlinear)
+        );
+      }
+    });
+  }
+}
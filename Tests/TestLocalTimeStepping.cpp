@@ -0,0 +1,129 @@
+/**
+ * @file TestLocalTimeStepping.cpp
+ * contains tests for pseudo-time stepping with local time steps (RunOptions::localTimeStepping)
+ *
+ * @test Still water stays at rest and dry cells stay dry
+ * @test The sub- and supercritical flows converge to the steady state of global time stepping
+ * @test The convergence history is labeled as pseudo-time
+ *
+ * The hidden test case "[.report]" prints the iterations to the steady state with global and local time steps:
+ *   ./TestLocalTimeStepping "[.report]"
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Results.hpp"
+#include "Blocks/WavePropagationBlockMixed.hpp"
+#include "Scenarios/SubcriticalFlowScenario.hpp"
+#include "Scenarios/SupercriticalFlowScenario.hpp"
+#include "Simulation/Simulation.hpp"
+#include "Solver/AugumentedMixed.hpp"
+
+namespace {
+
+  constexpr unsigned int Size     = 500;
+  constexpr unsigned int MaxSteps = 100000;
+
+  Simulation::RunOptions steadyBelow(double tolerance, bool localTimeStepping) {
+    Simulation::RunOptions options;
+    options.steadyTolerance   = tolerance;
+    options.localTimeStepping = localTimeStepping;
+    return options;
+  }
+
+} // namespace
+
+TEST_CASE("Local time steps keep still water at rest and dry cells dry", "[LocalTimeStepping]") {
+  // A lake on a bump with a dry island on top: the well-balanced augmented solver, dry cells have no local time step
+  std::vector<RealType> h(Size + 2), hu(Size + 2, 0.0), b(Size + 2);
+  for (unsigned int i = 0; i < Size + 2; i++) {
+    b[i] = -2.0 + 2.5 * std::exp(-0.001 * (double(i) - 250.0) * (double(i) - 250.0));
+    h[i] = std::max(RealType(0.0), -b[i]);
+  }
+
+  Blocks::WavePropagationBlockMixed<Precision::Double, Solvers::AugumentedMixed<Precision::Double>> block(
+    h.data(), hu.data(), b.data(), Size, 1.0
+  );
+  block.setLocalTimeStepping(true);
+  REQUIRE(block.isLocalTimeStepping());
+  for (unsigned int step = 0; step < 100; step++) {
+    block.applyBoundaryConditions();
+    block.updateUnknowns(block.computeNumericalFluxes());
+  }
+
+  std::vector<double> hAfter(Size + 2), huAfter(Size + 2), bAfter(Size + 2);
+  block.getState(hAfter.data(), huAfter.data(), bAfter.data());
+  for (unsigned int i = 1; i <= Size; i++) {
+    REQUIRE(std::abs(hAfter[i] - h[i]) < 1e-12);
+    REQUIRE(std::abs(huAfter[i]) < 1e-12);
+    if (h[i] == 0.0) {
+      REQUIRE(hAfter[i] == 0.0);
+    }
+  }
+}
+
+TEST_CASE("Local time steps converge to the steady state of global time steps", "[LocalTimeStepping]") {
+  const Solvers::RusanovMixed<Precision::Double> solver;
+  const Scenarios::SubcriticalFlowScenario       subcritical(Size);
+  const Scenarios::SupercriticalFlowScenario     supercritical(Size);
+
+  const Scenarios::Scenario* const flows[] = {&subcritical, &supercritical};
+  for (const Scenarios::Scenario* scenario : flows) {
+    const auto global = Simulation::run<Precision::Double>(*scenario, Size, MaxSteps, nullptr, solver, steadyBelow(1e-6, false));
+    const auto local  = Simulation::run<Precision::Double>(*scenario, Size, MaxSteps, nullptr, solver, steadyBelow(1e-6, true));
+
+    REQUIRE(local.steadyStep > 0);
+    REQUIRE(std::max(local.residual.linfH, local.residual.linfHu) < 1e-6);
+    // Never slower in iterations; the supercritical flow, fast upstream and slow over the bump, needs clearly fewer
+    REQUIRE(local.steps <= global.steps);
+    if (scenario == &supercritical) {
+      REQUIRE(local.steps < 0.9 * global.steps);
+    }
+    REQUIRE(Tests::maxDifference(local, global) < 1e-3);
+  }
+}
+
+TEST_CASE("The convergence history is labeled as pseudo-time", "[LocalTimeStepping]") {
+  const Solvers::RusanovMixed<Precision::Double> solver;
+  const Scenarios::SupercriticalFlowScenario     supercritical(Size);
+  std::ostringstream                             history;
+  Simulation::RunOptions                         options = steadyBelow(1e-6, true);
+  options.residualHistory                                = &history;
+  Simulation::run<Precision::Double>(supercritical, Size, 10, nullptr, solver, options);
+
+  std::istringstream lines(history.str());
+  std::string        line;
+  REQUIRE(std::getline(lines, line));
+  REQUIRE(line == "# step pseudo_time l1_h linf_h l1_hu linf_hu");
+}
+
+TEST_CASE("Iterations to the steady state with local time steps", "[.report][LocalTimeStepping]") {
+  const Solvers::RusanovMixed<Precision::Double> solver;
+  std::printf("%-14s %8s %10s %10s %10s %10s %8s %8s\n", "scenario", "cells", "global", "local", "global[s]", "local[s]", "ratio", "speedup");
+  for (const unsigned int size : {500u, 2000u, 8000u}) {
+    const Scenarios::SubcriticalFlowScenario   subcritical(size);
+    const Scenarios::SupercriticalFlowScenario supercritical(size);
+    const Scenarios::Scenario* const           flows[] = {&subcritical, &supercritical};
+    for (const Scenarios::Scenario* scenario : flows) {
+      const char* name   = scenario == &subcritical ? "subcritical" : "supercritical";
+      const auto  global = Simulation::run<Precision::Double>(*scenario, size, 1000000, nullptr, solver, steadyBelow(1e-6, false));
+      const auto  local  = Simulation::run<Precision::Double>(*scenario, size, 1000000, nullptr, solver, steadyBelow(1e-6, true));
+      std::printf(
+        "%-14s %8u %10u %10u %10.4f %10.4f %8.3f %8.2f\n",
+        name,
+        size,
+        global.steps,
+        local.steps,
+        global.seconds,
+        local.seconds,
+        double(local.steps) / double(global.steps),
+        global.seconds / local.seconds
+      );
+    }
+  }
+}
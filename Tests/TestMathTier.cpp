@@ -0,0 +1,218 @@
+/**
+ * @file TestMathTier.cpp
+ * contains tests for the policy-selected math tiers in RealMath.hpp
+ *
+ * @test Accuracy of rsqrt/sqrt/rcp per tier and of the net updates of every solver per tier
+ *
+ * The hidden test case "[.report]" prints an accuracy-vs-speed table per solver and tier:
+ *   ./TestMathTier "[.report]"
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "EdgeStates.hpp"
+#include "Solver/AugumentedMixed.hpp"
+#include "Solver/FWaveMixed.hpp"
+#include "Solver/HLLCMixed.hpp"
+#include "Solver/OsherMixed.hpp"
+#include "Solver/RoeMixed.hpp"
+#include "Solver/RusanovMixed.hpp"
+#include "Tools/PrecisionPolicy.hpp"
+
+namespace {
+
+  template <class Base, MathTier Tier>
+  struct WithTier: Base {
+    static constexpr MathTier math = Tier;
+  };
+
+  // Double work precision with exact math serves as reference
+  using Reference = WithTier<Precision::MixedASafe, MathTier::Exact>;
+
+  using Tests::EdgeState;
+
+  // Wet for every policy, the surface at zero keeps the bed terms in the range of every work type
+  const Tests::EdgeRange WetStates = {.seed = 1234, .maxLogDepth = 4.0, .froude = 0.9, .depthJump = 2.0, .bed = 0.0, .levelSurface = true};
+
+  template <class Solver>
+  void solve(Solver& solver, const EdgeState& s, double out[5]) {
+    using Work = typename Solver::Work;
+    Work hL = Work(s.hL), hR = Work(s.hR), huL = Work(s.huL), huR = Work(s.huR), bL = Work(s.bL), bR = Work(s.bR);
+    Work r[5];
+    solver.computeNetUpdates(hL, hR, huL, huR, bL, bR, r[0], r[1], r[2], r[3], r[4]);
+    for (int k = 0; k < 5; k++) {
+      out[k] = double(r[k]);
+    }
+  }
+
+  /**
+   * @return Maximum deviation of the net updates from the exact double
+   * reference, relative to the largest net update of the edge
+   */
+  template <template <class> class Solver, class Policy>
+  double maxRelativeError(const std::vector<EdgeState>& states) {
+    Solver<Reference> reference;
+    Solver<Policy>    solver;
+    double            maxError = 0.0;
+    for (const auto& s : states) {
+      double ref[5], val[5];
+      solve(reference, s, ref);
+      solve(solver, s, val);
+      double scale = 0.0;
+      for (int k = 0; k < 5; k++) {
+        scale = std::max(scale, std::fabs(ref[k]));
+      }
+      for (int k = 0; k < 5; k++) {
+        maxError = std::max(maxError, std::fabs(val[k] - ref[k]) / scale);
+      }
+    }
+    return maxError;
+  }
+
+  template <template <class> class Solver, class Policy>
+  double nanosecondsPerEdge(const std::vector<EdgeState>& states) {
+    Solver<Policy> solver;
+    return Tests::nsPerEdge<typename Policy::Work>(solver, states, 50);
+  }
+
+  template <template <class> class Solver, class Base>
+  void reportRow(const char* solverName, const std::vector<EdgeState>& states) {
+    const double exact    = nanosecondsPerEdge<Solver, WithTier<Base, MathTier::Exact>>(states);
+    const double newton   = nanosecondsPerEdge<Solver, WithTier<Base, MathTier::Newton>>(states);
+    const double estimate = nanosecondsPerEdge<Solver, WithTier<Base, MathTier::Estimate>>(states);
+    std::printf(
+      "%-10s %-22s | %9.2e %7.2f | %9.2e %7.2f | %9.2e %7.2f\n",
+      solverName,
+      Base::name,
+      maxRelativeError<Solver, WithTier<Base, MathTier::Exact>>(states),
+      exact,
+      maxRelativeError<Solver, WithTier<Base, MathTier::Newton>>(states),
+      newton,
+      maxRelativeError<Solver, WithTier<Base, MathTier::Estimate>>(states),
+      estimate
+    );
+  }
+
+  /**
+   * @return Largest ratio of a flux term (hu^2/h + g h^2/2) to the largest
+   * net update of the reference solver: the factor by which the flux
+   * differences amplify rounding errors
+   */
+  template <template <class> class Solver>
+  double cancellation(const std::vector<EdgeState>& states) {
+    Solver<Reference> reference;
+    double            maxRatio = 0.0;
+    for (const auto& s : states) {
+      double ref[5];
+      solve(reference, s, ref);
+      double scale = 0.0;
+      for (int k = 0; k < 5; k++) {
+        scale = std::max(scale, std::fabs(ref[k]));
+      }
+      const double fluxL = s.huL * s.huL / s.hL + 0.5 * Reference::G * s.hL * s.hL;
+      const double fluxR = s.huR * s.huR / s.hR + 0.5 * Reference::G * s.hR * s.hR;
+      maxRatio           = std::max(maxRatio, std::max(fluxL, fluxR) / scale);
+    }
+    return maxRatio;
+  }
+
+  /**
+   * The Exact and Newton tiers stay within 16 float roundoffs (MixedC has a
+   * float G) times the cancellation of the solver, the Estimate tier within
+   * estimateTolerance
+   */
+  template <template <class> class Solver>
+  void requireTierAccuracy(const char* name, const std::vector<EdgeState>& states, double estimateTolerance) {
+    INFO(name);
+    const double tolerance = 16.0 * std::ldexp(1.0, -24) * cancellation<Solver>(states);
+    CHECK(maxRelativeError<Solver, WithTier<Precision::MixedBAggressive, MathTier::Exact>>(states) < tolerance);
+    CHECK(maxRelativeError<Solver, WithTier<Precision::MixedC, MathTier::Newton>>(states) < tolerance);
+    CHECK(maxRelativeError<Solver, WithTier<Precision::MixedBAggressive, MathTier::Newton>>(states) < tolerance);
+    CHECK(maxRelativeError<Solver, WithTier<Precision::MixedBAggressive, MathTier::Estimate>>(states) < estimateTolerance);
+  }
+
+  template <MathTier Tier, class T>
+  void checkTier(double tolerance) {
+    for (double e = -6.0; e <= 6.0; e += 0.01) {
+      const T      x = T(std::pow(10.0, e));
+      const double r = 1.0 / std::sqrt(double(x));
+      REQUIRE_THAT(double(rsqrt_tier<Tier>(x)), Catch::Matchers::WithinRel(r, tolerance));
+      REQUIRE_THAT(double(sqrt_tier<Tier>(x)), Catch::Matchers::WithinRel(std::sqrt(double(x)), tolerance));
+      REQUIRE_THAT(double(rcp_tier<Tier>(x)), Catch::Matchers::WithinRel(1.0 / double(x), tolerance));
+      REQUIRE_THAT(double(div_tier<Tier>(T(3), x)), Catch::Matchers::WithinRel(3.0 / double(x), tolerance));
+    }
+    REQUIRE(sqrt_tier<Tier>(T(0)) == T(0));
+  }
+
+} // namespace
+
+TEST_CASE("Accuracy of the math tiers", "[MathTier]") {
+  SECTION("Exact") {
+    checkTier<MathTier::Exact, float>(1e-7);
+    checkTier<MathTier::Exact, double>(1e-15);
+  }
+  SECTION("Newton") {
+    checkTier<MathTier::Newton, float>(1e-6);
+    checkTier<MathTier::Newton, double>(1e-6);
+  }
+  SECTION("Estimate") {
+    // Must stay below half an ulp of bf16 (2^-9)
+    checkTier<MathTier::Estimate, float>(std::ldexp(1.0, -11));
+    checkTier<MathTier::Estimate, double>(std::ldexp(1.0, -11));
+  }
+}
+
+TEST_CASE("Rusanov net updates per math tier", "[MathTier]") {
+  const auto states = Tests::fuzzedStates(10000, WetStates);
+
+  SECTION("Exact tier stays near work precision") {
+    REQUIRE(maxRelativeError<Solvers::RusanovMixed, WithTier<Precision::MixedBAggressive, MathTier::Exact>>(states) < 1e-4);
+  }
+  SECTION("Newton tier stays near work precision") {
+    REQUIRE(maxRelativeError<Solvers::RusanovMixed, WithTier<Precision::MixedC, MathTier::Newton>>(states) < 1e-4);
+    REQUIRE(maxRelativeError<Solvers::RusanovMixed, WithTier<Precision::MixedBAggressive, MathTier::Newton>>(states) < 1e-4);
+  }
+  SECTION("Estimate tier stays within a few percent") {
+    // Cancellation in the flux differences amplifies the 12-bit estimate error
+    REQUIRE(maxRelativeError<Solvers::RusanovMixed, WithTier<Precision::MixedBAggressive, MathTier::Estimate>>(states) < 5e-2);
+  }
+}
+
+TEST_CASE("Net updates of every solver per math tier", "[MathTier]") {
+  const auto states = Tests::fuzzedStates(10000, WetStates);
+
+  requireTierAccuracy<Solvers::HLLCMixed>("hllc", states, 5e-2);
+  requireTierAccuracy<Solvers::RoeMixed>("roe", states, 5e-2);
+  requireTierAccuracy<Solvers::OsherMixed>("osher", states, 5e-2);
+  requireTierAccuracy<Solvers::FWaveMixed>("fwave", states, 5e-2);
+  requireTierAccuracy<Solvers::AugumentedMixed>("augmented", states, 5e-2);
+}
+
+TEST_CASE("Accuracy-vs-speed report per solver and math tier", "[.report][MathTier]") {
+  const auto states = Tests::fuzzedStates(100000, WetStates);
+
+  std::printf("%-10s %-22s | %-17s | %-17s | %-17s\n", "solver", "policy", "Exact", "Newton", "Estimate");
+  std::printf("%-10s %-22s | %9s %7s | %9s %7s | %9s %7s\n", "", "", "max.err", "ns/edge", "max.err", "ns/edge", "max.err", "ns/edge");
+  reportRow<Solvers::RusanovMixed, Precision::MixedASafe>("Rusanov", states);
+  reportRow<Solvers::RusanovMixed, Precision::MixedBAggressive>("Rusanov", states);
+  reportRow<Solvers::RusanovMixed, Precision::MixedC>("Rusanov", states);
+  reportRow<Solvers::HLLCMixed, Precision::MixedASafe>("HLLC", states);
+  reportRow<Solvers::HLLCMixed, Precision::MixedBAggressive>("HLLC", states);
+  reportRow<Solvers::HLLCMixed, Precision::MixedC>("HLLC", states);
+  reportRow<Solvers::RoeMixed, Precision::MixedASafe>("Roe", states);
+  reportRow<Solvers::RoeMixed, Precision::MixedBAggressive>("Roe", states);
+  reportRow<Solvers::RoeMixed, Precision::MixedC>("Roe", states);
+  reportRow<Solvers::OsherMixed, Precision::MixedASafe>("Osher", states);
+  reportRow<Solvers::OsherMixed, Precision::MixedBAggressive>("Osher", states);
+  reportRow<Solvers::OsherMixed, Precision::MixedC>("Osher", states);
+  reportRow<Solvers::FWaveMixed, Precision::MixedASafe>("f-wave", states);
+  reportRow<Solvers::FWaveMixed, Precision::MixedBAggressive>("f-wave", states);
+  reportRow<Solvers::FWaveMixed, Precision::MixedC>("f-wave", states);
+  reportRow<Solvers::AugumentedMixed, Precision::MixedASafe>("Augmented", states);
+  reportRow<Solvers::AugumentedMixed, Precision::MixedBAggressive>("Augmented", states);
+  reportRow<Solvers::AugumentedMixed, Precision::MixedC>("Augmented", states);
+}
@@ -0,0 +1,169 @@
+/**
+ * @file TestOsherSolver.cpp
+ * contains tests for the fast paths of Solvers::OsherSolver
+ *
+ * @test classifyPath agrees with the eigenvalue signs sampled densely along the path
+ * @test Subcritical fast path matches the quadrature to rounding
+ * @test Supercritical closed form matches the quadrature to its integration error
+ *
+ * The hidden test case "[.report]" prints the per-edge cost on the built-in scenarios:
+ *   ./TestOsherSolver "[.report]"
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "EdgeStates.hpp"
+#include "Scenarios/DamBreakScenario.hpp"
+#include "Scenarios/ShockRareProblemScenario.hpp"
+#include "Scenarios/SubcriticalFlowScenario.hpp"
+#include "Scenarios/SupercriticalFlowScenario.hpp"
+#include "Simulation/Simulation.hpp"
+#include "Solver/Osher.hpp"
+
+namespace {
+
+  using Path = Solvers::OsherSolver::Path;
+
+  using Tests::EdgeState;
+
+  // Wet states with Froude numbers in [-froude, froude] and depth ratios up to jump
+  Tests::EdgeRange fuzzedRange(double froude, double jump) {
+    return {.seed = 99, .minLogDepth = -1.0, .froude = froude, .depthJump = jump};
+  }
+
+  void solve(Solvers::OsherSolver& solver, const EdgeState& s, bool quadrature, double out[5]) {
+    RealType r[5];
+    if (quadrature) {
+      solver.computeNetUpdatesQuadrature(s.hL, s.hR, s.huL, s.huR, 0, 0, r[0], r[1], r[2], r[3], r[4]);
+    } else {
+      solver.computeNetUpdates(s.hL, s.hR, s.huL, s.huR, 0, 0, r[0], r[1], r[2], r[3], r[4]);
+    }
+    for (int k = 0; k < 5; k++) {
+      out[k] = double(r[k]);
+    }
+  }
+
+  void reportRow(const char* name, const Scenarios::Scenario& scenario, unsigned int size, unsigned int steps) {
+    const auto snapshot = Simulation::run<Precision::Double>(scenario, size, steps);
+
+    Solvers::OsherSolver solver;
+    unsigned int         paths[4] = {};
+    for (unsigned int k = 0; k <= size; k++) {
+      paths[int(solver.classifyPath(snapshot.h[k], snapshot.h[k + 1], snapshot.hu[k], snapshot.hu[k + 1]))]++;
+    }
+
+    constexpr unsigned int Runs = 50;
+    RealType               out[5];
+    double                 cost[2];
+    for (int quadrature = 0; quadrature < 2; quadrature++) {
+      const auto start = std::chrono::steady_clock::now();
+      for (unsigned int run = 0; run < Runs; run++) {
+        for (unsigned int k = 0; k <= size; k++) {
+          const RealType hL = snapshot.h[k], hR = snapshot.h[k + 1], huL = snapshot.hu[k], huR = snapshot.hu[k + 1];
+          if (quadrature) {
+            solver.computeNetUpdatesQuadrature(hL, hR, huL, huR, 0, 0, out[0], out[1], out[2], out[3], out[4]);
+          } else {
+            solver.computeNetUpdates(hL, hR, huL, huR, 0, 0, out[0], out[1], out[2], out[3], out[4]);
+          }
+        }
+      }
+      cost[quadrature] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (double(Runs) * (size + 1));
+    }
+
+    const double edges = size + 1;
+    std::printf(
+      "%-14s %8.3f %8.3f %8.3f %8.3f | %9.2f %9.2f %7.2f\n",
+      name,
+      paths[int(Path::RightSupercritical)] / edges,
+      paths[int(Path::LeftSupercritical)] / edges,
+      paths[int(Path::Subcritical)] / edges,
+      paths[int(Path::Sonic)] / edges,
+      cost[1],
+      cost[0],
+      cost[1] / cost[0]
+    );
+  }
+
+} // namespace
+
+TEST_CASE("Osher path classification", "[OsherSolver]") {
+  Solvers::OsherSolver solver;
+  unsigned int         classes[4] = {};
+
+  for (const auto& s : Tests::fuzzedStates(20000, fuzzedRange(3.0, 4.0))) {
+    const Path path = solver.classifyPath(s.hL, s.hR, s.huL, s.huR);
+    classes[int(path)]++;
+    if (path == Path::Sonic) {
+      continue;
+    }
+
+    for (int i = 0; i <= 1000; i++) {
+      const double t = i / 1000.0, h = s.hL + t * (s.hR - s.hL), u = (s.huL + t * (s.huR - s.huL)) / h, c = std::sqrt(9.81 * h);
+      if (path == Path::RightSupercritical) {
+        REQUIRE(u - c > 0);
+      } else if (path == Path::LeftSupercritical) {
+        REQUIRE(u + c < 0);
+      } else {
+        REQUIRE(u - c < 0);
+        REQUIRE(u + c > 0);
+      }
+    }
+  }
+
+  for (unsigned int count : classes) {
+    REQUIRE(count > 0);
+  }
+}
+
+TEST_CASE("Osher fast paths match the quadrature", "[OsherSolver]") {
+  Solvers::OsherSolver solver;
+
+  SECTION("subcritical") {
+    for (const auto& s : Tests::fuzzedStates(20000, fuzzedRange(0.9, 4.0))) {
+      if (solver.classifyPath(s.hL, s.hR, s.huL, s.huR) != Path::Subcritical) {
+        continue;
+      }
+      double fast[5], reference[5];
+      solve(solver, s, false, fast);
+      solve(solver, s, true, reference);
+      const double scale = std::fabs(reference[1]) + std::fabs(reference[0]) + 1.0;
+      for (int k = 0; k < 5; k++) {
+        REQUIRE_THAT(fast[k], Catch::Matchers::WithinAbs(reference[k], 1e-10 * scale));
+      }
+    }
+  }
+
+  SECTION("supercritical") {
+    // Small jumps: the quadrature of the smooth integrand is accurate to ~(jump)^6
+    for (const auto& s : Tests::fuzzedStates(20000, fuzzedRange(3.0, 1.05))) {
+      const Path path = solver.classifyPath(s.hL, s.hR, s.huL, s.huR);
+      if (path != Path::RightSupercritical && path != Path::LeftSupercritical) {
+        continue;
+      }
+      double fast[5], reference[5];
+      solve(solver, s, false, fast);
+      solve(solver, s, true, reference);
+      const double scale = std::fabs(reference[1]) + std::fabs(reference[0]) + 1.0;
+      for (int k = 0; k < 4; k++) {
+        REQUIRE_THAT(fast[k], Catch::Matchers::WithinAbs(reference[k], 1e-7 * scale));
+      }
+      // Cell-state speeds against Gauss-point speeds
+      REQUIRE_THAT(fast[4], Catch::Matchers::WithinRel(reference[4], 0.1));
+    }
+  }
+}
+
+TEST_CASE("Osher per-edge cost on the built-in scenarios", "[.report][OsherSolver]") {
+  constexpr unsigned int Size = 10000;
+
+  std::printf("%-14s %8s %8s %8s %8s | %9s %9s %7s\n", "scenario", "right", "left", "subcrit", "sonic", "quadr.", "fast", "speedup");
+  std::printf("%-14s %8s %8s %8s %8s | %9s %9s %7s\n", "", "", "", "", "", "ns/edge", "ns/edge", "");
+  reportRow("dam break", Scenarios::DamBreakScenario(1000, Size, 14, 3.5, 0), Size, 2000);
+  reportRow("shock/rare", Scenarios::ShockRareProblemScenario(1000, Size, Size / 2, 10, 50), Size, 2000);
+  reportRow("subcritical", Scenarios::SubcriticalFlowScenario(Size), Size, 2000);
+  reportRow("supercritical", Scenarios::SupercriticalFlowScenario(Size), Size, 2000);
+}
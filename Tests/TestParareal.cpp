@@ -0,0 +1,207 @@
+/**
+ * @file TestParareal.cpp
+ * contains tests for parareal (Simulation/Parareal.hpp)
+ *
+ * @test The restriction conserves mass and momentum and keeps a lake at rest
+ * @test Iterated to the end, parareal is serial time stepping slice by slice, with any number of threads
+ * @test The subcritical flow converges in fewer iterations than slices
+ * @test A fixed-point state that leaves its range is reported like in serial runs
+ *
+ * The hidden test case "[.report]" prints the speedup against serial time stepping:
+ *   ./TestParareal "[.report]"
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "Scenarios/DamBreakScenario.hpp"
+#include "Scenarios/SubcriticalFlowScenario.hpp"
+#include "Simulation/Parareal.hpp"
+
+namespace {
+
+  constexpr unsigned int Size = 400;
+
+  /** Initial values of the scenario as cells */
+  Simulation::CellState initialState(const Scenarios::Scenario& scenario, unsigned int size, std::vector<RealType>& b) {
+    Simulation::CellState state{std::vector<RealType>(size + 2), std::vector<RealType>(size + 2)};
+    b.resize(size + 2);
+    for (unsigned int i = 0; i < size + 2; i++) {
+      state.h[i]  = scenario.getHeight(i);
+      state.hu[i] = scenario.getMomentum(i);
+      b[i]        = scenario.getBathymetry(i);
+    }
+    return state;
+  }
+
+  double maxDifference(const std::vector<RealType>& h, const std::vector<RealType>& hu, const Simulation::CellState& state) {
+    double difference = 0.0;
+    for (unsigned int i = 1; i < h.size() - 1; i++) {
+      difference = std::max(difference, std::abs(double(h[i]) - double(state.h[i])));
+      difference = std::max(difference, std::abs(double(hu[i]) - double(state.hu[i])));
+    }
+    return difference;
+  }
+
+} // namespace
+
+TEST_CASE("The restriction conserves mass and momentum", "[Parareal]") {
+  std::vector<RealType> h(Size + 2), hu(Size + 2), b(Size + 2), coarseH(Size / 2 + 2), coarseHu(Size / 2 + 2), coarseB(Size / 2 + 2);
+  for (unsigned int i = 0; i < Size + 2; i++) {
+    b[i]  = -2.0 + 0.5 * std::sin(0.1 * i);
+    h[i]  = 0.1 * std::cos(0.07 * i) - b[i];
+    hu[i] = 1.0 + std::sin(0.03 * i);
+  }
+  Simulation::restrictCells(h.data(), hu.data(), b.data(), Size / 2, coarseH.data(), coarseHu.data(), coarseB.data());
+  for (unsigned int j = 1; j <= Size / 2; j++) {
+    REQUIRE_THAT(double(2.0 * coarseH[j]), Catch::Matchers::WithinRel(double(h[2 * j - 1] + h[2 * j]), 1e-14));
+    REQUIRE_THAT(double(2.0 * coarseHu[j]), Catch::Matchers::WithinRel(double(hu[2 * j - 1] + hu[2 * j]), 1e-14));
+  }
+  REQUIRE(coarseH[0] == coarseH[1]);
+  REQUIRE(coarseB[Size / 2 + 1] == coarseB[Size / 2]);
+
+  // A flat surface stays flat
+  for (unsigned int i = 0; i < Size + 2; i++) {
+    h[i] = 1.0 - b[i];
+  }
+  Simulation::restrictCells(h.data(), hu.data(), b.data(), Size / 2, coarseH.data(), coarseHu.data(), coarseB.data());
+  for (unsigned int j = 1; j <= Size / 2; j++) {
+    REQUIRE_THAT(double(coarseH[j] + coarseB[j]), Catch::Matchers::WithinAbs(1.0, 1e-14));
+  }
+
+  REQUIRE(Simulation::getPararealLevels(400, 3) == 3);
+  REQUIRE(Simulation::getPararealLevels(500, 3) == 2);
+  REQUIRE(Simulation::getPararealLevels(501, 3) == 0);
+}
+
+TEST_CASE("Parareal iterated to the end is serial time stepping", "[Parareal]") {
+  const Solvers::RusanovMixed<Precision::Double> solver;
+  const Scenarios::DamBreakScenario              damBreak(1000, Size, 14, 3.5, 0);
+  constexpr double                               EndTime = 40.0;
+
+  // Serial time stepping slice by slice
+  std::vector<RealType>  b;
+  Simulation::CellState  serial = initialState(damBreak, Size, b);
+  constexpr unsigned int Slices = 4;
+  for (unsigned int n = 0; n < Slices; n++) {
+    Simulation::propagate<Precision::Double>(serial, b, damBreak.getCellSize(), EndTime / Slices);
+  }
+
+  for (const unsigned int threads : {1u, 0u}) {
+    Simulation::PararealOptions parareal;
+    parareal.slices    = Slices;
+    parareal.threads   = threads;
+    parareal.tolerance = 0.0;
+    std::vector<Simulation::PararealIteration> iterations;
+    const auto result = Simulation::runParareal<Precision::Double>(damBreak, Size, EndTime, parareal, nullptr, solver, Simulation::RunOptions(), &iterations);
+
+    REQUIRE(iterations.size() == Slices);
+    for (unsigned int k = 0; k < Slices; k++) {
+      REQUIRE(iterations[k].fineSlices == Slices - k);
+    }
+    REQUIRE(result.time == EndTime);
+    REQUIRE(maxDifference(result.h, result.hu, serial) == 0.0);
+  }
+}
+
+TEST_CASE("The subcritical flow converges in fewer iterations than slices", "[Parareal]") {
+  const Solvers::RusanovMixed<Precision::Double> solver;
+  const Scenarios::SubcriticalFlowScenario       subcritical(Size);
+  constexpr double                               EndTime = 20.0;
+
+  std::vector<RealType>       b;
+  Simulation::CellState       serial = initialState(subcritical, Size, b);
+  Simulation::PararealOptions parareal;
+  parareal.slices = 8;
+  for (unsigned int n = 0; n < parareal.slices; n++) {
+    Simulation::propagate<Precision::Double>(serial, b, subcritical.getCellSize(), EndTime / parareal.slices);
+  }
+
+  std::vector<Simulation::PararealIteration> iterations;
+  const auto result = Simulation::runParareal<Precision::Double>(subcritical, Size, EndTime, parareal, nullptr, solver, Simulation::RunOptions(), &iterations);
+  REQUIRE(iterations.size() < parareal.slices);
+  REQUIRE(iterations.back().change <= parareal.tolerance);
+  REQUIRE(maxDifference(result.h, result.hu, serial) < 1e-5);
+}
+
+TEST_CASE("Parareal reports fixed-point overflow", "[Parareal]") {
+  Simulation::PararealOptions parareal;
+  parareal.slices = 4;
+
+  // 14 m fit into the 32 m range of fixed16, 40 m do not
+  for (const double hL : {14.0, 40.0}) {
+    const Scenarios::DamBreakScenario damBreak(1000, Size, hL, 3.5, 0);
+    const auto serial = Simulation::run<Precision::FixedPoint16>(damBreak, Size, 50);
+    const auto result = Simulation::runParareal<Precision::FixedPoint16>(damBreak, Size, 10.0, parareal);
+    REQUIRE(serial.overflow == (hL > 32.0));
+    REQUIRE(result.overflow == serial.overflow);
+  }
+}
+
+TEST_CASE("Speedup of parareal against serial time stepping", "[.report][Parareal]") {
+  constexpr unsigned int                         size = 2000;
+  const Solvers::RusanovMixed<Precision::Double> solver;
+  const Scenarios::SubcriticalFlowScenario       subcritical(size);
+  const Scenarios::DamBreakScenario              damBreak(1000, size, 14, 3.5, 0);
+  const Scenarios::Scenario* const               flows[] = {&subcritical, &damBreak};
+
+  std::printf("%u hardware threads; projected: the longest fine slice per iteration plus the coarse sweeps\n", std::thread::hardware_concurrency());
+  std::printf(
+    "%-12s %8s %7s %7s %6s %10s %10s %12s %8s %10s %10s\n",
+    "scenario",
+    "endTime",
+    "slices",
+    "levels",
+    "iters",
+    "serial[s]",
+    "wall[s]",
+    "projected[s]",
+    "speedup",
+    "projected",
+    "maxDiff"
+  );
+  for (const Scenarios::Scenario* scenario : flows) {
+    const char*  name    = scenario == &subcritical ? "subcritical" : "dam break";
+    const double endTime = scenario == &subcritical ? 200.0 : 60.0;
+
+    std::vector<RealType>  b;
+    Simulation::CellState  serial = initialState(*scenario, size, b);
+    const auto             start  = std::chrono::steady_clock::now();
+    Simulation::propagate<Precision::Double>(serial, b, scenario->getCellSize(), endTime);
+    const double serialSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (const unsigned int slices : {4u, 8u, 16u, 32u}) {
+      for (const unsigned int levels : {2u, 3u}) {
+        Simulation::PararealOptions parareal;
+        parareal.slices = slices;
+        parareal.levels = levels;
+        std::vector<Simulation::PararealIteration> iterations;
+        const auto result = Simulation::runParareal<Precision::Double>(*scenario, size, endTime, parareal, nullptr, solver, Simulation::RunOptions(), &iterations);
+
+        double projected = 0.0;
+        for (const Simulation::PararealIteration& iteration : iterations) {
+          projected += iteration.sliceSeconds + iteration.coarseSeconds;
+        }
+        std::printf(
+          "%-12s %8.1f %7u %7u %6zu %10.4f %10.4f %12.4f %8.2f %10.2f %10.2e\n",
+          name,
+          endTime,
+          slices,
+          levels,
+          iterations.size(),
+          serialSeconds,
+          result.seconds,
+          projected,
+          serialSeconds / result.seconds,
+          serialSeconds / projected,
+          maxDifference(result.h, result.hu, serial)
+        );
+      }
+    }
+  }
+}
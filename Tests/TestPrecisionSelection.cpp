@@ -0,0 +1,79 @@
+/**
+ * @file TestPrecisionSelection.cpp
+ * contains tests for the runtime selection of precision policies (Simulation/Simulation.hpp)
+ *
+ * @test Every name accepted by --precision runs a dam break close to the double reference
+ * @test Unknown names are rejected
+ * @test The tolerances of all policies are consistent
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <string>
+
+#include "Scenarios/DamBreakScenario.hpp"
+#include "Simulation/Simulation.hpp"
+#include "Tools/PrecisionPolicy.hpp"
+
+namespace {
+
+  constexpr unsigned int Size  = 500;
+  constexpr unsigned int Steps = 100;
+
+  double mass(const Simulation::Result& result) {
+    double mass = 0.0;
+    for (unsigned int i = 1; i <= Size; i++) {
+      mass += double(result.h[i]);
+    }
+    return mass;
+  }
+
+  template <class Policy>
+  void checkTolerances() {
+    REQUIRE(Policy::H_MIN > 0);
+    REQUIRE_THAT(double(Policy::DRY_TOL), Catch::Matchers::WithinRel(10.0 * double(Policy::H_MIN), 1e-6));
+    REQUIRE(Policy::EPS_LAM > 0);
+    REQUIRE(Policy::EPS_LAM < 1);
+  }
+
+} // namespace
+
+TEST_CASE("Every precision name runs a dam break", "[PrecisionSelection]") {
+  Scenarios::DamBreakScenario scenario(1000, Size, 14, 3.5, 0);
+
+  const auto reference = Simulation::run<Precision::Double>(scenario, Size, Steps);
+  REQUIRE(reference.steps == Steps);
+
+  for (const std::string& name : Simulation::getPrecisionNames()) {
+    INFO(name);
+    Simulation::Result result;
+    const bool         known = Simulation::visitPrecision(name, [&](auto policy) {
+      result = Simulation::run<decltype(policy)>(scenario, Size, Steps);
+    });
+    REQUIRE(known);
+    REQUIRE_FALSE(result.overflow);
+    REQUIRE(result.h.size() == Size + 2);
+    for (unsigned int i = 1; i <= Size; i++) {
+      REQUIRE(std::isfinite(double(result.h[i])));
+      REQUIRE(std::isfinite(double(result.hu[i])));
+    }
+    REQUIRE_THAT(mass(result), Catch::Matchers::WithinRel(mass(reference), 1e-2));
+  }
+}
+
+TEST_CASE("Unknown precision names are rejected", "[PrecisionSelection]") {
+  bool called = false;
+  REQUIRE_FALSE(Simulation::visitPrecision("quad", [&](auto) { called = true; }));
+  REQUIRE_FALSE(Simulation::visitPrecision("", [&](auto) { called = true; }));
+  REQUIRE_FALSE(called);
+}
+
+TEST_CASE("Precision policy tolerances", "[PrecisionSelection]") {
+  checkTolerances<Precision::Double>();
+  checkTolerances<Precision::Float>();
+  checkTolerances<Precision::MixedASafe>();
+  checkTolerances<Precision::MixedBAggressive>();
+  checkTolerances<Precision::MixedC>();
+  checkTolerances<Precision::FixedPoint32>();
+  checkTolerances<Precision::FixedPoint16>();
+}
@@ -0,0 +1,121 @@
+/**
+ * @file TestPrecisionTuner.cpp
+ * contains tests for --precision=auto (Simulation/PrecisionTuner.hpp, Simulation/Shadow.hpp)
+ *
+ * @test The sampled shadow matches a full double run for as many steps as its halo is wide
+ * @test A tolerance no policy meets selects double
+ * @test A loose tolerance selects the policy with the fewest bytes per cell
+ * @test Calibration runs the selected solver and primed policies like the run itself
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+
+#include "Blocks/WavePropagationBlockMixed.hpp"
+#include "Scenarios/DamBreakScenario.hpp"
+#include "Simulation/PrecisionTuner.hpp"
+#include "Simulation/Shadow.hpp"
+#include "Simulation/Simulation.hpp"
+
+namespace {
+
+  constexpr unsigned int Size  = 300;
+  constexpr unsigned int Steps = 200;
+
+} // namespace
+
+TEST_CASE("Sampled shadow follows a full double run", "[PrecisionTuner]") {
+  Scenarios::DamBreakScenario scenario(1000, Size, 14, 3.5, 0);
+
+  std::vector<RealType> h(Size + 2), hu(Size + 2), b(Size + 2);
+  for (unsigned int i = 0; i < Size + 2; i++) {
+    h[i]  = scenario.getHeight(i);
+    hu[i] = scenario.getMomentum(i);
+    b[i]  = scenario.getBathymetry(i);
+  }
+
+  constexpr unsigned int                               Halo = 20;
+  Blocks::WavePropagationBlockMixed<Precision::Double> block(h.data(), hu.data(), b.data(), Size, scenario.getCellSize());
+  Simulation::SampledShadow<>                          shadow(h.data(), hu.data(), b.data(), Size, scenario.getCellSize(), 4, Halo);
+  REQUIRE(shadow.getSampledCells() == 4 * Blocks::ChunkSize);
+
+  for (unsigned int step = 0; step < Halo; step++) {
+    block.applyBoundaryConditions();
+    const double dt = block.computeNumericalFluxes();
+    block.updateUnknowns(dt);
+    shadow.step(dt);
+  }
+  REQUIRE(shadow.compare(block).linf == 0.0);
+}
+
+TEST_CASE("Precision tuner falls back to double", "[PrecisionTuner]") {
+  Scenarios::DamBreakScenario scenario(1000, Size, 14, 3.5, 0);
+
+  const Simulation::Tuning tuning = Simulation::tunePrecision(scenario, Size, Steps, 1e-14);
+  REQUIRE(tuning.precision == "double");
+  for (const Simulation::Calibration& calibration : tuning.candidates) {
+    INFO(calibration.name);
+    REQUIRE_FALSE(calibration.accepted);
+    REQUIRE(calibration.projectedError >= calibration.error);
+  }
+}
+
+TEST_CASE("Precision tuner selects the narrowest accepted policy", "[PrecisionTuner]") {
+  Scenarios::DamBreakScenario scenario(1000, Size, 14, 3.5, 0);
+
+  const Simulation::Tuning tuning = Simulation::tunePrecision(scenario, Size, Steps, 1.0);
+  REQUIRE(tuning.candidates.size() + 1 == Simulation::getPrecisionNames().size());
+
+  double minBytesPerCell = 1e9;
+  for (const Simulation::Calibration& calibration : tuning.candidates) {
+    INFO(calibration.name);
+    REQUIRE(calibration.error > 0.0);
+    REQUIRE(calibration.accepted == (!calibration.overflow && calibration.projectedError <= 1.0));
+    if (calibration.accepted && calibration.bytesPerCell < minBytesPerCell) {
+      minBytesPerCell = calibration.bytesPerCell;
+    }
+  }
+
+  REQUIRE(tuning.precision != "double");
+  for (const Simulation::Calibration& calibration : tuning.candidates) {
+    if (calibration.name == tuning.precision) {
+      REQUIRE(calibration.bytesPerCell == minBytesPerCell);
+    }
+  }
+}
+
+TEST_CASE("Precision tuner calibrates the configuration of the run", "[PrecisionTuner]") {
+  Scenarios::DamBreakScenario scenario(1000, Size, 14, 3.5, 0);
+
+  SECTION("solver") {
+    // A Rusanov shadow would differ from Osher by decimetres in every candidate
+    Simulation::SolverSpec osher;
+    REQUIRE(Simulation::parseSolverSpec("osher", osher));
+    const Simulation::Tuning tuning = Simulation::tunePrecision(scenario, Size, Steps, 1.0, osher);
+    REQUIRE(tuning.candidates.size() + 1 == Simulation::getPrecisionNames().size());
+    for (const Simulation::Calibration& calibration : tuning.candidates) {
+      INFO(calibration.name);
+      if (calibration.name == "float") {
+        REQUIRE(calibration.error < 1e-3);
+      }
+    }
+  }
+
+  SECTION("primed") {
+    const Simulation::Tuning tuning = Simulation::tunePrecision(scenario, Size, Steps, 1.0, Simulation::SolverSpec{"rusanov", {}}, true);
+    REQUIRE(tuning.candidates.size() + 1 == Simulation::getPrecisionNames().size());
+    for (const Simulation::Calibration& calibration : tuning.candidates) {
+      INFO(calibration.name);
+      if (calibration.name == "float") {
+        // In m, not in units of the depth scale
+        REQUIRE(calibration.error > 0.0);
+        REQUIRE(calibration.error < 1e-3);
+      }
+    }
+
+    // Primed policies are only instantiated with rusanov and hybrid
+    Simulation::SolverSpec osher;
+    REQUIRE(Simulation::parseSolverSpec("osher", osher));
+    REQUIRE(Simulation::tunePrecision(scenario, Size, Steps, 1.0, osher, true).candidates.empty());
+  }
+}
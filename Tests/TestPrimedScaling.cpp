@@ -0,0 +1,100 @@
+/**
+ * @file TestPrimedScaling.cpp
+ * contains tests for the nondimensional pipeline (Simulation/Scaling.hpp, Precision::Primed)
+ *
+ * @test h and b survive the mapping to primed variables and back without rounding
+ * @test Primed<Double> reproduces the dimensional double run
+ * @test A deep dam break overflows fp16 storage in meters but not in primed variables
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <vector>
+
+#include "Scenarios/DamBreakScenario.hpp"
+#include "Simulation/Scaling.hpp"
+#include "Simulation/Simulation.hpp"
+
+namespace {
+
+  constexpr unsigned int Size  = 1000;
+  constexpr unsigned int Steps = 300;
+
+  bool isFinite(const Simulation::Result& result) {
+    for (unsigned int i = 1; i <= Size; i++) {
+      if (!std::isfinite(double(result.h[i])) || !std::isfinite(double(result.hu[i]))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  double mass(const std::vector<RealType>& h) {
+    double mass = 0.0;
+    for (unsigned int i = 1; i <= Size; i++) {
+      mass += double(h[i]);
+    }
+    return mass;
+  }
+
+} // namespace
+
+TEST_CASE("Primed variables round trip", "[PrimedScaling]") {
+  std::vector<RealType> h(Size), hu(Size), b(Size);
+  for (unsigned int i = 0; i < Size; i++) {
+    h[i]  = RealType(3000.0 + 1000.0 * std::sin(0.01 * i));
+    hu[i] = RealType(1e4 * std::cos(0.02 * i));
+    b[i]  = -h[i];
+  }
+  const std::vector<RealType> h0 = h, hu0 = hu, b0 = b;
+
+  const Simulation::Scaling scaling(h.data(), Size, 9.81, 250.0);
+  REQUIRE(scaling.depth == 4096.0);
+  REQUIRE_THAT(scaling.velocity, Catch::Matchers::WithinRel(std::sqrt(9.81 * 4096.0), 1e-15));
+  REQUIRE_THAT(scaling.time, Catch::Matchers::WithinRel(250.0 / scaling.velocity, 1e-15));
+
+  scaling.toPrimed(h.data(), hu.data(), b.data(), Size);
+  for (unsigned int i = 0; i < Size; i++) {
+    REQUIRE(std::fabs(double(h[i])) < 1.5);
+    REQUIRE(std::fabs(double(hu[i])) < 1.0);
+  }
+
+  scaling.fromPrimed(h.data(), hu.data(), b.data(), Size);
+  for (unsigned int i = 0; i < Size; i++) {
+    REQUIRE(h[i] == h0[i]);
+    REQUIRE(b[i] == b0[i]);
+    REQUIRE_THAT(double(hu[i]), Catch::Matchers::WithinRel(double(hu0[i]), 1e-12));
+  }
+}
+
+TEST_CASE("Primed double matches the dimensional run", "[PrimedScaling]") {
+  Scenarios::DamBreakScenario scenario(1000, Size, 14, 3.5, 0);
+
+  const auto reference = Simulation::run<Precision::Double>(scenario, Size, Steps);
+  const auto primed    = Simulation::run<Precision::Primed<Precision::Double>>(scenario, Size, Steps);
+
+  REQUIRE(primed.scaling.depth == 16.0);
+  REQUIRE_THAT(primed.time, Catch::Matchers::WithinRel(reference.time, 1e-12));
+  for (unsigned int i = 1; i <= Size; i++) {
+    REQUIRE_THAT(double(primed.h[i]), Catch::Matchers::WithinAbs(double(reference.h[i]), 1e-10));
+    REQUIRE_THAT(double(primed.hu[i]), Catch::Matchers::WithinAbs(double(reference.hu[i]), 1e-9));
+  }
+}
+
+TEST_CASE("Primed variables keep fp16 storage in range", "[PrimedScaling]") {
+  // 5000 m against 4000 m: hu reaches ~1e5 m^2/s, beyond the fp16 maximum of 65504
+  Scenarios::DamBreakScenario scenario(400000, Size, 5000, 4000, 0);
+
+  const auto dimensional = Simulation::run<Precision::MixedASafe>(scenario, Size, Steps);
+  const auto primed      = Simulation::run<Precision::Primed<Precision::MixedASafe>>(scenario, Size, Steps);
+
+  REQUIRE_FALSE(isFinite(dimensional));
+  REQUIRE(isFinite(primed));
+
+  std::vector<RealType> h0(Size + 2);
+  for (unsigned int i = 0; i < Size + 2; i++) {
+    h0[i] = scenario.getHeight(i);
+  }
+  // fp16 keeps 11 bits of h' ~ 1, without compensation the mass drifts by a few 1e-3
+  REQUIRE_THAT(mass(primed.h), Catch::Matchers::WithinRel(mass(h0), 1e-2));
+}
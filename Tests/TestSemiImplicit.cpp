@@ -0,0 +1,227 @@
+/**
+ * @file TestSemiImplicit.cpp
+ * contains tests for the semi-implicit block (Blocks/SemiImplicitBlock.hpp)
+ *
+ * @test A lake at rest over a bump stays at rest, also with large time steps
+ * @test A dam break starting at rest takes finite steps of at most ten explicit steps
+ * @test Mass is conserved between reflecting walls at ten times the explicit time step
+ * @test The subcritical flow reaches the steady state of the explicit run with larger time steps
+ *
+ * The hidden test case "[.report]" prints steps and run time to the steady state of the subcritical flow:
+ *   ./TestSemiImplicit "[.report]"
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "Blocks/SemiImplicitBlock.hpp"
+#include "Blocks/WavePropagationBlockMixed.hpp"
+#include "Scenarios/DamBreakScenario.hpp"
+#include "Scenarios/SubcriticalFlowScenario.hpp"
+#include "Simulation/Simulation.hpp"
+#include "Solver/AugumentedMixed.hpp"
+
+namespace {
+
+  constexpr unsigned int Size = 500;
+
+  // The bump of the subcritical flow under still water
+  class LakeScenario: public Scenarios::Scenario {
+    Scenarios::SubcriticalFlowScenario bump_;
+
+  public:
+    explicit LakeScenario(unsigned int size):
+      bump_(size) {}
+
+    RealType getCellSize() const override { return bump_.getCellSize(); }
+    RealType getHeight(unsigned int pos) const override { return -bump_.getBathymetry(pos); }
+    RealType getMomentum(unsigned int) const override { return 0.0; }
+    RealType getBathymetry(unsigned int pos) const override { return bump_.getBathymetry(pos); }
+  };
+
+  struct Cells {
+    std::vector<double> h, hu, b;
+
+    Cells(const Scenarios::Scenario& scenario, unsigned int size):
+      h(size + 2),
+      hu(size + 2),
+      b(size + 2) {
+      for (unsigned int i = 0; i < size + 2; i++) {
+        h[i]  = scenario.getHeight(i);
+        hu[i] = scenario.getMomentum(i);
+        b[i]  = scenario.getBathymetry(i);
+      }
+    }
+  };
+
+  /**
+   * Steps the block until the momentum changes by less than tolerance per
+   * second, checked every 100 steps
+   *
+   * @return Steps taken, at most maxSteps
+   */
+  template <class Block>
+  unsigned int runToSteadyState(Block& block, unsigned int size, double tolerance, unsigned int maxSteps, double& time) {
+    std::vector<double> h(size + 2), hu(size + 2), huBefore(size + 2), b(size + 2);
+    time = 0.0;
+    for (unsigned int step = 1; step <= maxSteps; step++) {
+      block.applyBoundaryConditions();
+      const double dt = block.computeNumericalFluxes();
+      if (step % 100 == 0) {
+        block.getState(h.data(), huBefore.data(), b.data());
+      }
+      block.updateUnknowns(dt);
+      time += dt;
+
+      if (step % 100 == 0) {
+        block.getState(h.data(), hu.data(), b.data());
+        double change = 0.0;
+        for (unsigned int i = 1; i <= size; i++) {
+          change = std::max(change, std::abs(hu[i] - huBefore[i]) / dt);
+        }
+        if (change < tolerance) {
+          return step;
+        }
+      }
+    }
+    return maxSteps;
+  }
+
+} // namespace
+
+TEST_CASE("A lake at rest stays at rest", "[SemiImplicit]") {
+  const LakeScenario lake(Size);
+  const Cells        cells(lake, Size);
+
+  Blocks::SemiImplicitBlock<Precision::Double> block(cells.h.data(), cells.hu.data(), cells.b.data(), Size, lake.getCellSize());
+  for (const double dt : {0.01, 1.0, 100.0}) {
+    block.applyBoundaryConditions();
+    block.computeNumericalFluxes();
+    block.updateUnknowns(dt);
+  }
+
+  std::vector<double> h(Size + 2), hu(Size + 2), b(Size + 2);
+  block.getState(h.data(), hu.data(), b.data());
+  for (unsigned int i = 1; i <= Size; i++) {
+    REQUIRE_THAT(h[i] + b[i], Catch::Matchers::WithinAbs(0.0, 1e-12));
+    REQUIRE_THAT(hu[i], Catch::Matchers::WithinAbs(0.0, 1e-12));
+  }
+}
+
+TEST_CASE("A dam break at rest takes finite steps", "[SemiImplicit]") {
+  // No velocity at t = 0: the first step is bounded by the gravity waves alone
+  const Scenarios::DamBreakScenario damBreak(1000.0, Size, 14.0, 3.5, 0.0);
+  const Cells                       cells(damBreak, Size);
+
+  Blocks::SemiImplicitBlock<Precision::Double> block(cells.h.data(), cells.hu.data(), cells.b.data(), Size, damBreak.getCellSize());
+  block.applyBoundaryConditions();
+  const double dt = block.computeNumericalFluxes();
+  REQUIRE(std::isfinite(dt));
+  const double explicitStep = Precision::Double::CFL * damBreak.getCellSize() / std::sqrt(9.81 * 14.0);
+  REQUIRE_THAT(dt, Catch::Matchers::WithinRel(Blocks::SemiImplicitBlock<Precision::Double>::MAX_GRAVITY_COURANT * explicitStep, 1e-12));
+
+  Simulation::RunOptions semiImplicit;
+  semiImplicit.semiImplicit = true;
+  const auto result         = Simulation::run<Precision::Double>(damBreak, Size, 200, nullptr, Solvers::RusanovMixed<Precision::Double>(), semiImplicit);
+  REQUIRE(std::isfinite(result.time));
+  REQUIRE(result.time > 0.0);
+  for (unsigned int i = 1; i <= Size; i++) {
+    REQUIRE(std::isfinite(double(result.h[i])));
+    REQUIRE(std::isfinite(double(result.hu[i])));
+    REQUIRE(result.h[i] > 0.0);
+  }
+}
+
+TEST_CASE("Mass is conserved between reflecting walls", "[SemiImplicit]") {
+  // A hump of 10 cm over the bump, sloshing between two walls
+  const LakeScenario lake(Size);
+  Cells              cells(lake, Size);
+  for (unsigned int i = 0; i < Size + 2; i++) {
+    cells.h[i] += 0.1 * std::exp(-std::pow((double(i) - 0.25 * Size) / (0.05 * Size), 2));
+  }
+  double mass = 0.0;
+  for (unsigned int i = 1; i <= Size; i++) {
+    mass += cells.h[i];
+  }
+
+  Blocks::SemiImplicitBlock<Precision::Double> block(cells.h.data(), cells.hu.data(), cells.b.data(), Size, lake.getCellSize());
+  block.setLeftBoundaryCondition(Blocks::SemiImplicitBlock<Precision::Double>::ReflectingBoundary);
+  block.setRightBoundaryCondition(Blocks::SemiImplicitBlock<Precision::Double>::ReflectingBoundary);
+
+  // Ten times the explicit step for gravity waves on 2 m depth
+  const double dt = 10.0 * lake.getCellSize() / std::sqrt(9.81 * 2.1);
+  for (unsigned int step = 0; step < 2000; step++) {
+    block.applyBoundaryConditions();
+    block.computeNumericalFluxes();
+    block.updateUnknowns(dt);
+  }
+
+  std::vector<double> h(Size + 2), hu(Size + 2), b(Size + 2);
+  block.getState(h.data(), hu.data(), b.data());
+  double massAfter = 0.0, amplitude = 0.0;
+  for (unsigned int i = 1; i <= Size; i++) {
+    massAfter += h[i];
+    amplitude = std::max(amplitude, std::abs(h[i] + b[i]));
+  }
+  REQUIRE_THAT(massAfter, Catch::Matchers::WithinRel(mass, 1e-13));
+  // Stable and damped: the implicit gravity terms do not amplify the hump
+  REQUIRE(amplitude < 0.1);
+}
+
+TEST_CASE("The subcritical flow reaches the explicit steady state", "[SemiImplicit]") {
+  const Scenarios::SubcriticalFlowScenario subcritical(Size);
+  const Solvers::AugumentedMixed<Precision::Double> solver;
+
+  Simulation::RunOptions semiImplicit;
+  semiImplicit.semiImplicit = true;
+  const auto explicitRun     = Simulation::run<Precision::Double>(subcritical, Size, 4000, nullptr, solver);
+  const auto semiImplicitRun = Simulation::run<Precision::Double>(subcritical, Size, 4000, nullptr, solver, semiImplicit);
+
+  // Froude number 0.5: the steps grow by (|u| + c) / |u|, about 2.5
+  REQUIRE(semiImplicitRun.time > 2.0 * explicitRun.time);
+  REQUIRE(semiImplicitRun.wetChunks == 0);
+
+  // Both are steady; the first-order discretizations differ by about 3 mm on the bump
+  for (unsigned int i = 1; i <= Size; i++) {
+    REQUIRE_THAT(double(semiImplicitRun.h[i]), Catch::Matchers::WithinAbs(double(explicitRun.h[i]), 5e-3));
+    REQUIRE_THAT(double(semiImplicitRun.hu[i]), Catch::Matchers::WithinAbs(4.42, 1e-3));
+  }
+}
+
+TEST_CASE("Time to the steady state of the subcritical flow", "[.report][SemiImplicit]") {
+  constexpr double Tolerance = 1e-6;
+
+  std::printf("%-8s %-14s %8s %10s %10s %10s\n", "cells", "integrator", "steps", "time[s]", "dt[s]", "wall[s]");
+  for (const unsigned int size : {500u, 2000u, 8000u}) {
+    const Scenarios::SubcriticalFlowScenario subcritical(size);
+    const Cells                              cells(subcritical, size);
+
+    const auto report = [&](const char* name, auto& block) {
+      double     time  = 0.0;
+      const auto start = std::chrono::steady_clock::now();
+      const auto steps = runToSteadyState(block, size, Tolerance, 1000000, time);
+      std::printf(
+        "%-8u %-14s %8u %10.3f %10.2e %10.4f\n",
+        size,
+        name,
+        steps,
+        time,
+        time / steps,
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()
+      );
+    };
+
+    Blocks::WavePropagationBlockMixed<Precision::Double> rusanov(cells.h.data(), cells.hu.data(), cells.b.data(), size, subcritical.getCellSize());
+    report("rusanov", rusanov);
+    Blocks::WavePropagationBlockMixed<Precision::Double, Solvers::AugumentedMixed<Precision::Double>> augmented(
+      cells.h.data(), cells.hu.data(), cells.b.data(), size, subcritical.getCellSize()
+    );
+    report("augmented", augmented);
+    Blocks::SemiImplicitBlock<Precision::Double> semiImplicit(cells.h.data(), cells.hu.data(), cells.b.data(), size, subcritical.getCellSize());
+    report("semi-implicit", semiImplicit);
+  }
+}
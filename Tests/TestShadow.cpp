@@ -0,0 +1,106 @@
+/**
+ * @file TestShadow.cpp
+ * contains tests for the lockstep double shadow (Simulation/Shadow.hpp, Simulation::runShadowed)
+ *
+ * @test A double run has no divergence from its shadow, on the whole domain and on sampled chunks
+ * @test The shadow runs the solver of the followed run with its parameters
+ * @test A float run diverges; the time series has one line per step
+ * @test The first divergence is reported against the threshold
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+#include "Scenarios/DamBreakScenario.hpp"
+#include "Simulation/Simulation.hpp"
+#include "Simulation/SolverRegistry.hpp"
+
+namespace {
+
+  constexpr unsigned int Size  = 400;
+  constexpr unsigned int Steps = 300;
+
+  unsigned int countLines(const std::string& text, bool comments) {
+    std::istringstream stream(text);
+    std::string        line;
+    unsigned int       lines = 0;
+    while (std::getline(stream, line)) {
+      lines += (line[0] == '#') == comments;
+    }
+    return lines;
+  }
+
+} // namespace
+
+TEST_CASE("Double does not diverge from its shadow", "[Shadow]") {
+  Scenarios::DamBreakScenario scenario(1000, Size, 14, 3.5, 0);
+
+  SECTION("whole domain") {
+    std::ostringstream       series;
+    const Simulation::Result result = Simulation::runShadowed<Precision::Double>(scenario, Size, Steps, 0, 0.0, series);
+    REQUIRE(result.divergence.linf == 0.0);
+    REQUIRE(result.divergence.massError == 0.0);
+    REQUIRE(result.firstDivergenceStep == 0);
+  }
+
+  SECTION("sampled chunks with prescribed ghost cells") {
+    // Runs far longer than the halo is wide
+    std::ostringstream       series;
+    const Simulation::Result result = Simulation::runShadowed<Precision::Double>(scenario, Size, Steps, 2, 0.0, series);
+    REQUIRE(result.divergence.linf == 0.0);
+    REQUIRE(result.firstDivergenceStep == 0);
+  }
+}
+
+TEST_CASE("Shadow runs the solver of the followed run", "[Shadow]") {
+  Scenarios::DamBreakScenario scenario(1000, Size, 14, 3.5, 0);
+
+  for (const std::string name : {"osher", "hllc:hmin=1e-3", "roe", "fwave", "augmented:drytol=1e-3", "hybrid:jump=1e-2"}) {
+    INFO(name);
+    Simulation::SolverSpec spec;
+    REQUIRE(Simulation::parseSolverSpec(name, spec));
+    REQUIRE(Simulation::visitSolver<Precision::Double>(spec, [&](const auto& solver) {
+      using Solver = std::remove_cvref_t<decltype(solver)>;
+      std::ostringstream       series;
+      const Simulation::Result result = Simulation::runShadowed<Precision::Double, Solver>(
+        scenario, Size, Steps, 0, 0.0, series, nullptr, solver
+      );
+      REQUIRE(result.divergence.linf == 0.0);
+      REQUIRE(result.firstDivergenceStep == 0);
+    }));
+  }
+}
+
+TEST_CASE("Float diverges from its shadow", "[Shadow]") {
+  Scenarios::DamBreakScenario scenario(1000, Size, 14, 3.5, 0);
+
+  std::ostringstream       series;
+  const Simulation::Result result = Simulation::runShadowed<Precision::Float>(scenario, Size, Steps, 0, 1e3, series);
+  REQUIRE(countLines(series.str(), false) == Steps);
+  REQUIRE(countLines(series.str(), true) == 2);
+
+  REQUIRE(result.divergence.linf > 0.0);
+  REQUIRE(result.divergence.linf < 1e-2);
+  REQUIRE(result.divergence.l1 <= result.divergence.linf);
+  REQUIRE(result.divergence.linfCell >= 1);
+  REQUIRE(result.divergence.linfCell <= Size);
+  REQUIRE(std::abs(result.divergence.massError) < 1e-5);
+  REQUIRE(result.firstDivergenceStep == 0);
+
+  // The state itself is unaffected by the shadow
+  const Simulation::Result plain = Simulation::run<Precision::Float>(scenario, Size, Steps);
+  REQUIRE(plain.h == result.h);
+}
+
+TEST_CASE("Shadow reports the first divergence", "[Shadow]") {
+  Scenarios::DamBreakScenario scenario(1000, Size, 14, 3.5, 0);
+
+  std::ostringstream       series;
+  const Simulation::Result result = Simulation::runShadowed<Precision::MixedBAggressive>(scenario, Size, Steps, 4, 1e-6, series);
+  REQUIRE(result.firstDivergenceStep >= 1);
+  REQUIRE(result.firstDivergenceStep <= Steps);
+  // The dam is in the middle, the error starts there
+  REQUIRE(result.firstDivergenceCell > Size / 4);
+  REQUIRE(result.firstDivergenceCell < 3 * Size / 4);
+}
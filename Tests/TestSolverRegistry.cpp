@@ -0,0 +1,116 @@
+/**
+ * @file TestSolverRegistry.cpp
+ * contains tests for the runtime selection of solvers (Simulation/SolverRegistry.hpp)
+ *
+ * @test Every name accepted by --solver runs a dam break close to the Rusanov reference
+ * @test Parameters reach the solver of the block, parameters a solver does not have are rejected
+ * @test Malformed parameters and unknown names are rejected, primed policies only offer rusanov and hybrid
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <string>
+#include <type_traits>
+
+#include "Scenarios/DamBreakScenario.hpp"
+#include "Simulation/Simulation.hpp"
+#include "Simulation/SolverRegistry.hpp"
+
+namespace {
+
+  constexpr unsigned int Size  = 500;
+  constexpr unsigned int Steps = 100;
+
+  double mass(const Simulation::Result& result) {
+    double mass = 0.0;
+    for (unsigned int i = 1; i <= Size; i++) {
+      mass += double(result.h[i]);
+    }
+    return mass;
+  }
+
+  Simulation::SolverSpec parse(const std::string& text) {
+    Simulation::SolverSpec spec;
+    REQUIRE(Simulation::parseSolverSpec(text, spec));
+    return spec;
+  }
+
+} // namespace
+
+TEST_CASE("Every solver name runs a dam break", "[SolverRegistry]") {
+  Scenarios::DamBreakScenario scenario(1000, Size, 14, 3.5, 0);
+
+  const auto reference = Simulation::run<Precision::Double>(scenario, Size, Steps);
+
+  for (const std::string& name : Simulation::getSolverNames()) {
+    INFO(name);
+    Simulation::Result result;
+    const bool         known = Simulation::visitSolver<Precision::Double>(parse(name), [&](const auto& solver) {
+      result = Simulation::run<Precision::Double, std::remove_cvref_t<decltype(solver)>>(scenario, Size, Steps, nullptr, solver);
+    });
+    REQUIRE(known);
+    REQUIRE(result.steps == Steps);
+    for (unsigned int i = 1; i <= Size; i++) {
+      REQUIRE(std::isfinite(double(result.h[i])));
+      REQUIRE(std::isfinite(double(result.hu[i])));
+    }
+    REQUIRE_THAT(mass(result), Catch::Matchers::WithinRel(mass(reference), 1e-2));
+  }
+}
+
+TEST_CASE("Solver parameters reach the block", "[SolverRegistry]") {
+  double hMin = 0.0;
+  REQUIRE(Simulation::visitSolver<Precision::Double>(parse("rusanov:hmin=1e-3"), [&](const auto& solver) {
+    if constexpr (requires { solver.getHMin(); }) {
+      hMin = solver.getHMin();
+    }
+  }));
+  REQUIRE(hMin == 1e-3);
+
+  double jump = 0.0, sonic = 0.0;
+  REQUIRE(Simulation::visitSolver<Precision::Float>(parse("hybrid:jump=0.5:sonic=0.25"), [&](const auto& solver) {
+    if constexpr (requires { solver.getJumpTolerance(); }) {
+      jump  = solver.getJumpTolerance();
+      sonic = solver.getSonicBand();
+    }
+  }));
+  REQUIRE(jump == 0.5);
+  REQUIRE(sonic == 0.25);
+
+  const auto ignore = [](const auto&) {};
+  REQUIRE(Simulation::visitSolver<Precision::Double>(parse("augmented:drytol=1e-4"), ignore));
+  REQUIRE_FALSE(Simulation::visitSolver<Precision::Double>(parse("osher:hmin=1e-4"), ignore));
+  REQUIRE_FALSE(Simulation::visitSolver<Precision::Double>(parse("rusanov:drytol=1e-4"), ignore));
+  REQUIRE_FALSE(Simulation::visitSolver<Precision::Double>(parse("hllc:cfl=0.5"), ignore));
+
+  // A dry threshold above every depth leaves the dam untouched
+  Scenarios::DamBreakScenario scenario(1000, Size, 14, 3.5, 0);
+  Solvers::RusanovMixed<Precision::Double> dry;
+  dry.setHMin(100.0);
+  const auto result = Simulation::run<Precision::Double>(scenario, Size, Steps, nullptr, dry);
+  for (unsigned int i = 1; i <= Size; i++) {
+    REQUIRE(double(result.h[i]) == double(scenario.getHeight(i)));
+  }
+  REQUIRE(result.wetChunks == 0);
+}
+
+TEST_CASE("Unknown solvers and malformed parameters are rejected", "[SolverRegistry]") {
+  Simulation::SolverSpec spec;
+  REQUIRE_FALSE(Simulation::parseSolverSpec("rusanov:hmin", spec));
+  REQUIRE_FALSE(Simulation::parseSolverSpec("rusanov:hmin=abc", spec));
+  REQUIRE_FALSE(Simulation::parseSolverSpec("rusanov:hmin=1e-3x", spec));
+  REQUIRE_FALSE(Simulation::parseSolverSpec("rusanov:=1", spec));
+
+  bool       called = false;
+  const auto visitor = [&](const auto&) { called = true; };
+  REQUIRE_FALSE(Simulation::visitSolver<Precision::Double>(parse("godunov"), visitor));
+  REQUIRE_FALSE(Simulation::visitSolver<Precision::Double>(parse(""), visitor));
+  REQUIRE_FALSE(called);
+
+  // Primed policies are only instantiated with rusanov and hybrid
+  for (const std::string& name : Simulation::getSolverNames()) {
+    INFO(name);
+    const bool known = Simulation::visitSolver<Precision::Primed<Precision::Float>>(parse(name), [](const auto&) {});
+    REQUIRE(known == (name == "rusanov" || name == "hybrid"));
+  }
+}
@@ -0,0 +1,180 @@
+/**
+ * @file TestSteadyState.cpp
+ * contains tests for the residual monitoring and early termination of the time loop (RunOptions::steadyTolerance)
+ *
+ * @test The residual of the blocks is the rate of change of their step
+ * @test The sub- and supercritical flows stop once steady, close to their steady state
+ * @test Runs that do not settle run to the end
+ * @test The convergence history has one line per step
+ *
+ * The hidden test case "[.report]" prints steps and run time to the steady state:
+ *   ./TestSteadyState "[.report]"
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Results.hpp"
+#include "Blocks/SemiImplicitBlock.hpp"
+#include "Blocks/WavePropagationBlockMixed.hpp"
+#include "Scenarios/DamBreakScenario.hpp"
+#include "Scenarios/SubcriticalFlowScenario.hpp"
+#include "Scenarios/SupercriticalFlowScenario.hpp"
+#include "Simulation/Simulation.hpp"
+
+namespace {
+
+  constexpr unsigned int Size     = 500;
+  constexpr unsigned int MaxSteps = 100000;
+
+  Simulation::RunOptions steadyBelow(double tolerance) {
+    Simulation::RunOptions options;
+    options.steadyTolerance = tolerance;
+    return options;
+  }
+
+  /**
+   * Steps the block, then compares its residual to max |dh/dt|, |d(hu)/dt|
+   * of one more step
+   */
+  template <class Block>
+  void checkResidual(Block& block) {
+    block.setResidualMonitoring(true);
+    for (unsigned int step = 0; step < 20; step++) {
+      block.applyBoundaryConditions();
+      block.updateUnknowns(block.computeNumericalFluxes());
+    }
+
+    std::vector<double> h(Size + 2), hu(Size + 2), hBefore(Size + 2), huBefore(Size + 2), b(Size + 2);
+    block.getState(hBefore.data(), huBefore.data(), b.data());
+    block.applyBoundaryConditions();
+    const double dt = block.computeNumericalFluxes();
+    block.updateUnknowns(dt);
+    block.getState(h.data(), hu.data(), b.data());
+
+    double l1H = 0.0, linfH = 0.0, linfHu = 0.0;
+    for (unsigned int i = 1; i <= Size; i++) {
+      l1H += std::abs(h[i] - hBefore[i]) / dt / Size;
+      linfH  = std::max(linfH, std::abs(h[i] - hBefore[i]) / dt);
+      linfHu = std::max(linfHu, std::abs(hu[i] - huBefore[i]) / dt);
+    }
+    REQUIRE(linfH > 0.0);
+    REQUIRE_THAT(block.getResidual().l1H, Catch::Matchers::WithinRel(l1H, 1e-6));
+    REQUIRE_THAT(block.getResidual().linfH, Catch::Matchers::WithinRel(linfH, 1e-6));
+    REQUIRE_THAT(block.getResidual().linfHu, Catch::Matchers::WithinRel(linfHu, 1e-6));
+  }
+
+} // namespace
+
+TEST_CASE("The residual is the rate of change of a step", "[SteadyState]") {
+  const Scenarios::SubcriticalFlowScenario subcritical(Size);
+  std::vector<RealType>                    h(Size + 2), hu(Size + 2), b(Size + 2);
+  for (unsigned int i = 0; i < Size + 2; i++) {
+    h[i]  = subcritical.getHeight(i);
+    hu[i] = subcritical.getMomentum(i);
+    b[i]  = subcritical.getBathymetry(i);
+  }
+
+  Blocks::WavePropagationBlockMixed<Precision::Double> explicitBlock(h.data(), hu.data(), b.data(), Size, subcritical.getCellSize());
+  checkResidual(explicitBlock);
+  Blocks::SemiImplicitBlock<Precision::Double> semiImplicitBlock(h.data(), hu.data(), b.data(), Size, subcritical.getCellSize());
+  checkResidual(semiImplicitBlock);
+}
+
+TEST_CASE("Steady flows stop early", "[SteadyState]") {
+  const Solvers::RusanovMixed<Precision::Double> solver;
+  const Scenarios::SubcriticalFlowScenario   subcritical(Size);
+  const Scenarios::SupercriticalFlowScenario supercritical(Size);
+
+  const Scenarios::Scenario* const flows[] = {&subcritical, &supercritical};
+  for (const Scenarios::Scenario* scenario : flows) {
+    const auto steady = Simulation::run<Precision::Double>(*scenario, Size, MaxSteps, nullptr, solver, steadyBelow(1e-6));
+    REQUIRE(steady.steadyStep > 0);
+    REQUIRE(steady.steps == steady.steadyStep);
+    REQUIRE(steady.steps < MaxSteps / 20);
+    REQUIRE(std::max(steady.residual.linfH, steady.residual.linfHu) < 1e-6);
+
+    // Another 1000 steps barely move the state
+    const auto longer = Simulation::run<Precision::Double>(*scenario, Size, steady.steps + 1000);
+    REQUIRE(Tests::maxDifference(steady, longer) < 1e-5);
+  }
+}
+
+TEST_CASE("Runs that do not settle run to the end", "[SteadyState]") {
+  const Solvers::RusanovMixed<Precision::Double> solver;
+  // The dam break keeps moving for the whole run
+  const Scenarios::DamBreakScenario damBreak(1000, Size, 14, 3.5, 0);
+  const auto dam = Simulation::run<Precision::Double>(damBreak, Size, 500, nullptr, solver, steadyBelow(1e-6));
+  REQUIRE(dam.steadyStep == 0);
+  REQUIRE(dam.steps == 500);
+  REQUIRE(dam.residual.linfH > 1e-6);
+
+  // The subcritical flow is steady, but not for a window longer than the run
+  const Scenarios::SubcriticalFlowScenario subcritical(Size);
+  Simulation::RunOptions                   options = steadyBelow(1e-6);
+  options.steadyWindow                             = MaxSteps;
+  const auto window = Simulation::run<Precision::Double>(subcritical, Size, 5000, nullptr, solver, options);
+  REQUIRE(window.steadyStep == 0);
+  REQUIRE(window.steps == 5000);
+}
+
+TEST_CASE("The convergence history has one line per step", "[SteadyState]") {
+  const Solvers::RusanovMixed<Precision::Double> solver;
+  const Scenarios::SubcriticalFlowScenario subcritical(Size);
+  std::ostringstream                       history;
+  Simulation::RunOptions                   options = steadyBelow(1e-6);
+  options.residualHistory                          = &history;
+  const auto result = Simulation::run<Precision::Double>(subcritical, Size, MaxSteps, nullptr, solver, options);
+
+  std::istringstream lines(history.str());
+  std::string        line;
+  REQUIRE(std::getline(lines, line));
+  REQUIRE(line == "# step time l1_h linf_h l1_hu linf_hu");
+
+  unsigned int steps = 0, step = 0;
+  double       time = 0.0, l1H = 0.0, linfH = 0.0, l1Hu = 0.0, linfHu = 0.0, firstLinfHu = 0.0;
+  while (std::getline(lines, line)) {
+    std::istringstream(line) >> step >> time >> l1H >> linfH >> l1Hu >> linfHu;
+    steps++;
+    REQUIRE(step == steps);
+    REQUIRE(l1H <= linfH);
+    REQUIRE(l1Hu <= linfHu);
+    if (steps == 1) {
+      firstLinfHu = linfHu;
+    }
+  }
+  REQUIRE(steps == result.steps);
+  REQUIRE_THAT(linfHu, Catch::Matchers::WithinRel(result.residual.linfHu, 1e-5));
+  REQUIRE(linfHu < 1e-3 * firstLinfHu);
+}
+
+TEST_CASE("Steps and run time to the steady state", "[.report][SteadyState]") {
+  const Solvers::RusanovMixed<Precision::Double> solver;
+  std::printf("%-14s %8s %10s %8s %10s %10s %12s\n", "scenario", "cells", "tolerance", "steps", "time[s]", "wall[s]", "linfHu");
+  for (const unsigned int size : {500u, 2000u, 8000u}) {
+    const Scenarios::SubcriticalFlowScenario   subcritical(size);
+    const Scenarios::SupercriticalFlowScenario supercritical(size);
+    const Scenarios::Scenario* const           flows[] = {&subcritical, &supercritical};
+    for (const double tolerance : {1e-4, 1e-6, 1e-8}) {
+      for (const Scenarios::Scenario* scenario : flows) {
+        const char* name   = scenario == &subcritical ? "subcritical" : "supercritical";
+        const auto  result = Simulation::run<Precision::Double>(*scenario, size, 1000000, nullptr, solver, steadyBelow(tolerance));
+        std::printf(
+          "%-14s %8u %10.0e %8u %10.3f %10.4f %12.3e\n",
+          name,
+          size,
+          tolerance,
+          result.steps,
+          result.time,
+          result.seconds,
+          result.residual.linfHu
+        );
+      }
+    }
+  }
+}